@@ -0,0 +1,338 @@
+// aligned_array_view - Range view of contiguous sequence with known alignment
+//
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ALIGNED_ARRAY_VIEW_HPP
+#define INCLUDED_ALIGNED_ARRAY_VIEW_HPP
+
+#include <cstddef> // size_t
+#include <cstdint> // uintptr_t
+#include <iterator> // reverse_iterator
+#include <stdexcept> // invalid_argument, out_of_range
+#include <type_traits> // conditional, enable_if, is_convertible, remove_cv
+
+#include "array_view.hpp"
+
+namespace array_view_detail
+{
+    // Tests if the pointer is aligned to given boundary.
+    inline bool is_aligned(
+        void const volatile* ptr, std::size_t align) noexcept
+    {
+        return reinterpret_cast<std::uintptr_t>(ptr) % align == 0;
+    }
+
+    // Tells the compiler that the pointer is aligned to Align bytes.
+    template<std::size_t Align, typename T>
+    inline T* assume_aligned(T* ptr) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<T*>(__builtin_assume_aligned(ptr, Align));
+#else
+        return ptr;
+#endif
+    }
+
+    // Tests if the value is a power of two.
+    constexpr bool is_power_of_two(std::size_t value) noexcept
+    {
+        return value != 0 && (value & (value - 1)) == 0;
+    }
+} // namespace array_view_detail
+
+namespace ext
+{
+    /// Lightweight range view of contiguous sequence whose first element is
+    /// aligned to Align bytes.
+    ///
+    /// The alignment is validated once on construction via
+    /// `make_aligned_array_view` and then conveyed to the compiler through
+    /// `data()` and `begin()`, so that loops over the view need no peeling
+    /// prologue and can use aligned vector loads.
+    template<typename T, std::size_t Align>
+    class aligned_array_view
+    {
+        static_assert(array_view_detail::is_power_of_two(Align),
+            "alignment must be a power of two");
+        static_assert(Align >= alignof(T),
+            "alignment must not be weaker than that of the element type");
+
+      public:
+        /// The non-qualified type of the elements.
+        using value_type = typename std::remove_cv<T>::type;
+
+        /// The type of a pointer to an element.
+        using pointer = T*;
+
+        /// The type of a reference to an element.
+        using reference = T&;
+
+        /// The type of size and index values.
+        using size_type = std::size_t;
+
+        /// The type of iterators. Guaranteed to be a random access iterator.
+        using iterator = T*;
+
+        /// The type of reverse iterators. Guaranteed to be a random access
+        /// iterator.
+        using reverse_iterator = std::reverse_iterator<iterator>;
+
+        /// The type of read-only aligned_array_view with the same value_type.
+        using const_array_view = aligned_array_view<T const, Align>;
+
+        /// The alignment of the first element in bytes.
+        static constexpr size_type alignment = Align;
+
+        /// The default constructor creates an empty view.
+        aligned_array_view() noexcept = default;
+
+        /// This constructor creates a view of region [data, data + size). The
+        /// behavior is undefined if data is not aligned to Align bytes.
+        aligned_array_view(pointer data, size_type size) noexcept
+            : data_{data}
+            , size_{size}
+        {
+        }
+
+        /// Tests if the view is empty.
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        /// Returns the number of elements.
+        size_type size() const noexcept
+        {
+            return size_;
+        }
+
+        /// Returns a pointer to the first element, marked as aligned.
+        pointer data() const noexcept
+        {
+            return array_view_detail::assume_aligned<Align>(data_);
+        }
+
+        /// Returns a reference to the first element. The behavior is
+        /// undefined if the view is empty.
+        reference front() const
+        {
+            return operator[](0);
+        }
+
+        /// Returns a reference to the last element. The behavior is undefined
+        /// if the view is empty.
+        reference back() const
+        {
+            return operator[](size() - 1);
+        }
+
+        /// Returns a reference to the idx-th element. The behavior is
+        /// undefined if the index is out of bounds.
+        reference operator[](size_type idx) const
+        {
+            return data()[idx];
+        }
+
+        /// Returns a reference to the idx-th element.
+        ///
+        /// @exception std::out_of_range if the index is out of bounds.
+        reference at(size_type idx) const
+        {
+            if (idx >= size()) {
+                throw std::out_of_range(
+                    "aligned_array_view access out-of-bounds");
+            }
+            return operator[](idx);
+        }
+
+        /// Returns an iterator to the beginning.
+        iterator begin() const noexcept
+        {
+            return data();
+        }
+
+        /// Returns an iterator to the end.
+        iterator end() const noexcept
+        {
+            return data() + size();
+        }
+
+        /// Returns a reverse iterator to the reverse beginning.
+        reverse_iterator rbegin() const noexcept
+        {
+            return reverse_iterator{end()};
+        }
+
+        /// Returns a reverse iterator to the reverse end.
+        reverse_iterator rend() const noexcept
+        {
+            return reverse_iterator{begin()};
+        }
+
+        /// Returns a read-only view of the same array.
+        const_array_view as_const() const noexcept
+        {
+            return {data(), size()};
+        }
+
+        /// A view is always implicitly convertible to a read-only view.
+        operator const_array_view() const noexcept
+        {
+            return as_const();
+        }
+
+        /// Returns an unaligned view of the same array.
+        array_view<T> as_array_view() const noexcept
+        {
+            return {data(), size()};
+        }
+
+        /// A view is implicitly convertible to an unaligned view.
+        template<typename U,
+            typename = typename std::enable_if<
+                std::is_convertible<T (*)[], U (*)[]>::value>::type>
+        operator array_view<U>() const noexcept
+        {
+            return {data(), size()};
+        }
+
+        /// Swaps the viewed array.
+        void swap(aligned_array_view& other) noexcept
+        {
+            auto const this_copy = *this;
+            *this = other;
+            other = this_copy;
+        }
+
+        /// Returns a view of the subarray with given region. The alignment
+        /// is not known at compile time, so the result is unaligned.
+        array_view<T> subview(size_type offset, size_type count) const
+        {
+            return as_array_view().subview(offset, count);
+        }
+
+        /// Returns a view of the subarray with given region. The result keeps
+        /// the alignment if Offset elements span a multiple of Align bytes.
+        template<size_type Offset>
+        typename std::conditional<Offset * sizeof(T) % Align == 0,
+            aligned_array_view, array_view<T>>::type
+        subview(size_type count) const
+        {
+            return {data() + Offset, count};
+        }
+
+        /// Returns a view of the first count elements. The alignment is kept.
+        aligned_array_view first(size_type count) const
+        {
+            return {data(), count};
+        }
+
+        /// Returns a view of the last count elements. The result is
+        /// unaligned.
+        array_view<T> last(size_type count) const
+        {
+            return subview(size() - count, count);
+        }
+
+        /// Returns a view of the array except the first count elements. The
+        /// result is unaligned.
+        array_view<T> drop_first(size_type count) const
+        {
+            return subview(count, size() - count);
+        }
+
+        /// Returns a view of the array except the first Count elements. The
+        /// result keeps the alignment if Count elements span a multiple of
+        /// Align bytes.
+        template<size_type Count>
+        typename std::conditional<Count * sizeof(T) % Align == 0,
+            aligned_array_view, array_view<T>>::type
+        drop_first() const
+        {
+            return subview<Count>(size() - Count);
+        }
+
+        /// Returns a view of the array except the last count elements. The
+        /// alignment is kept.
+        aligned_array_view drop_last(size_type count) const
+        {
+            return first(size() - count);
+        }
+
+      private:
+        pointer data_ = nullptr;
+        size_type size_ = 0;
+    };
+
+    template<typename T, std::size_t Align>
+    constexpr std::size_t aligned_array_view<T, Align>::alignment;
+
+    /// Compares aligned views for shallow equality.
+    template<typename T, std::size_t Align>
+    bool operator==(aligned_array_view<T, Align> const& lhs,
+        aligned_array_view<T, Align> const& rhs) noexcept
+    {
+        return lhs.data() == rhs.data() && lhs.size() == rhs.size();
+    }
+
+    /// Compares aligned views for shallow inequality.
+    template<typename T, std::size_t Align>
+    bool operator!=(aligned_array_view<T, Align> const& lhs,
+        aligned_array_view<T, Align> const& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    /// Creates an aligned_array_view of a contiguous view after checking the
+    /// alignment of its first element.
+    ///
+    /// @exception std::invalid_argument if the view is not aligned to Align
+    ///            bytes.
+    template<std::size_t Align, typename T>
+    aligned_array_view<T, Align> make_aligned_array_view(array_view<T> view)
+    {
+        if (!array_view_detail::is_aligned(view.data(), Align)) {
+            throw std::invalid_argument("array_view is not aligned");
+        }
+        return {view.data(), view.size()};
+    }
+
+    /// Creates an aligned_array_view of a contiguous container or an array
+    /// after checking the alignment of its first element.
+    ///
+    /// @exception std::invalid_argument if the data is not aligned to Align
+    ///            bytes.
+    template<std::size_t Align, typename Cont,
+        typename P = decltype(array_view_detail::data(std::declval<Cont&>())),
+        typename S = decltype(array_view_detail::size(std::declval<Cont&>()))>
+    aligned_array_view<array_view_detail::deref_t<P>, Align>
+    make_aligned_array_view(Cont& cont)
+    {
+        return make_aligned_array_view<Align>(make_array_view(cont));
+    }
+} // namespace ext
+
+#endif // INCLUDED_ALIGNED_ARRAY_VIEW_HPP
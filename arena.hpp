@@ -0,0 +1,304 @@
+// arena - Monotonic allocator handing out array_views
+//
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ARENA_HPP
+#define INCLUDED_ARENA_HPP
+
+#include <algorithm> // max
+#include <cstddef> // size_t
+#include <cstdint> // uintptr_t
+#include <new> // bad_alloc, operator new, operator delete
+#include <stdexcept> // invalid_argument
+#include <type_traits> // is_trivially_destructible
+#include <utility> // move, swap
+#include <vector> // vector
+
+#include "aligned_array_view.hpp"
+#include "array_view.hpp"
+
+namespace array_view_detail
+{
+    // A chunk of raw memory owned by an arena.
+    struct arena_block
+    {
+        unsigned char* data;
+        std::size_t size;
+    };
+
+    // Returns the number of bytes from ptr to the next address aligned to
+    // align.
+    inline std::size_t padding_for(
+        unsigned char const* ptr, std::size_t align) noexcept
+    {
+        auto const address = reinterpret_cast<std::uintptr_t>(ptr);
+        return (align - address % align) % align;
+    }
+} // namespace array_view_detail
+
+namespace ext
+{
+    /// Monotonic allocator carving arrays out of large blocks.
+    ///
+    /// Allocation bumps a pointer, and nothing is freed individually.
+    /// reset() makes all memory available again while keeping the blocks,
+    /// so an arena reset once per request stops calling malloc after the
+    /// first few requests. Elements are never destroyed, so only trivially
+    /// destructible types can be allocated.
+    ///
+    /// @code
+    /// ext::arena& scratch = ext::thread_local_arena();
+    /// ext::array_view<float> weights = scratch.allocate<float>(n);
+    /// ...
+    /// scratch.reset();
+    /// @endcode
+    class arena
+    {
+      public:
+        /// The default size of a block in bytes.
+        static constexpr std::size_t default_block_size = 64 * 1024;
+
+        /// Creates an arena allocating blocks of block_size bytes. No block
+        /// is allocated until the first allocation.
+        ///
+        /// @exception std::invalid_argument if block_size is zero.
+        explicit arena(std::size_t block_size = default_block_size)
+            : block_size_{block_size}
+        {
+            if (block_size == 0) {
+                throw std::invalid_argument("block size must be positive");
+            }
+        }
+
+        ~arena()
+        {
+            release();
+        }
+
+        arena(arena const&) = delete;
+        arena& operator=(arena const&) = delete;
+
+        arena(arena&& other) noexcept
+            : block_size_{other.block_size_}
+        {
+            swap(other);
+        }
+
+        arena& operator=(arena&& other) noexcept
+        {
+            arena{std::move(other)}.swap(*this);
+            return *this;
+        }
+
+        /// Allocates an array of count default-initialized elements. The
+        /// elements are aligned to alignof(T). An empty view is returned
+        /// for zero count without allocating a block.
+        ///
+        /// @exception std::bad_alloc if memory cannot be allocated.
+        template<typename T>
+        array_view<T> allocate(std::size_t count)
+        {
+            static_assert(std::is_trivially_destructible<T>::value,
+                "arena never runs destructors");
+
+            if (count == 0) {
+                return {};
+            }
+            if (count > static_cast<std::size_t>(-1) / sizeof(T)) {
+                throw std::bad_alloc{};
+            }
+            auto const ptr = static_cast<T*>(
+                allocate_bytes(count * sizeof(T), alignof(T)));
+            for (std::size_t i = 0; i < count; i++) {
+                ::new (static_cast<void*>(ptr + i)) T;
+            }
+            return {ptr, count};
+        }
+
+        /// Allocates an array of count copies of value.
+        ///
+        /// @exception std::bad_alloc if memory cannot be allocated.
+        template<typename T>
+        array_view<T> allocate(std::size_t count, T const& value)
+        {
+            auto const view = allocate<T>(count);
+            for (auto& elem : view) {
+                elem = value;
+            }
+            return view;
+        }
+
+        /// Allocates size bytes of raw memory aligned to align, which must be
+        /// a power of two. Never returns null.
+        ///
+        /// @exception std::invalid_argument if align is not a power of two.
+        /// @exception std::bad_alloc if memory cannot be allocated.
+        void* allocate_bytes(std::size_t size, std::size_t align)
+        {
+            if (!array_view_detail::is_power_of_two(align)) {
+                throw std::invalid_argument(
+                    "alignment must be a power of two");
+            }
+            if (cursor_) {
+                auto const padding =
+                    array_view_detail::padding_for(cursor_, align);
+                auto const space = static_cast<std::size_t>(limit_ - cursor_);
+                if (padding <= space && size <= space - padding) {
+                    return bump(padding, size);
+                }
+            }
+            return allocate_slow(size, align);
+        }
+
+        /// Makes all allocated memory available again. Previously returned
+        /// views become dangling. Blocks are kept for reuse.
+        void reset() noexcept
+        {
+            current_ = 0;
+            used_ = 0;
+            if (blocks_.empty()) {
+                cursor_ = nullptr;
+                limit_ = nullptr;
+            } else {
+                cursor_ = blocks_[0].data;
+                limit_ = blocks_[0].data + blocks_[0].size;
+            }
+        }
+
+        /// Frees all blocks. Previously returned views become dangling.
+        void release() noexcept
+        {
+            for (auto const& block : blocks_) {
+                ::operator delete(block.data);
+            }
+            blocks_.clear();
+            reset();
+        }
+
+        /// Returns the number of bytes handed out since the last reset,
+        /// excluding alignment padding.
+        std::size_t bytes_used() const noexcept
+        {
+            return used_;
+        }
+
+        /// Returns the total size of the blocks owned by the arena.
+        std::size_t capacity() const noexcept
+        {
+            std::size_t total = 0;
+            for (auto const& block : blocks_) {
+                total += block.size;
+            }
+            return total;
+        }
+
+        /// Returns the number of blocks owned by the arena.
+        std::size_t block_count() const noexcept
+        {
+            return blocks_.size();
+        }
+
+        /// Swaps the state with other.
+        void swap(arena& other) noexcept
+        {
+            using std::swap;
+            swap(block_size_, other.block_size_);
+            swap(blocks_, other.blocks_);
+            swap(current_, other.current_);
+            swap(cursor_, other.cursor_);
+            swap(limit_, other.limit_);
+            swap(used_, other.used_);
+        }
+
+      private:
+        // Moves on to a following block that fits the request, allocating
+        // one if there is none.
+        void* allocate_slow(std::size_t size, std::size_t align)
+        {
+            auto const worst_case = size + align - 1;
+            if (worst_case < size) {
+                throw std::bad_alloc{};
+            }
+
+            // Blocks after the current one are unused since the last reset.
+            auto const first = cursor_ ? current_ + 1 : 0;
+            auto next = first;
+            while (next < blocks_.size() && blocks_[next].size < worst_case) {
+                next++;
+            }
+            if (next == blocks_.size()) {
+                // Grow the list first so that push_back cannot throw and
+                // leak the new block.
+                if (blocks_.size() == blocks_.capacity()) {
+                    blocks_.reserve(std::max<std::size_t>(
+                        2 * blocks_.size(), 4));
+                }
+                auto const block_size = std::max(block_size_, worst_case);
+                auto const data =
+                    static_cast<unsigned char*>(::operator new(block_size));
+                blocks_.push_back({data, block_size});
+            }
+            std::swap(blocks_[first], blocks_[next]);
+
+            auto const& block = blocks_[first];
+            current_ = first;
+            cursor_ = block.data;
+            limit_ = block.data + block.size;
+            return bump(array_view_detail::padding_for(cursor_, align), size);
+        }
+
+        void* bump(std::size_t padding, std::size_t size) noexcept
+        {
+            auto const ptr = cursor_ + padding;
+            cursor_ = ptr + size;
+            used_ += size;
+            return ptr;
+        }
+
+        std::size_t block_size_;
+        std::vector<array_view_detail::arena_block> blocks_;
+        std::size_t current_ = 0;
+        unsigned char* cursor_ = nullptr;
+        unsigned char* limit_ = nullptr;
+        std::size_t used_ = 0;
+    };
+
+    /// Swaps two arenas.
+    inline void swap(arena& a, arena& b) noexcept
+    {
+        a.swap(b);
+    }
+
+    /// Returns an arena owned by the calling thread. It lives until the
+    /// thread exits.
+    inline arena& thread_local_arena()
+    {
+        static thread_local arena instance;
+        return instance;
+    }
+} // namespace ext
+
+#endif // INCLUDED_ARENA_HPP
@@ -31,7 +31,8 @@
 #include <cstddef> // size_t
 #include <iterator> // reverse_iterator
 #include <stdexcept> // out_of_range
-#include <type_traits> // remove_cv
+#include <type_traits> // conditional, enable_if, is_const, is_convertible,
+                       // is_same, remove_cv
 #include <utility> // declval
 
 namespace array_view_detail
@@ -49,6 +50,11 @@ namespace array_view_detail
     template<typename T>
     using deref_t = typename deref<T>::type;
 
+    // Copies the const qualifier of From to To.
+    template<typename From, typename To>
+    using copy_const_t = typename std::conditional<
+        std::is_const<From>::value, To const, To>::type;
+
     // Returns a pointer to the first element of a contiguous container.
     //
     // XXX: Here almost no concept checks are done, so this may be broken for
@@ -81,9 +87,20 @@ namespace array_view_detail
 
 namespace ext
 {
+    /// The extent of an array_view whose size is determined at run time.
+    constexpr std::size_t dynamic_extent = static_cast<std::size_t>(-1);
+
     /// Lightweight range view of contiguous sequence.
+    ///
+    /// The number of elements is fixed at compile time if Extent is given.
+    /// Such a view stores only a pointer and converts implicitly to the
+    /// view with dynamic extent.
+    template<typename T, std::size_t Extent = dynamic_extent>
+    class array_view;
+
+    /// Lightweight range view of contiguous sequence with dynamic extent.
     template<typename T>
-    class array_view
+    class array_view<T, dynamic_extent>
     {
       public:
         /// The non-qualified type of the elements.
@@ -111,6 +128,10 @@ namespace ext
         /// the same as array_view<T> if T is already const qualified.
         using const_array_view = array_view<T const>;
 
+        /// The number of elements known at compile time. Always
+        /// dynamic_extent.
+        static constexpr size_type extent = dynamic_extent;
+
         /// The default constructor creates an empty view.
         constexpr array_view() noexcept = default;
 
@@ -246,11 +267,288 @@ namespace ext
             return subview(0, size() - count);
         }
 
+        /// Returns a fixed-size view of the subarray with given region. The
+        /// behavior is undefined if the region is out of bounds.
+        template<size_type Offset, size_type Count>
+        constexpr array_view<T, Count> subview() const
+        {
+            return array_view<T, Count>{data() + Offset};
+        }
+
+        /// Returns a fixed-size view of the first Count elements. The
+        /// behavior is undefined if the view is shorter than Count.
+        template<size_type Count>
+        constexpr array_view<T, Count> first() const
+        {
+            return array_view<T, Count>{data()};
+        }
+
+        /// Returns a fixed-size view of the last Count elements. The behavior
+        /// is undefined if the view is shorter than Count.
+        template<size_type Count>
+        constexpr array_view<T, Count> last() const
+        {
+            return array_view<T, Count>{data() + (size() - Count)};
+        }
+
       private:
         pointer data_ = nullptr;
         size_type size_ = 0;
     };
 
+    template<typename T>
+    constexpr std::size_t array_view<T, dynamic_extent>::extent;
+
+    /// Lightweight range view of contiguous sequence with static extent.
+    template<typename T, std::size_t Extent>
+    class array_view
+    {
+      public:
+        /// The non-qualified type of the elements.
+        using value_type = typename std::remove_cv<T>::type;
+
+        /// The type of a pointer to an element.
+        using pointer = T*;
+
+        /// The type of a reference to an element.
+        using reference = T&;
+
+        /// The type of size and index values.
+        using size_type = std::size_t;
+
+        /// The type of iterators. Guaranteed to be a random access iterator.
+        using iterator = T*;
+
+        /// The type of reverse iterators. Guaranteed to be a random access
+        /// iterator.
+        using reverse_iterator = std::reverse_iterator<iterator>;
+
+        /// The type of read-only array_view with the same value_type and
+        /// extent.
+        using const_array_view = array_view<T const, Extent>;
+
+        /// The type of array_view with the same value_type and dynamic
+        /// extent.
+        using dynamic_array_view = array_view<T>;
+
+        /// The number of elements.
+        static constexpr size_type extent = Extent;
+
+        /// The default constructor creates an empty view. Only available for
+        /// zero-sized views.
+        template<size_type E = Extent,
+            typename = typename std::enable_if<E == 0>::type>
+        constexpr array_view() noexcept
+        {
+        }
+
+        /// This constructor creates a view of region [data, data + Extent).
+        constexpr explicit array_view(pointer data) noexcept
+            : data_{data}
+        {
+        }
+
+        /// This constructor creates a view of a built-in array.
+        template<size_type N,
+            typename = typename std::enable_if<N == Extent>::type>
+        constexpr array_view(T (&array)[N]) noexcept
+            : data_{array}
+        {
+        }
+
+        /// Tests if the view is empty.
+        static constexpr bool empty() noexcept
+        {
+            return Extent == 0;
+        }
+
+        /// Returns the number of elements. This is a constant expression.
+        static constexpr size_type size() noexcept
+        {
+            return Extent;
+        }
+
+        /// Returns a pointer to the first element.
+        constexpr pointer data() const noexcept
+        {
+            return data_;
+        }
+
+        /// Returns a reference to the first element.
+        constexpr reference front() const
+        {
+            static_assert(Extent > 0, "front() of an empty view");
+            return operator[](0);
+        }
+
+        /// Returns a reference to the last element.
+        constexpr reference back() const
+        {
+            static_assert(Extent > 0, "back() of an empty view");
+            return operator[](Extent - 1);
+        }
+
+        /// Returns a reference to the idx-th element. The behavior is
+        /// undefined if the index is out of bounds.
+        constexpr reference operator[](size_type idx) const
+        {
+            return data()[idx];
+        }
+
+        /// Returns a reference to the idx-th element.
+        ///
+        /// @exception std::out_of_range if the index is out of bounds.
+        reference at(size_type idx) const
+        {
+            if (idx >= size()) {
+                throw std::out_of_range("array_view access out-of-bounds");
+            }
+            return operator[](idx);
+        }
+
+        /// Returns an iterator to the beginning.
+        constexpr iterator begin() const noexcept
+        {
+            return data();
+        }
+
+        /// Returns an iterator to the end.
+        constexpr iterator end() const noexcept
+        {
+            return data() + Extent;
+        }
+
+        /// Returns a reverse iterator to the reverse beginning.
+        reverse_iterator rbegin() const noexcept
+        {
+            return reverse_iterator{end()};
+        }
+
+        /// Returns a reverse iterator to the reverse end.
+        reverse_iterator rend() const noexcept
+        {
+            return reverse_iterator{begin()};
+        }
+
+        /// Returns a read-only view of the same array.
+        constexpr const_array_view as_const() const noexcept
+        {
+            return const_array_view{data()};
+        }
+
+        /// Returns a view of the same array with dynamic extent.
+        constexpr dynamic_array_view as_dynamic() const noexcept
+        {
+            return {data(), Extent};
+        }
+
+        /// A view is implicitly convertible to a view of the same array with
+        /// dynamic extent.
+        template<typename U,
+            typename = typename std::enable_if<
+                std::is_convertible<T (*)[], U (*)[]>::value>::type>
+        constexpr operator array_view<U>() const noexcept
+        {
+            return {data(), Extent};
+        }
+
+        /// A view is always implicitly convertible to a read-only view.
+        template<typename U,
+            typename = typename std::enable_if<
+                std::is_convertible<T (*)[], U (*)[]>::value>::type>
+        constexpr operator array_view<U, Extent>() const noexcept
+        {
+            return array_view<U, Extent>{data()};
+        }
+
+        /// Swaps the viewed array.
+        void swap(array_view& other) noexcept
+        {
+            auto const this_copy = *this;
+            *this = other;
+            other = this_copy;
+        }
+
+        /// Returns a fixed-size view of the subarray with given region.
+        template<size_type Offset, size_type Count>
+        constexpr array_view<T, Count> subview() const
+        {
+            static_assert(Offset <= Extent && Count <= Extent - Offset,
+                "subview out of bounds");
+            return array_view<T, Count>{data() + Offset};
+        }
+
+        /// Returns a fixed-size view of the first Count elements.
+        template<size_type Count>
+        constexpr array_view<T, Count> first() const
+        {
+            return subview<0, Count>();
+        }
+
+        /// Returns a fixed-size view of the last Count elements.
+        template<size_type Count>
+        constexpr array_view<T, Count> last() const
+        {
+            static_assert(Count <= Extent, "last() out of bounds");
+            return subview<Extent - Count, Count>();
+        }
+
+        /// Returns a fixed-size view of the array except the first Count
+        /// elements.
+        template<size_type Count>
+        constexpr array_view<T, Extent - Count> drop_first() const
+        {
+            static_assert(Count <= Extent, "drop_first() out of bounds");
+            return subview<Count, Extent - Count>();
+        }
+
+        /// Returns a fixed-size view of the array except the last Count
+        /// elements.
+        template<size_type Count>
+        constexpr array_view<T, Extent - Count> drop_last() const
+        {
+            static_assert(Count <= Extent, "drop_last() out of bounds");
+            return subview<0, Extent - Count>();
+        }
+
+        /// Returns a view of the subarray with given region.
+        constexpr dynamic_array_view subview(
+            size_type offset, size_type count) const
+        {
+            return {data() + offset, count};
+        }
+
+        /// Returns a view of the first count elements.
+        constexpr dynamic_array_view first(size_type count) const
+        {
+            return subview(0, count);
+        }
+
+        /// Returns a view of the last count elements.
+        constexpr dynamic_array_view last(size_type count) const
+        {
+            return subview(Extent - count, count);
+        }
+
+        /// Returns a view of the array except the first count elements.
+        constexpr dynamic_array_view drop_first(size_type count) const
+        {
+            return subview(count, Extent - count);
+        }
+
+        /// Returns a view of the array except the last count elements.
+        constexpr dynamic_array_view drop_last(size_type count) const
+        {
+            return subview(0, Extent - count);
+        }
+
+      private:
+        pointer data_ = nullptr;
+    };
+
+    template<typename T, std::size_t Extent>
+    constexpr std::size_t array_view<T, Extent>::extent;
+
     /// Compares views for shallow equality.
     ///
     /// Two views are equal if and only if the viewed memory region is exactly
@@ -314,6 +612,29 @@ namespace ext
         return !(lhs == rhs);
     }
 
+    /// Compares fixed-size views for shallow equality. Const and non-const
+    /// views can be compared.
+    template<typename T, typename U, std::size_t N,
+        typename = typename std::enable_if<N != dynamic_extent
+            && std::is_same<typename std::remove_cv<T>::type,
+                typename std::remove_cv<U>::type>::value>::type>
+    bool operator==(
+        array_view<T, N> const& lhs, array_view<U, N> const& rhs) noexcept
+    {
+        return lhs.as_const().data() == rhs.as_const().data();
+    }
+
+    /// Compares fixed-size views for shallow inequality.
+    template<typename T, typename U, std::size_t N,
+        typename = typename std::enable_if<N != dynamic_extent
+            && std::is_same<typename std::remove_cv<T>::type,
+                typename std::remove_cv<U>::type>::value>::type>
+    bool operator!=(
+        array_view<T, N> const& lhs, array_view<U, N> const& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
     /// Creates an array_view of the elements of a contiguous container.
     ///
     /// For an array the pointer to the first element and the compile-time
@@ -350,6 +671,15 @@ namespace ext
         return {ptr, size};
     }
 
+    /// Creates a fixed-size array_view of the region [ptr, ptr + N).
+    ///
+    /// The behavior is undefined if the memory region is not valid.
+    template<std::size_t N, typename T>
+    constexpr array_view<T, N> make_array_view(T* ptr) noexcept
+    {
+        return array_view<T, N>{ptr};
+    }
+
     /// Creates an array_view of the region [begin, end).
     ///
     /// The behavior is undefined if the memory region is not valid.
@@ -0,0 +1,280 @@
+// array_view_bytes - Byte views and checked reinterpretation of array_view
+//
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ARRAY_VIEW_BYTES_HPP
+#define INCLUDED_ARRAY_VIEW_BYTES_HPP
+
+#include <cstddef> // size_t
+#include <cstdint> // uintptr_t
+#include <cstring> // memcpy
+#include <stdexcept> // invalid_argument, out_of_range
+#include <type_traits> // enable_if, integral_constant, is_const, is_same,
+                       // is_trivially_copyable, remove_cv
+
+#include "aligned_array_view.hpp"
+#include "array_view.hpp"
+
+namespace array_view_detail
+{
+    // Tests if T is a (possibly const) byte type that may alias any object.
+    template<typename T>
+    struct is_byte
+        : std::integral_constant<bool,
+              std::is_same<typename std::remove_cv<T>::type, char>::value
+              || std::is_same<typename std::remove_cv<T>::type,
+                  unsigned char>::value>
+    {
+    };
+
+    // Checks that bytes can be viewed as an array of U.
+    template<typename U>
+    void check_reinterpretable(void const* data, std::size_t size)
+    {
+        if (size % sizeof(U) != 0) {
+            throw std::invalid_argument(
+                "byte count is not a multiple of element size");
+        }
+        if (!is_aligned(data, alignof(U))) {
+            throw std::invalid_argument("bytes are misaligned for the type");
+        }
+    }
+} // namespace array_view_detail
+
+namespace ext
+{
+    /// Returns a read-only view of the object representation of the
+    /// elements.
+    template<typename T>
+    array_view<unsigned char const> as_bytes(array_view<T> view) noexcept
+    {
+        static_assert(std::is_trivially_copyable<
+                          typename std::remove_cv<T>::type>::value,
+            "element type must be trivially copyable");
+        return {reinterpret_cast<unsigned char const*>(view.data()),
+            view.size() * sizeof(T)};
+    }
+
+    /// Returns a writable view of the object representation of the
+    /// elements.
+    template<typename T,
+        typename = typename std::enable_if<!std::is_const<T>::value>::type>
+    array_view<unsigned char> as_writable_bytes(array_view<T> view) noexcept
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+            "element type must be trivially copyable");
+        return {reinterpret_cast<unsigned char*>(view.data()),
+            view.size() * sizeof(T)};
+    }
+
+    /// Returns a view of bytes as an array of U. The result is const
+    /// qualified if the bytes are.
+    ///
+    /// @code
+    /// ext::array_view<unsigned char const> buffer = receive();
+    /// auto const samples = ext::reinterpret_view<std::uint32_t>(buffer);
+    /// @endcode
+    ///
+    /// @exception std::invalid_argument if the number of bytes is not a
+    /// multiple of sizeof(U) or the bytes are not aligned for U.
+    template<typename U, typename Byte>
+    array_view<array_view_detail::copy_const_t<Byte, U>> reinterpret_view(
+        array_view<Byte> bytes)
+    {
+        static_assert(array_view_detail::is_byte<Byte>::value,
+            "source view must be a view of bytes");
+        static_assert(std::is_trivially_copyable<
+                          typename std::remove_cv<U>::type>::value,
+            "target type must be trivially copyable");
+
+        using target = array_view_detail::copy_const_t<Byte, U>;
+        array_view_detail::check_reinterpretable<U>(
+            bytes.data(), bytes.size());
+        return {reinterpret_cast<target*>(bytes.data()),
+            bytes.size() / sizeof(U)};
+    }
+
+    /// Cursor carving successive typed subviews off a view of bytes. Nothing
+    /// is copied except by read_value(). A failed read throws and leaves the
+    /// cursor unchanged.
+    ///
+    /// @code
+    /// ext::byte_cursor cursor{buffer};
+    /// header const& head = cursor.read<header>();
+    /// auto const payload = cursor.read_array<std::uint32_t>(head.count);
+    /// @endcode
+    template<typename Byte>
+    class basic_byte_cursor
+    {
+        static_assert(array_view_detail::is_byte<Byte>::value,
+            "cursor must be over bytes");
+
+        template<typename U>
+        using target_t = array_view_detail::copy_const_t<Byte, U>;
+
+      public:
+        /// The type of the viewed bytes.
+        using byte_view = array_view<Byte>;
+
+        /// The type of size values.
+        using size_type = std::size_t;
+
+        /// Creates a cursor at the beginning of an empty view.
+        basic_byte_cursor() = default;
+
+        /// Creates a cursor at the beginning of bytes.
+        basic_byte_cursor(byte_view bytes) noexcept
+            : bytes_{bytes}
+        {
+        }
+
+        /// Returns the number of bytes consumed so far.
+        size_type position() const noexcept
+        {
+            return pos_;
+        }
+
+        /// Returns the number of bytes not consumed yet.
+        size_type remaining() const noexcept
+        {
+            return bytes_.size() - pos_;
+        }
+
+        /// Tests if all bytes are consumed.
+        bool empty() const noexcept
+        {
+            return remaining() == 0;
+        }
+
+        /// Returns the bytes not consumed yet.
+        byte_view rest() const noexcept
+        {
+            return bytes_.drop_first(pos_);
+        }
+
+        /// Consumes count bytes and returns them.
+        ///
+        /// @exception std::out_of_range if fewer bytes remain.
+        byte_view bytes(size_type count)
+        {
+            check_remaining(count);
+            auto const result = bytes_.subview(pos_, count);
+            pos_ += count;
+            return result;
+        }
+
+        /// Consumes count bytes.
+        ///
+        /// @exception std::out_of_range if fewer bytes remain.
+        basic_byte_cursor& skip(size_type count)
+        {
+            check_remaining(count);
+            pos_ += count;
+            return *this;
+        }
+
+        /// Consumes padding bytes up to the next address aligned to given
+        /// boundary.
+        ///
+        /// @exception std::invalid_argument if alignment is not a power of
+        /// two.
+        /// @exception std::out_of_range if the padding exceeds the rest.
+        basic_byte_cursor& align(size_type alignment)
+        {
+            if (!array_view_detail::is_power_of_two(alignment)) {
+                throw std::invalid_argument(
+                    "alignment must be a power of two");
+            }
+            auto const address =
+                reinterpret_cast<std::uintptr_t>(bytes_.data() + pos_);
+            auto const misalignment = address % alignment;
+            return skip(misalignment == 0 ? 0 : alignment - misalignment);
+        }
+
+        /// Consumes sizeof(U) bytes and returns a reference to them as U.
+        ///
+        /// @exception std::out_of_range if fewer bytes remain.
+        /// @exception std::invalid_argument if the bytes are misaligned.
+        template<typename U>
+        target_t<U>& read()
+        {
+            return read_array<U>(1).front();
+        }
+
+        /// Consumes count * sizeof(U) bytes and returns a view of them as an
+        /// array of U.
+        ///
+        /// @exception std::out_of_range if fewer bytes remain.
+        /// @exception std::invalid_argument if the bytes are misaligned.
+        template<typename U>
+        array_view<target_t<U>> read_array(size_type count)
+        {
+            if (count > remaining() / sizeof(U)) {
+                throw std::out_of_range("byte_cursor underflow");
+            }
+            auto const size = count * sizeof(U);
+            auto const result =
+                reinterpret_view<U>(bytes_.subview(pos_, size));
+            pos_ += size;
+            return result;
+        }
+
+        /// Consumes sizeof(U) bytes and returns a copy of them as U. The
+        /// bytes need not be aligned.
+        ///
+        /// @exception std::out_of_range if fewer bytes remain.
+        template<typename U>
+        typename std::remove_cv<U>::type read_value()
+        {
+            static_assert(std::is_trivially_copyable<
+                              typename std::remove_cv<U>::type>::value,
+                "target type must be trivially copyable");
+
+            typename std::remove_cv<U>::type value;
+            std::memcpy(&value, bytes(sizeof value).data(), sizeof value);
+            return value;
+        }
+
+      private:
+        void check_remaining(size_type count) const
+        {
+            if (count > remaining()) {
+                throw std::out_of_range("byte_cursor underflow");
+            }
+        }
+
+        byte_view bytes_;
+        size_type pos_ = 0;
+    };
+
+    /// Cursor over read-only bytes.
+    using byte_cursor = basic_byte_cursor<unsigned char const>;
+
+    /// Cursor over writable bytes yielding writable subviews.
+    using writable_byte_cursor = basic_byte_cursor<unsigned char>;
+} // namespace ext
+
+#endif // INCLUDED_ARRAY_VIEW_BYTES_HPP
@@ -0,0 +1,672 @@
+// array_view_chunks - Chunk and window iteration over array_view
+//
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ARRAY_VIEW_CHUNKS_HPP
+#define INCLUDED_ARRAY_VIEW_CHUNKS_HPP
+
+#include <algorithm> // min
+#include <cmath> // llround
+#include <cstddef> // ptrdiff_t, size_t
+#include <cstdint> // uintptr_t
+#include <iterator> // random_access_iterator_tag
+#include <stdexcept> // invalid_argument
+#include <type_traits> // integral_constant
+#include <utility> // pair
+#include <vector> // vector
+
+#include "array_view.hpp"
+
+namespace array_view_detail
+{
+    // Random access iterator over the subviews of a range. The iterator
+    // holds a copy of the range, so it stays valid after the range object
+    // is destroyed.
+    template<typename Range>
+    class subview_iterator
+    {
+      public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename Range::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        subview_iterator() = default;
+
+        subview_iterator(Range const& range, std::size_t index) noexcept
+            : range_(range)
+            , index_{index}
+        {
+        }
+
+        reference operator*() const
+        {
+            return range_[index_];
+        }
+
+        reference operator[](difference_type n) const
+        {
+            return range_[advanced(n)];
+        }
+
+        subview_iterator& operator++() noexcept
+        {
+            ++index_;
+            return *this;
+        }
+
+        subview_iterator operator++(int) noexcept
+        {
+            auto const copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        subview_iterator& operator--() noexcept
+        {
+            --index_;
+            return *this;
+        }
+
+        subview_iterator operator--(int) noexcept
+        {
+            auto const copy = *this;
+            --*this;
+            return copy;
+        }
+
+        subview_iterator& operator+=(difference_type n) noexcept
+        {
+            index_ = advanced(n);
+            return *this;
+        }
+
+        subview_iterator& operator-=(difference_type n) noexcept
+        {
+            return *this += -n;
+        }
+
+        friend subview_iterator operator+(
+            subview_iterator it, difference_type n) noexcept
+        {
+            return it += n;
+        }
+
+        friend subview_iterator operator+(
+            difference_type n, subview_iterator it) noexcept
+        {
+            return it += n;
+        }
+
+        friend subview_iterator operator-(
+            subview_iterator it, difference_type n) noexcept
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(
+            subview_iterator const& lhs, subview_iterator const& rhs) noexcept
+        {
+            return static_cast<difference_type>(lhs.index_)
+                - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(
+            subview_iterator const& lhs, subview_iterator const& rhs) noexcept
+        {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(
+            subview_iterator const& lhs, subview_iterator const& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(
+            subview_iterator const& lhs, subview_iterator const& rhs) noexcept
+        {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(
+            subview_iterator const& lhs, subview_iterator const& rhs) noexcept
+        {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(
+            subview_iterator const& lhs, subview_iterator const& rhs) noexcept
+        {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(
+            subview_iterator const& lhs, subview_iterator const& rhs) noexcept
+        {
+            return !(lhs < rhs);
+        }
+
+      private:
+        std::size_t advanced(difference_type n) const noexcept
+        {
+            return static_cast<std::size_t>(
+                static_cast<difference_type>(index_) + n);
+        }
+
+        Range range_;
+        std::size_t index_ = 0;
+    };
+
+    // Creates a view of n elements from ptr with given extent.
+    template<typename T, std::size_t Extent>
+    ext::array_view<T, Extent> make_extent_view(
+        T* ptr, std::size_t, std::false_type) noexcept
+    {
+        return ext::array_view<T, Extent>{ptr};
+    }
+
+    template<typename T, std::size_t Extent>
+    ext::array_view<T> make_extent_view(
+        T* ptr, std::size_t n, std::true_type) noexcept
+    {
+        return {ptr, n};
+    }
+
+    template<typename T, std::size_t Extent>
+    ext::array_view<T, Extent> make_extent_view(T* ptr, std::size_t n)
+    {
+        return make_extent_view<T, Extent>(ptr, n,
+            std::integral_constant<bool, Extent == ext::dynamic_extent>{});
+    }
+
+    inline void check_chunk_size(std::size_t n)
+    {
+        if (n == 0) {
+            throw std::invalid_argument("chunk size must be positive");
+        }
+    }
+
+    inline std::size_t gcd(std::size_t a, std::size_t b) noexcept
+    {
+        while (b != 0) {
+            auto const r = a % b;
+            a = b;
+            b = r;
+        }
+        return a;
+    }
+
+    // Aligned split points of a view: the elements at first + k * step,
+    // k = 0, 1, ..., start at addresses that are multiples of the
+    // alignment. If no element is aligned, first is 0 and the split points
+    // are only spaced by the alignment.
+    struct partition_grid
+    {
+        std::size_t first = 0;
+        std::size_t step = 1;
+
+        // Returns the number of split points at or after first and before
+        // size, each starting a granule of step elements.
+        std::size_t granules(std::size_t size) const noexcept
+        {
+            return size <= first ? 0 : (size - first + step - 1) / step;
+        }
+
+        // Returns the index of the k-th split point clamped to size.
+        std::size_t point(std::size_t k, std::size_t size) const noexcept
+        {
+            return std::min(first + k * step, size);
+        }
+    };
+
+    template<typename T>
+    partition_grid make_partition_grid(
+        T const* data, std::size_t alignment)
+    {
+        if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+            throw std::invalid_argument("alignment must be a power of two");
+        }
+
+        partition_grid grid;
+        grid.step = alignment / gcd(alignment, sizeof(T));
+
+        auto const address = reinterpret_cast<std::uintptr_t>(data);
+        for (std::size_t i = 0; i < grid.step; i++) {
+            if ((address + i * sizeof(T)) % alignment == 0) {
+                grid.first = i;
+                break;
+            }
+        }
+        return grid;
+    }
+
+    inline void check_part_count(std::size_t n)
+    {
+        if (n == 0) {
+            throw std::invalid_argument("part count must be positive");
+        }
+    }
+} // namespace array_view_detail
+
+namespace ext
+{
+    /// Range of consecutive non-overlapping subviews of at most n elements.
+    /// The last chunk is shorter if the size of the view is not a multiple
+    /// of n.
+    template<typename T>
+    class chunk_range
+    {
+      public:
+        /// The type of chunks.
+        using value_type = array_view<T>;
+
+        /// The type of size and index values.
+        using size_type = std::size_t;
+
+        /// The type of iterators. Guaranteed to be a random access iterator
+        /// yielding chunks by value.
+        using iterator = array_view_detail::subview_iterator<chunk_range>;
+
+        chunk_range() = default;
+
+        chunk_range(array_view<T> view, size_type n) noexcept
+            : view_{view}
+            , n_{n}
+        {
+        }
+
+        /// Returns the number of chunks.
+        size_type size() const noexcept
+        {
+            return view_.size() / n_ + (view_.size() % n_ != 0);
+        }
+
+        /// Tests if there is no chunk.
+        bool empty() const noexcept
+        {
+            return view_.empty();
+        }
+
+        /// Returns the idx-th chunk.
+        value_type operator[](size_type idx) const
+        {
+            auto const offset = idx * n_;
+            return view_.subview(offset, std::min(n_, view_.size() - offset));
+        }
+
+        iterator begin() const noexcept
+        {
+            return {*this, 0};
+        }
+
+        iterator end() const noexcept
+        {
+            return {*this, size()};
+        }
+
+      private:
+        array_view<T> view_;
+        size_type n_ = 1;
+    };
+
+    /// Range of consecutive non-overlapping subviews of exactly n elements.
+    /// The leftover elements are accessible via remainder(). If Extent is
+    /// given, chunks are fixed-size views of Extent elements.
+    template<typename T, std::size_t Extent = dynamic_extent>
+    class exact_chunk_range
+    {
+      public:
+        /// The type of chunks.
+        using value_type = array_view<T, Extent>;
+
+        /// The type of size and index values.
+        using size_type = std::size_t;
+
+        /// The type of iterators. Guaranteed to be a random access iterator
+        /// yielding chunks by value.
+        using iterator =
+            array_view_detail::subview_iterator<exact_chunk_range>;
+
+        exact_chunk_range() = default;
+
+        exact_chunk_range(array_view<T> view, size_type n) noexcept
+            : view_{view}
+            , n_{n}
+        {
+        }
+
+        /// Returns the number of full chunks.
+        size_type size() const noexcept
+        {
+            return view_.size() / n_;
+        }
+
+        /// Tests if there is no full chunk.
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        /// Returns the idx-th chunk.
+        value_type operator[](size_type idx) const
+        {
+            return array_view_detail::make_extent_view<T, Extent>(
+                view_.data() + idx * n_, n_);
+        }
+
+        /// Returns the elements not covered by any full chunk.
+        array_view<T> remainder() const
+        {
+            return view_.drop_first(size() * n_);
+        }
+
+        iterator begin() const noexcept
+        {
+            return {*this, 0};
+        }
+
+        iterator end() const noexcept
+        {
+            return {*this, size()};
+        }
+
+      private:
+        array_view<T> view_;
+        size_type n_ = Extent == dynamic_extent ? 1 : Extent;
+    };
+
+    /// Range of all overlapping subviews of n consecutive elements. If
+    /// Extent is given, windows are fixed-size views of Extent elements.
+    template<typename T, std::size_t Extent = dynamic_extent>
+    class window_range
+    {
+      public:
+        /// The type of windows.
+        using value_type = array_view<T, Extent>;
+
+        /// The type of size and index values.
+        using size_type = std::size_t;
+
+        /// The type of iterators. Guaranteed to be a random access iterator
+        /// yielding windows by value.
+        using iterator = array_view_detail::subview_iterator<window_range>;
+
+        window_range() = default;
+
+        window_range(array_view<T> view, size_type n) noexcept
+            : view_{view}
+            , n_{n}
+        {
+        }
+
+        /// Returns the number of windows.
+        size_type size() const noexcept
+        {
+            return view_.size() < n_ ? 0 : view_.size() - n_ + 1;
+        }
+
+        /// Tests if there is no window.
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        /// Returns the window starting at idx.
+        value_type operator[](size_type idx) const
+        {
+            return array_view_detail::make_extent_view<T, Extent>(
+                view_.data() + idx, n_);
+        }
+
+        iterator begin() const noexcept
+        {
+            return {*this, 0};
+        }
+
+        iterator end() const noexcept
+        {
+            return {*this, size()};
+        }
+
+      private:
+        array_view<T> view_;
+        size_type n_ = Extent == dynamic_extent ? 1 : Extent;
+    };
+
+    /// The size of a cache line assumed by the partitioning functions.
+    constexpr std::size_t cache_line_size = 64;
+
+    /// Range of n consecutive parts covering a view, split at elements that
+    /// start on an alignment boundary so that no cache line (or page) is
+    /// shared by two parts. Parts have roughly equal sizes; the first part
+    /// also holds the elements before the first boundary, and trailing
+    /// parts are empty if the view has fewer boundaries than parts.
+    template<typename T>
+    class partition_range
+    {
+      public:
+        /// The type of parts.
+        using value_type = array_view<T>;
+
+        /// The type of size and index values.
+        using size_type = std::size_t;
+
+        /// The type of iterators. Guaranteed to be a random access iterator
+        /// yielding parts by value.
+        using iterator = array_view_detail::subview_iterator<partition_range>;
+
+        partition_range() = default;
+
+        partition_range(array_view<T> view, size_type n,
+            array_view_detail::partition_grid grid) noexcept
+            : view_{view}
+            , n_{n}
+            , grid_(grid)
+            , granules_{grid.granules(view.size())}
+        {
+        }
+
+        /// Returns the number of parts.
+        size_type size() const noexcept
+        {
+            return n_;
+        }
+
+        /// Tests if there is no part.
+        bool empty() const noexcept
+        {
+            return n_ == 0;
+        }
+
+        /// Returns the idx-th part.
+        value_type operator[](size_type idx) const
+        {
+            auto const begin = boundary(idx);
+            return view_.subview(begin, boundary(idx + 1) - begin);
+        }
+
+        iterator begin() const noexcept
+        {
+            return {*this, 0};
+        }
+
+        iterator end() const noexcept
+        {
+            return {*this, size()};
+        }
+
+      private:
+        size_type boundary(size_type idx) const noexcept
+        {
+            if (idx == 0) {
+                return 0;
+            }
+            if (idx == n_) {
+                return view_.size();
+            }
+            return grid_.point(idx * granules_ / n_, view_.size());
+        }
+
+        array_view<T> view_;
+        size_type n_ = 0;
+        array_view_detail::partition_grid grid_;
+        size_type granules_ = 0;
+    };
+
+    /// Returns a range of chunks of at most n elements.
+    ///
+    /// @code
+    /// for (ext::array_view<float> batch : ext::chunks(view, 256)) {
+    ///     process(batch);
+    /// }
+    /// @endcode
+    ///
+    /// @exception std::invalid_argument if n is zero.
+    template<typename T>
+    chunk_range<T> chunks(array_view<T> view, std::size_t n)
+    {
+        array_view_detail::check_chunk_size(n);
+        return {view, n};
+    }
+
+    /// Returns a range of chunks of exactly n elements.
+    ///
+    /// @exception std::invalid_argument if n is zero.
+    template<typename T>
+    exact_chunk_range<T> exact_chunks(array_view<T> view, std::size_t n)
+    {
+        array_view_detail::check_chunk_size(n);
+        return {view, n};
+    }
+
+    /// Returns a range of fixed-size chunks of exactly N elements.
+    template<std::size_t N, typename T>
+    exact_chunk_range<T, N> exact_chunks(array_view<T> view) noexcept
+    {
+        static_assert(N > 0, "chunk size must be positive");
+        return {view, N};
+    }
+
+    /// Returns a range of overlapping windows of n elements.
+    ///
+    /// @exception std::invalid_argument if n is zero.
+    template<typename T>
+    window_range<T> windows(array_view<T> view, std::size_t n)
+    {
+        array_view_detail::check_chunk_size(n);
+        return {view, n};
+    }
+
+    /// Returns a range of overlapping fixed-size windows of N elements.
+    template<std::size_t N, typename T>
+    window_range<T, N> windows(array_view<T> view) noexcept
+    {
+        static_assert(N > 0, "window size must be positive");
+        return {view, N};
+    }
+
+    /// Splits a view into n parts for n threads, with boundaries on
+    /// alignment-byte boundaries. Use the default cache line size to avoid
+    /// false sharing between writers, or the page size to let each thread
+    /// first-touch whole pages on NUMA systems.
+    ///
+    /// @code
+    /// auto const parts = ext::partition(view, threads.size());
+    /// for (std::size_t i = 0; i < parts.size(); i++) {
+    ///     threads[i] = std::thread{work, parts[i]};
+    /// }
+    /// @endcode
+    ///
+    /// @exception std::invalid_argument if n is zero or the alignment is not
+    /// a power of two.
+    template<typename T>
+    partition_range<T> partition(array_view<T> view, std::size_t n,
+        std::size_t alignment = cache_line_size)
+    {
+        array_view_detail::check_part_count(n);
+        return {view, n,
+            array_view_detail::make_partition_grid(view.data(), alignment)};
+    }
+
+    /// Splits a view into parts with sizes proportional to the weights, for
+    /// threads of unequal speed, with boundaries on alignment-byte
+    /// boundaries as in partition().
+    ///
+    /// @exception std::invalid_argument if weights is empty, a weight is
+    /// negative or not finite, all weights are zero, or the alignment is not
+    /// a power of two.
+    template<typename T>
+    std::vector<array_view<T>> weighted_partition(array_view<T> view,
+        array_view<double const> weights,
+        std::size_t alignment = cache_line_size)
+    {
+        array_view_detail::check_part_count(weights.size());
+
+        double total = 0;
+        for (auto const weight : weights) {
+            if (!(weight >= 0) || !std::isfinite(weight)) {
+                throw std::invalid_argument("weights must be non-negative");
+            }
+            total += weight;
+        }
+        if (total == 0) {
+            throw std::invalid_argument("weights must not be all zero");
+        }
+
+        auto const grid =
+            array_view_detail::make_partition_grid(view.data(), alignment);
+        auto const granules = grid.granules(view.size());
+
+        std::vector<array_view<T>> parts;
+        parts.reserve(weights.size());
+        std::size_t begin = 0;
+        double cumulative = 0;
+        for (std::size_t i = 0; i + 1 < weights.size(); i++) {
+            cumulative += weights[i];
+            auto const k = std::min(granules,
+                static_cast<std::size_t>(
+                    std::llround(cumulative / total * double(granules))));
+            auto const end = std::max(begin, grid.point(k, view.size()));
+            parts.push_back(view.subview(begin, end - begin));
+            begin = end;
+        }
+        parts.push_back(view.drop_first(begin));
+        return parts;
+    }
+
+    /// Splits a view into the first idx elements and the rest. The behavior
+    /// is undefined if idx is greater than the size of the view.
+    template<typename T>
+    std::pair<array_view<T>, array_view<T>> split_at(
+        array_view<T> view, std::size_t idx)
+    {
+        return {view.first(idx), view.drop_first(idx)};
+    }
+} // namespace ext
+
+#endif // INCLUDED_ARRAY_VIEW_CHUNKS_HPP
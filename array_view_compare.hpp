@@ -0,0 +1,312 @@
+// array_view_compare - Deep comparison and hashing of array_view contents
+//
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ARRAY_VIEW_COMPARE_HPP
+#define INCLUDED_ARRAY_VIEW_COMPARE_HPP
+
+#include <algorithm> // equal, min
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+#include <cstring> // memcmp
+#include <functional> // hash
+#include <type_traits> // enable_if, integral_constant, is_enum, is_integral,
+                       // is_pointer, is_same, remove_cv
+
+#include "array_view.hpp"
+
+namespace ext
+{
+    /// Tells whether two objects of type T are equal if and only if their
+    /// object representations are equal. True for integers, enums and
+    /// pointers. Specialize as true for structs without padding whose
+    /// members are all bitwise comparable.
+    template<typename T>
+    struct is_bitwise_comparable
+        : std::integral_constant<bool,
+              std::is_integral<T>::value || std::is_enum<T>::value
+                  || std::is_pointer<T>::value>
+    {
+    };
+} // namespace ext
+
+namespace array_view_detail
+{
+    template<typename T>
+    using bitwise_comparable =
+        ext::is_bitwise_comparable<typename std::remove_cv<T>::type>;
+
+    // Tests if memcmp orders arrays of T lexicographically.
+    template<typename T>
+    using memcmp_orderable = std::integral_constant<bool,
+        std::is_same<typename std::remove_cv<T>::type, unsigned char>::value
+            || (std::is_same<typename std::remove_cv<T>::type, char>::value
+                && static_cast<char>(-1) > 0)>;
+
+    // XXH64 by Yann Collet. Processes 32-byte stripes in four independent
+    // lanes, which keeps the multipliers of a core busy.
+    namespace xxh64
+    {
+        constexpr std::uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+        constexpr std::uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+        constexpr std::uint64_t prime3 = 0x165667B19E3779F9ULL;
+        constexpr std::uint64_t prime4 = 0x85EBCA77C2B2AE63ULL;
+        constexpr std::uint64_t prime5 = 0x27D4EB2F165667C5ULL;
+
+        inline std::uint64_t rotl(std::uint64_t x, int r) noexcept
+        {
+            return (x << r) | (x >> (64 - r));
+        }
+
+        // Loads little-endian integers regardless of the host byte order.
+        inline std::uint64_t read64(unsigned char const* p) noexcept
+        {
+            std::uint64_t value = 0;
+            for (int i = 7; i >= 0; i--) {
+                value = (value << 8) | p[i];
+            }
+            return value;
+        }
+
+        inline std::uint64_t read32(unsigned char const* p) noexcept
+        {
+            std::uint64_t value = 0;
+            for (int i = 3; i >= 0; i--) {
+                value = (value << 8) | p[i];
+            }
+            return value;
+        }
+
+        inline std::uint64_t round(std::uint64_t acc, std::uint64_t input)
+            noexcept
+        {
+            acc += input * prime2;
+            acc = rotl(acc, 31);
+            return acc * prime1;
+        }
+
+        inline std::uint64_t merge(std::uint64_t acc, std::uint64_t val)
+            noexcept
+        {
+            acc ^= round(0, val);
+            return acc * prime1 + prime4;
+        }
+
+        inline std::uint64_t avalanche(std::uint64_t h) noexcept
+        {
+            h ^= h >> 33;
+            h *= prime2;
+            h ^= h >> 29;
+            h *= prime3;
+            h ^= h >> 32;
+            return h;
+        }
+
+        inline std::uint64_t hash(
+            unsigned char const* p, std::size_t size, std::uint64_t seed)
+            noexcept
+        {
+            auto const end = p + size;
+            std::uint64_t h;
+
+            if (size >= 32) {
+                std::uint64_t v1 = seed + prime1 + prime2;
+                std::uint64_t v2 = seed + prime2;
+                std::uint64_t v3 = seed;
+                std::uint64_t v4 = seed - prime1;
+
+                for (; end - p >= 32; p += 32) {
+                    v1 = round(v1, read64(p));
+                    v2 = round(v2, read64(p + 8));
+                    v3 = round(v3, read64(p + 16));
+                    v4 = round(v4, read64(p + 24));
+                }
+
+                h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+                h = merge(h, v1);
+                h = merge(h, v2);
+                h = merge(h, v3);
+                h = merge(h, v4);
+            } else {
+                h = seed + prime5;
+            }
+
+            h += static_cast<std::uint64_t>(size);
+
+            for (; end - p >= 8; p += 8) {
+                h ^= round(0, read64(p));
+                h = rotl(h, 27) * prime1 + prime4;
+            }
+            if (end - p >= 4) {
+                h ^= read32(p) * prime1;
+                h = rotl(h, 23) * prime2 + prime3;
+                p += 4;
+            }
+            for (; p != end; p++) {
+                h ^= *p * prime5;
+                h = rotl(h, 11) * prime1;
+            }
+            return avalanche(h);
+        }
+    } // namespace xxh64
+
+    template<typename T>
+    bool equal(ext::array_view<T const> lhs, ext::array_view<T const> rhs,
+        std::true_type)
+    {
+        return lhs.empty()
+            || std::memcmp(lhs.data(), rhs.data(), lhs.size() * sizeof(T))
+            == 0;
+    }
+
+    template<typename T>
+    bool equal(ext::array_view<T const> lhs, ext::array_view<T const> rhs,
+        std::false_type)
+    {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template<typename T>
+    int compare(ext::array_view<T const> lhs, ext::array_view<T const> rhs,
+        std::true_type)
+    {
+        auto const common = std::min(lhs.size(), rhs.size());
+        if (common != 0) {
+            if (int const diff =
+                    std::memcmp(lhs.data(), rhs.data(), common)) {
+                return diff < 0 ? -1 : 1;
+            }
+        }
+        return lhs.size() < rhs.size() ? -1 : lhs.size() > rhs.size();
+    }
+
+    template<typename T>
+    int compare(ext::array_view<T const> lhs, ext::array_view<T const> rhs,
+        std::false_type)
+    {
+        auto const common = std::min(lhs.size(), rhs.size());
+        for (std::size_t i = 0; i < common; i++) {
+            if (lhs[i] < rhs[i]) {
+                return -1;
+            }
+            if (rhs[i] < lhs[i]) {
+                return 1;
+            }
+        }
+        return lhs.size() < rhs.size() ? -1 : lhs.size() > rhs.size();
+    }
+
+    template<typename T>
+    std::uint64_t hash(
+        ext::array_view<T const> view, std::uint64_t seed, std::true_type)
+    {
+        return xxh64::hash(reinterpret_cast<unsigned char const*>(view.data()),
+            view.size() * sizeof(T), seed);
+    }
+
+    template<typename T>
+    std::uint64_t hash(
+        ext::array_view<T const> view, std::uint64_t seed, std::false_type)
+    {
+        std::hash<typename std::remove_cv<T>::type> const element_hash;
+        std::uint64_t h = seed + xxh64::prime5 + view.size();
+        for (auto const& elem : view) {
+            h ^= xxh64::round(0, element_hash(elem));
+            h = xxh64::rotl(h, 27) * xxh64::prime1 + xxh64::prime4;
+        }
+        return xxh64::avalanche(h);
+    }
+} // namespace array_view_detail
+
+namespace ext
+{
+    /// Tests if two views have the same size and equal elements. Bitwise
+    /// comparable elements are compared with memcmp.
+    template<typename T, typename U,
+        typename = typename std::enable_if<std::is_same<
+            typename std::remove_cv<T>::type,
+            typename std::remove_cv<U>::type>::value>::type>
+    bool equal(array_view<T> lhs, array_view<U> rhs)
+    {
+        using value_type = typename std::remove_cv<T>::type;
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+        return array_view_detail::equal<value_type>(lhs, rhs,
+            array_view_detail::bitwise_comparable<value_type>{});
+    }
+
+    /// Compares two views lexicographically. Returns a negative value, zero
+    /// or a positive value if lhs is less than, equal to or greater than
+    /// rhs, respectively. Elements are compared with operator<, and arrays
+    /// of unsigned char are compared with memcmp.
+    template<typename T, typename U,
+        typename = typename std::enable_if<std::is_same<
+            typename std::remove_cv<T>::type,
+            typename std::remove_cv<U>::type>::value>::type>
+    int compare(array_view<T> lhs, array_view<U> rhs)
+    {
+        using value_type = typename std::remove_cv<T>::type;
+        return array_view_detail::compare<value_type>(lhs, rhs,
+            array_view_detail::memcmp_orderable<value_type>{});
+    }
+
+    /// Returns a 64-bit hash of the contents of a view. Bitwise comparable
+    /// elements are hashed as bytes with XXH64, so the result for such
+    /// types matches XXH64 of the object representation. Other elements are
+    /// hashed with std::hash and mixed.
+    template<typename T>
+    std::uint64_t hash(array_view<T> view, std::uint64_t seed = 0)
+    {
+        using value_type = typename std::remove_cv<T>::type;
+        return array_view_detail::hash<value_type>(view, seed,
+            array_view_detail::bitwise_comparable<value_type>{});
+    }
+
+    /// Function object comparing view contents, for use as the key
+    /// equality of unordered containers.
+    struct deep_equal
+    {
+        template<typename T, typename U>
+        bool operator()(array_view<T> lhs, array_view<U> rhs) const
+        {
+            return ext::equal(lhs, rhs);
+        }
+    };
+
+    /// Function object hashing view contents, for use as the hasher of
+    /// unordered containers.
+    struct deep_hash
+    {
+        template<typename T>
+        std::size_t operator()(array_view<T> view) const
+        {
+            return static_cast<std::size_t>(ext::hash(view));
+        }
+    };
+} // namespace ext
+
+#endif // INCLUDED_ARRAY_VIEW_COMPARE_HPP
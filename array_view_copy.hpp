@@ -0,0 +1,294 @@
+// array_view_copy - Bulk copy, fill and move between array_views
+//
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ARRAY_VIEW_COPY_HPP
+#define INCLUDED_ARRAY_VIEW_COPY_HPP
+
+#include <algorithm> // copy, fill, min, move
+#include <cstddef> // size_t
+#include <cstdint> // uintptr_t
+#include <cstring> // memcpy, memset
+#include <stdexcept> // invalid_argument
+#include <type_traits> // enable_if, is_same, is_trivially_copyable,
+                       // remove_cv
+
+#include "array_view.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__SSE2__)
+#include <emmintrin.h>
+#define ARRAY_VIEW_STREAM_SSE2 1
+#else
+#define ARRAY_VIEW_STREAM_SSE2 0
+#endif
+
+namespace ext
+{
+    /// How bulk operations write to the destination.
+    enum class store_mode
+    {
+        /// Ordinary stores that go through the cache.
+        cached,
+
+        /// Non-temporal stores that bypass the cache where the CPU supports
+        /// them. Use for destinations larger than the last-level cache that
+        /// will not be read again soon, so that the write does not evict
+        /// data other code is working on.
+        streaming
+    };
+} // namespace ext
+
+namespace array_view_detail
+{
+    template<typename T>
+    using is_memcpyable =
+        std::is_trivially_copyable<typename std::remove_cv<T>::type>;
+
+    inline void check_same_size(std::size_t dest, std::size_t src)
+    {
+        if (dest != src) {
+            throw std::invalid_argument(
+                "destination and source differ in size");
+        }
+    }
+
+    // Tests if all bytes of the object representation of value are equal,
+    // in which case an array of value can be filled with memset.
+    template<typename T>
+    bool is_byte_pattern(T const& value) noexcept
+    {
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        for (std::size_t i = 1; i < sizeof(T); i++) {
+            if (bytes[i] != bytes[0]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+#if ARRAY_VIEW_STREAM_SSE2
+
+    constexpr std::size_t stream_align = 16;
+
+    inline std::size_t misalignment(void const* ptr) noexcept
+    {
+        return reinterpret_cast<std::uintptr_t>(ptr) % stream_align;
+    }
+
+    // Copies size bytes with non-temporal stores. The unaligned head and
+    // the tail are copied with memcpy.
+    inline void stream_copy(
+        unsigned char* dest, unsigned char const* src, std::size_t size)
+        noexcept
+    {
+        if (auto const offset = misalignment(dest)) {
+            auto const head = std::min(stream_align - offset, size);
+            std::memcpy(dest, src, head);
+            dest += head;
+            src += head;
+            size -= head;
+        }
+
+        for (; size >= 64; size -= 64, dest += 64, src += 64) {
+            auto const s = reinterpret_cast<__m128i const*>(src);
+            auto const d = reinterpret_cast<__m128i*>(dest);
+            __m128i const x0 = _mm_loadu_si128(s);
+            __m128i const x1 = _mm_loadu_si128(s + 1);
+            __m128i const x2 = _mm_loadu_si128(s + 2);
+            __m128i const x3 = _mm_loadu_si128(s + 3);
+            _mm_stream_si128(d, x0);
+            _mm_stream_si128(d + 1, x1);
+            _mm_stream_si128(d + 2, x2);
+            _mm_stream_si128(d + 3, x3);
+        }
+        for (; size >= 16; size -= 16, dest += 16, src += 16) {
+            _mm_stream_si128(reinterpret_cast<__m128i*>(dest),
+                _mm_loadu_si128(reinterpret_cast<__m128i const*>(src)));
+        }
+        std::memcpy(dest, src, size);
+
+        // Non-temporal stores are weakly ordered. Make them visible before
+        // any later store, such as one publishing the buffer to a thread.
+        _mm_sfence();
+    }
+
+    // Fills count elements with value using non-temporal stores. Falls back
+    // to std::fill if element boundaries never meet a 16-byte boundary.
+    template<typename T>
+    void stream_fill(T* dest, std::size_t count, T const& value) noexcept
+    {
+        if (stream_align % sizeof(T) != 0
+            || reinterpret_cast<std::uintptr_t>(dest) % sizeof(T) != 0) {
+            std::fill(dest, dest + count, value);
+            return;
+        }
+
+        for (; count > 0 && misalignment(dest) != 0; count--) {
+            *dest++ = value;
+        }
+
+        unsigned char pattern_bytes[stream_align];
+        for (std::size_t i = 0; i < stream_align; i += sizeof(T)) {
+            std::memcpy(pattern_bytes + i, &value, sizeof(T));
+        }
+        __m128i const pattern = _mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(pattern_bytes));
+
+        constexpr std::size_t per_vector = stream_align / sizeof(T);
+        for (; count >= per_vector; count -= per_vector, dest += per_vector) {
+            _mm_stream_si128(reinterpret_cast<__m128i*>(dest), pattern);
+        }
+        std::fill(dest, dest + count, value);
+
+        _mm_sfence();
+    }
+
+#else
+
+    inline void stream_copy(
+        unsigned char* dest, unsigned char const* src, std::size_t size)
+        noexcept
+    {
+        std::memcpy(dest, src, size);
+    }
+
+    template<typename T>
+    void stream_fill(T* dest, std::size_t count, T const& value) noexcept
+    {
+        std::fill(dest, dest + count, value);
+    }
+
+#endif
+
+    template<typename T, typename U>
+    void copy(ext::array_view<T> dest, ext::array_view<U> src,
+        ext::store_mode mode, std::true_type) noexcept
+    {
+        if (dest.empty()) {
+            return;
+        }
+        auto const bytes = dest.size() * sizeof(T);
+        if (mode == ext::store_mode::streaming) {
+            stream_copy(reinterpret_cast<unsigned char*>(dest.data()),
+                reinterpret_cast<unsigned char const*>(src.data()), bytes);
+        } else {
+            std::memcpy(dest.data(), src.data(), bytes);
+        }
+    }
+
+    template<typename T, typename U>
+    void copy(ext::array_view<T> dest, ext::array_view<U> src,
+        ext::store_mode, std::false_type)
+    {
+        std::copy(src.begin(), src.end(), dest.begin());
+    }
+
+    template<typename T>
+    void move(ext::array_view<T> dest, ext::array_view<T> src,
+        ext::store_mode mode, std::true_type) noexcept
+    {
+        copy(dest, src, mode, std::true_type{});
+    }
+
+    template<typename T>
+    void move(ext::array_view<T> dest, ext::array_view<T> src,
+        ext::store_mode, std::false_type)
+    {
+        std::move(src.begin(), src.end(), dest.begin());
+    }
+
+    template<typename T>
+    void fill(ext::array_view<T> dest, T const& value, ext::store_mode mode,
+        std::true_type) noexcept
+    {
+        if (dest.empty()) {
+            return;
+        }
+        if (mode == ext::store_mode::streaming) {
+            stream_fill(dest.data(), dest.size(), value);
+        } else if (is_byte_pattern(value)) {
+            unsigned char byte;
+            std::memcpy(&byte, &value, 1);
+            std::memset(static_cast<void*>(dest.data()), byte,
+                dest.size() * sizeof(T));
+        } else {
+            std::fill(dest.begin(), dest.end(), value);
+        }
+    }
+
+    template<typename T>
+    void fill(ext::array_view<T> dest, T const& value, ext::store_mode,
+        std::false_type)
+    {
+        std::fill(dest.begin(), dest.end(), value);
+    }
+} // namespace array_view_detail
+
+namespace ext
+{
+    /// Copies the elements of src to dest. Trivially copyable elements are
+    /// copied with memcpy, or with non-temporal stores in streaming mode.
+    /// The views must not overlap.
+    ///
+    /// @exception std::invalid_argument if the sizes differ.
+    template<typename T, typename U,
+        typename = typename std::enable_if<std::is_same<T,
+            typename std::remove_cv<U>::type>::value>::type>
+    void copy(array_view<T> dest, array_view<U> src,
+        store_mode mode = store_mode::cached)
+    {
+        array_view_detail::check_same_size(dest.size(), src.size());
+        array_view_detail::copy(
+            dest, src, mode, array_view_detail::is_memcpyable<T>{});
+    }
+
+    /// Assigns value to all elements of dest. Elements whose bytes are all
+    /// equal, such as zeros, are filled with memset in cached mode.
+    template<typename T>
+    void fill(array_view<T> dest,
+        typename std::remove_cv<T>::type const& value,
+        store_mode mode = store_mode::cached)
+    {
+        array_view_detail::fill(
+            dest, value, mode, array_view_detail::is_memcpyable<T>{});
+    }
+
+    /// Move-assigns the elements of src to dest. Same as copy() for
+    /// trivially copyable elements. The views must not overlap.
+    ///
+    /// @exception std::invalid_argument if the sizes differ.
+    template<typename T>
+    void move(array_view<T> dest, array_view<T> src,
+        store_mode mode = store_mode::cached)
+    {
+        array_view_detail::check_same_size(dest.size(), src.size());
+        array_view_detail::move(
+            dest, src, mode, array_view_detail::is_memcpyable<T>{});
+    }
+} // namespace ext
+
+#endif // INCLUDED_ARRAY_VIEW_COPY_HPP
@@ -0,0 +1,505 @@
+// array_view_nd - Multi-dimensional view of contiguous sequence
+//
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ARRAY_VIEW_ND_HPP
+#define INCLUDED_ARRAY_VIEW_ND_HPP
+
+#include <array> // array
+#include <cstddef> // size_t
+#include <stdexcept> // invalid_argument, out_of_range
+#include <type_traits> // conditional, enable_if, is_integral, is_same
+
+#include "array_view.hpp"
+#include "strided_array_view.hpp"
+
+namespace ext
+{
+    /// Layout where the last index varies fastest (C order).
+    struct row_major
+    {
+    };
+
+    /// Layout where the first index varies fastest (Fortran order).
+    struct column_major
+    {
+    };
+
+    /// Layout with arbitrary strides. No axis is guaranteed contiguous.
+    struct strided_layout
+    {
+    };
+
+    template<typename T, std::size_t Rank, typename Layout>
+    class array_view_nd;
+} // namespace ext
+
+namespace array_view_detail
+{
+    // Index of the axis with unit stride, or Rank if there is no such axis.
+    template<typename Layout, std::size_t Rank>
+    struct contiguous_axis
+    {
+        static constexpr std::size_t value = Rank;
+    };
+
+    template<std::size_t Rank>
+    struct contiguous_axis<ext::row_major, Rank>
+    {
+        static constexpr std::size_t value = Rank - 1;
+    };
+
+    template<std::size_t Rank>
+    struct contiguous_axis<ext::column_major, Rank>
+    {
+        static constexpr std::size_t value = 0;
+    };
+
+    // The type of a view with given rank and layout. One-dimensional views
+    // are represented by array_view or strided_array_view.
+    template<typename T, std::size_t Rank, typename Layout>
+    struct nd_view
+    {
+        using type = ext::array_view_nd<T, Rank, Layout>;
+
+        static type make(T* data, std::array<std::size_t, Rank> const& extents,
+            std::array<std::size_t, Rank> const& strides)
+        {
+            return {data, extents, strides};
+        }
+    };
+
+    template<typename T, typename Layout>
+    struct nd_view<T, 1, Layout>
+    {
+        using type = ext::array_view<T>;
+
+        static type make(T* data, std::array<std::size_t, 1> const& extents,
+            std::array<std::size_t, 1> const&)
+        {
+            return {data, extents[0]};
+        }
+    };
+
+    template<typename T>
+    struct nd_view<T, 1, ext::strided_layout>
+    {
+        using type = ext::strided_array_view<T>;
+
+        static type make(T* data, std::array<std::size_t, 1> const& extents,
+            std::array<std::size_t, 1> const& strides)
+        {
+            return {data, extents[0], strides[0] * sizeof(T)};
+        }
+    };
+
+    // The view type obtained by fixing the index of an axis. Fixing the
+    // contiguous axis loses contiguity.
+    template<typename T, std::size_t Rank, typename Layout, std::size_t Axis>
+    using nd_slice = nd_view<T, Rank - 1,
+        typename std::conditional<Axis == contiguous_axis<Layout, Rank>::value,
+            ext::strided_layout, Layout>::type>;
+
+    // Returns the array with the Axis-th element removed.
+    template<std::size_t Axis, std::size_t Rank>
+    std::array<std::size_t, Rank - 1> drop_axis(
+        std::array<std::size_t, Rank> const& values)
+    {
+        std::array<std::size_t, Rank - 1> result;
+        for (std::size_t i = 0, j = 0; i < Rank; i++) {
+            if (i != Axis) {
+                result[j++] = values[i];
+            }
+        }
+        return result;
+    }
+
+    // Computes the strides of a packed or padded layout. leading_dim is the
+    // stride of the second fastest axis (zero means no padding).
+    template<std::size_t Rank>
+    std::array<std::size_t, Rank> compute_strides(ext::row_major,
+        std::array<std::size_t, Rank> const& extents, std::size_t leading_dim)
+    {
+        std::array<std::size_t, Rank> strides;
+        strides[Rank - 1] = 1;
+        for (std::size_t i = Rank - 1; i > 0; i--) {
+            strides[i - 1] = strides[i] * extents[i];
+            if (i == Rank - 1 && leading_dim != 0) {
+                strides[i - 1] = leading_dim;
+            }
+        }
+        return strides;
+    }
+
+    template<std::size_t Rank>
+    std::array<std::size_t, Rank> compute_strides(ext::column_major,
+        std::array<std::size_t, Rank> const& extents, std::size_t leading_dim)
+    {
+        std::array<std::size_t, Rank> strides;
+        strides[0] = 1;
+        for (std::size_t i = 1; i < Rank; i++) {
+            strides[i] = strides[i - 1] * extents[i - 1];
+            if (i == 1 && leading_dim != 0) {
+                strides[i] = leading_dim;
+            }
+        }
+        return strides;
+    }
+
+    // Tests if all the types are integral.
+    template<typename... Ts>
+    struct all_integral : std::true_type
+    {
+    };
+
+    template<typename T, typename... Ts>
+    struct all_integral<T, Ts...>
+        : std::integral_constant<bool,
+              std::is_integral<T>::value && all_integral<Ts...>::value>
+    {
+    };
+
+    // Returns the number of elements spanned by given shape.
+    template<std::size_t Rank>
+    std::size_t required_span(std::array<std::size_t, Rank> const& extents,
+        std::array<std::size_t, Rank> const& strides) noexcept
+    {
+        std::size_t span = 1;
+        for (std::size_t i = 0; i < Rank; i++) {
+            if (extents[i] == 0) {
+                return 0;
+            }
+            span += (extents[i] - 1) * strides[i];
+        }
+        return span;
+    }
+} // namespace array_view_detail
+
+namespace ext
+{
+    /// Lightweight multi-dimensional view of an array.
+    ///
+    /// The view carries extents and strides (in elements) of each axis.
+    /// Layout is a compile-time tag: `row_major` and `column_major` views
+    /// guarantee the last and the first axis to be contiguous, respectively,
+    /// so that slices along that axis are returned as plain `array_view`s.
+    /// The other axes may be padded, e.g. to align rows to cache lines.
+    template<typename T, std::size_t Rank, typename Layout = row_major>
+    class array_view_nd
+    {
+        static_assert(Rank >= 1, "array_view_nd must have at least one axis");
+
+      public:
+        /// The non-qualified type of the elements.
+        using value_type = typename std::remove_cv<T>::type;
+
+        /// The type of a pointer to an element.
+        using pointer = T*;
+
+        /// The type of a reference to an element.
+        using reference = T&;
+
+        /// The type of size and index values.
+        using size_type = std::size_t;
+
+        /// The type of the per-axis extents and strides.
+        using index_array = std::array<size_type, Rank>;
+
+        /// The layout tag.
+        using layout_type = Layout;
+
+        /// The type of read-only array_view_nd with the same value_type.
+        using const_array_view = array_view_nd<T const, Rank, Layout>;
+
+        /// The number of axes.
+        static constexpr size_type rank = Rank;
+
+        /// The default constructor creates an empty view.
+        array_view_nd() noexcept
+            : data_{nullptr}
+            , extents_{}
+            , strides_{}
+        {
+        }
+
+        /// This constructor creates a view with given extents and strides.
+        /// Strides are measured in elements and must be consistent with the
+        /// layout; use `make_array_view_nd` for validated construction.
+        array_view_nd(pointer data, index_array const& extents,
+            index_array const& strides) noexcept
+            : data_{data}
+            , extents_(extents)
+            , strides_(strides)
+        {
+        }
+
+        /// Tests if the view is empty.
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        /// Returns the total number of elements.
+        size_type size() const noexcept
+        {
+            size_type size = 1;
+            for (auto const extent : extents_) {
+                size *= extent;
+            }
+            return size;
+        }
+
+        /// Returns the extent of given axis.
+        size_type extent(size_type axis) const noexcept
+        {
+            return extents_[axis];
+        }
+
+        /// Returns the stride of given axis in elements.
+        size_type stride(size_type axis) const noexcept
+        {
+            return strides_[axis];
+        }
+
+        /// Returns the extents of all axes.
+        index_array const& extents() const noexcept
+        {
+            return extents_;
+        }
+
+        /// Returns the strides of all axes in elements.
+        index_array const& strides() const noexcept
+        {
+            return strides_;
+        }
+
+        /// Returns the distance in elements between the consecutive lines of
+        /// the contiguous axis. This is larger than the extent of the
+        /// contiguous axis if the view is padded.
+        size_type leading_dimension() const noexcept
+        {
+            return Rank == 1 ? extents_[0] : strides_[leading_axis()];
+        }
+
+        /// Tests if the elements are packed with no padding.
+        bool is_contiguous() const noexcept
+        {
+            return array_view_detail::required_span(extents_, strides_)
+                == size();
+        }
+
+        /// Returns a pointer to the first element.
+        pointer data() const noexcept
+        {
+            return data_;
+        }
+
+        /// Returns a flat view of the whole memory region spanned by the
+        /// view, including padding.
+        array_view<T> span() const noexcept
+        {
+            return {data(), array_view_detail::required_span(
+                                extents_, strides_)};
+        }
+
+        /// Returns a reference to the element at given indices. The behavior
+        /// is undefined if any index is out of bounds.
+        template<typename... Indices>
+        reference operator()(Indices... indices) const
+        {
+            static_assert(sizeof...(Indices) == Rank,
+                "number of indices must match the rank");
+            return data()[offset({{static_cast<size_type>(indices)...}})];
+        }
+
+        /// Returns a reference to the element at given indices.
+        ///
+        /// @exception std::out_of_range if any index is out of bounds.
+        template<typename... Indices>
+        reference at(Indices... indices) const
+        {
+            static_assert(sizeof...(Indices) == Rank,
+                "number of indices must match the rank");
+            index_array const idx = {{static_cast<size_type>(indices)...}};
+            for (size_type i = 0; i < Rank; i++) {
+                if (idx[i] >= extents_[i]) {
+                    throw std::out_of_range(
+                        "array_view_nd access out-of-bounds");
+                }
+            }
+            return data()[offset(idx)];
+        }
+
+        /// Returns a read-only view of the same array.
+        const_array_view as_const() const noexcept
+        {
+            return {data(), extents_, strides_};
+        }
+
+        /// A view is always implicitly convertible to a read-only view.
+        operator const_array_view() const noexcept
+        {
+            return as_const();
+        }
+
+        /// Swaps the viewed array.
+        void swap(array_view_nd& other) noexcept
+        {
+            auto const this_copy = *this;
+            *this = other;
+            other = this_copy;
+        }
+
+        /// Returns a view of the box region [offsets, offsets + counts).
+        array_view_nd subview(
+            index_array const& offsets, index_array const& counts) const
+        {
+            return {data() + offset(offsets), counts, strides_};
+        }
+
+        /// Returns a view of lower rank with the index of given axis fixed.
+        /// The result is an `array_view` if it is contiguous, a
+        /// `strided_array_view` if it is one-dimensional and not contiguous,
+        /// and an `array_view_nd` otherwise.
+        template<size_type Axis>
+        typename array_view_detail::nd_slice<T, Rank, Layout, Axis>::type
+        slice(size_type idx) const
+        {
+            static_assert(Rank >= 2, "cannot slice one-dimensional view");
+            static_assert(Axis < Rank, "axis out of range");
+            return array_view_detail::nd_slice<T, Rank, Layout, Axis>::make(
+                data() + idx * strides_[Axis],
+                array_view_detail::drop_axis<Axis>(extents_),
+                array_view_detail::drop_axis<Axis>(strides_));
+        }
+
+        /// Returns a view of the i-th row of a matrix.
+        typename array_view_detail::nd_slice<T, Rank, Layout, 0>::type
+        row(size_type i) const
+        {
+            static_assert(Rank == 2, "row() is only defined for matrices");
+            return slice<0>(i);
+        }
+
+        /// Returns a view of the j-th column of a matrix.
+        typename array_view_detail::nd_slice<T, Rank, Layout, 1>::type
+        col(size_type j) const
+        {
+            static_assert(Rank == 2, "col() is only defined for matrices");
+            return slice<1>(j);
+        }
+
+      private:
+        static constexpr size_type leading_axis() noexcept
+        {
+            return std::is_same<Layout, column_major>::value ? 1 : Rank - 2;
+        }
+
+        size_type offset(index_array const& idx) const noexcept
+        {
+            size_type off = 0;
+            for (size_type i = 0; i < Rank; i++) {
+                off += idx[i] * strides_[i];
+            }
+            return off;
+        }
+
+        pointer data_;
+        index_array extents_;
+        index_array strides_;
+    };
+
+    template<typename T, std::size_t Rank, typename Layout>
+    constexpr std::size_t array_view_nd<T, Rank, Layout>::rank;
+
+    /// Returns the smallest leading dimension not less than extent such that
+    /// each line of elements of type T starts at a multiple of alignment
+    /// bytes, provided that the first line is aligned.
+    template<typename T>
+    std::size_t aligned_leading_dimension(
+        std::size_t extent, std::size_t alignment)
+    {
+        if (alignment % sizeof(T) != 0) {
+            throw std::invalid_argument(
+                "alignment is not a multiple of element size");
+        }
+        auto const unit = alignment / sizeof(T);
+        return (extent + unit - 1) / unit * unit;
+    }
+
+    /// Creates a multi-dimensional view of a flat array.
+    ///
+    /// @param view         The flat array to view.
+    /// @param extents      The extent of each axis.
+    /// @param leading_dim  The distance in elements between consecutive lines
+    ///                     of the contiguous axis. Zero means no padding.
+    ///
+    /// @exception std::invalid_argument if leading_dim is smaller than the
+    ///            extent of the contiguous axis or the shape does not fit in
+    ///            the flat array.
+    template<typename Layout = row_major, typename T, std::size_t Rank>
+    array_view_nd<T, Rank, Layout> make_array_view_nd(array_view<T> view,
+        std::array<std::size_t, Rank> const& extents,
+        std::size_t leading_dim = 0)
+    {
+        static_assert(std::is_same<Layout, row_major>::value
+                || std::is_same<Layout, column_major>::value,
+            "layout must be row_major or column_major");
+
+        auto const axis = array_view_detail::contiguous_axis<Layout, Rank>::value;
+        if (leading_dim != 0 && leading_dim < extents[axis]) {
+            throw std::invalid_argument(
+                "leading dimension is smaller than the extent");
+        }
+
+        auto const strides =
+            array_view_detail::compute_strides(Layout{}, extents, leading_dim);
+        if (array_view_detail::required_span(extents, strides) > view.size()) {
+            throw std::invalid_argument("shape exceeds the viewed array");
+        }
+        return {view.data(), extents, strides};
+    }
+
+    /// Creates a packed multi-dimensional view of a flat array.
+    ///
+    /// @code
+    /// std::vector<double> buffer(3 * 4);
+    /// auto mat = ext::make_array_view_nd(ext::make_array_view(buffer), 3, 4);
+    /// mat(2, 3) = 1.0;
+    /// @endcode
+    template<typename Layout = row_major, typename T, typename... Extents,
+        typename = typename std::enable_if<
+            array_view_detail::all_integral<Extents...>::value>::type>
+    array_view_nd<T, sizeof...(Extents), Layout> make_array_view_nd(
+        array_view<T> view, Extents... extents)
+    {
+        return make_array_view_nd<Layout>(view,
+            std::array<std::size_t, sizeof...(Extents)>{
+                {static_cast<std::size_t>(extents)...}});
+    }
+} // namespace ext
+
+#endif // INCLUDED_ARRAY_VIEW_ND_HPP
@@ -0,0 +1,403 @@
+// array_view_parallel - Parallel algorithms over array_view
+//
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ARRAY_VIEW_PARALLEL_HPP
+#define INCLUDED_ARRAY_VIEW_PARALLEL_HPP
+
+#include <algorithm> // max, min, sort
+#include <atomic> // atomic
+#include <chrono> // milliseconds
+#include <condition_variable> // condition_variable
+#include <cstddef> // size_t
+#include <deque> // deque
+#include <exception> // exception_ptr, current_exception, rethrow_exception
+#include <memory> // unique_ptr
+#include <mutex> // mutex, lock_guard, unique_lock
+#include <stdexcept> // invalid_argument
+#include <thread> // thread, hardware_concurrency
+#include <utility> // move
+#include <vector> // vector
+
+#include "array_view.hpp"
+
+namespace array_view_detail
+{
+    // A batch of chunks submitted by one call of a parallel algorithm.
+    struct parallel_job
+    {
+        void (*invoke)(void*, std::size_t) = nullptr;
+        void* context = nullptr;
+        std::atomic<std::size_t> remaining{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable done;
+        bool finished = false;
+
+        // Runs a chunk, recording the first exception thrown.
+        void run(std::size_t chunk) noexcept
+        {
+            if (!failed.load(std::memory_order_relaxed)) {
+                try {
+                    invoke(context, chunk);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock{mutex};
+                    if (!failed.exchange(true)) {
+                        error = std::current_exception();
+                    }
+                }
+            }
+            // The submitter may destroy the job as soon as it observes the
+            // flag, so the flag is the last thing touched here.
+            if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock{mutex};
+                finished = true;
+                done.notify_all();
+            }
+        }
+    };
+
+    // A range of chunks [begin, end) of a job. Workers split large ranges
+    // in halves and leave the upper halves to be stolen.
+    struct parallel_task
+    {
+        parallel_job* job;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    template<typename F>
+    void invoke_chunk(void* context, std::size_t chunk)
+    {
+        (*static_cast<F*>(context))(chunk);
+    }
+} // namespace array_view_detail
+
+namespace ext
+{
+    /// Persistent pool of worker threads with work stealing.
+    ///
+    /// Every worker owns a task deque. A worker splits the task it runs in
+    /// halves, pushing the upper halves to the back of its own deque, and
+    /// steals from the front of the other deques when its own one is empty.
+    /// Threads calling `parallel_for` also run tasks until the call
+    /// completes, so a pool with zero workers runs everything on the calling
+    /// thread.
+    class thread_pool
+    {
+      public:
+        /// Creates a pool with given number of worker threads.
+        explicit thread_pool(std::size_t workers)
+        {
+            // The last queue receives tasks from non-worker threads.
+            for (std::size_t i = 0; i <= workers; i++) {
+                queues_.emplace_back(new task_queue);
+            }
+            for (std::size_t i = 0; i < workers; i++) {
+                threads_.emplace_back([this, i] { work(i); });
+            }
+        }
+
+        /// Stops and joins all worker threads.
+        ~thread_pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock{sleep_mutex_};
+                stopping_ = true;
+            }
+            wake_.notify_all();
+            for (auto& thread : threads_) {
+                thread.join();
+            }
+        }
+
+        thread_pool(thread_pool const&) = delete;
+        thread_pool& operator=(thread_pool const&) = delete;
+
+        /// Returns the number of worker threads.
+        std::size_t size() const noexcept
+        {
+            return threads_.size();
+        }
+
+        /// Returns the number of threads that run tasks of a call of
+        /// `parallel_for`, including the calling thread.
+        std::size_t concurrency() const noexcept
+        {
+            return size() + 1;
+        }
+
+        /// Calls fn(i) for each i in [0, count) in parallel and waits for
+        /// completion. If any call throws, the first exception is rethrown
+        /// after all the calls have finished or been skipped.
+        template<typename F>
+        void parallel_for(std::size_t count, F fn)
+        {
+            if (count == 0) {
+                return;
+            }
+
+            array_view_detail::parallel_job job;
+            job.invoke = &array_view_detail::invoke_chunk<F>;
+            job.context = &fn;
+            job.remaining = count;
+
+            auto const home = current_queue();
+            push(home, {&job, 0, count});
+
+            // Help running tasks, including the ones of other jobs, until
+            // this job finishes.
+            for (;;) {
+                array_view_detail::parallel_task task;
+                if (pop(home, task)) {
+                    execute(home, task);
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock{job.mutex};
+                if (job.done.wait_for(lock, std::chrono::milliseconds(1),
+                        [&] { return job.finished; })) {
+                    break;
+                }
+            }
+
+            if (job.error) {
+                std::rethrow_exception(job.error);
+            }
+        }
+
+      private:
+        struct task_queue
+        {
+            std::mutex mutex;
+            std::deque<array_view_detail::parallel_task> tasks;
+        };
+
+        // Returns the queue index of the calling thread.
+        std::size_t current_queue() const noexcept
+        {
+            auto const id = std::this_thread::get_id();
+            for (std::size_t i = 0; i < threads_.size(); i++) {
+                if (threads_[i].get_id() == id) {
+                    return i;
+                }
+            }
+            return threads_.size();
+        }
+
+        void push(std::size_t queue, array_view_detail::parallel_task task)
+        {
+            {
+                std::lock_guard<std::mutex> lock{queues_[queue]->mutex};
+                queues_[queue]->tasks.push_back(task);
+            }
+            pending_.fetch_add(1, std::memory_order_release);
+            {
+                std::lock_guard<std::mutex> lock{sleep_mutex_};
+            }
+            wake_.notify_one();
+        }
+
+        // Takes the newest task of the own queue, or steals the oldest task
+        // of another queue.
+        bool pop(std::size_t home, array_view_detail::parallel_task& task)
+        {
+            if (pending_.load(std::memory_order_acquire) == 0) {
+                return false;
+            }
+            {
+                auto& own = *queues_[home];
+                std::lock_guard<std::mutex> lock{own.mutex};
+                if (!own.tasks.empty()) {
+                    task = own.tasks.back();
+                    own.tasks.pop_back();
+                    pending_.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            for (std::size_t i = 1; i < queues_.size(); i++) {
+                auto& victim = *queues_[(home + i) % queues_.size()];
+                std::lock_guard<std::mutex> lock{victim.mutex};
+                if (!victim.tasks.empty()) {
+                    task = victim.tasks.front();
+                    victim.tasks.pop_front();
+                    pending_.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void execute(std::size_t home, array_view_detail::parallel_task task)
+        {
+            while (task.end - task.begin > 1) {
+                auto const mid = task.begin + (task.end - task.begin) / 2;
+                push(home, {task.job, mid, task.end});
+                task.end = mid;
+            }
+            task.job->run(task.begin);
+        }
+
+        void work(std::size_t home)
+        {
+            for (;;) {
+                array_view_detail::parallel_task task;
+                if (pop(home, task)) {
+                    execute(home, task);
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock{sleep_mutex_};
+                wake_.wait(lock, [this] {
+                    return stopping_ || pending_.load() != 0;
+                });
+                if (stopping_) {
+                    return;
+                }
+            }
+        }
+
+        std::vector<std::unique_ptr<task_queue>> queues_;
+        std::vector<std::thread> threads_;
+        std::atomic<std::size_t> pending_{0};
+        std::mutex sleep_mutex_;
+        std::condition_variable wake_;
+        bool stopping_ = false;
+    };
+
+    /// Returns the process-wide pool. It has one worker less than the
+    /// hardware concurrency since the calling thread also runs tasks.
+    inline thread_pool& default_thread_pool()
+    {
+        static thread_pool pool{
+            std::max(std::thread::hardware_concurrency(), 1u) - 1};
+        return pool;
+    }
+
+    /// Options of the parallel algorithms.
+    struct parallel_options
+    {
+        /// The number of elements processed by a task. Zero chooses a grain
+        /// that gives each thread several tasks.
+        std::size_t grain_size = 0;
+
+        /// The pool to run tasks on. Null means the default pool.
+        thread_pool* pool = nullptr;
+    };
+
+    /// Calls fn(chunk) in parallel for each chunk of a view. The chunks are
+    /// subviews of at most grain_size elements covering the whole view.
+    template<typename T, typename F>
+    void parallel_for_chunks(
+        array_view<T> view, F fn, parallel_options const& options = {})
+    {
+        auto& pool = options.pool ? *options.pool : default_thread_pool();
+        auto grain = options.grain_size;
+        if (grain == 0) {
+            auto const tasks = 8 * pool.concurrency();
+            grain = std::max<std::size_t>((view.size() + tasks - 1) / tasks, 1);
+        }
+        auto const chunks = (view.size() + grain - 1) / grain;
+
+        pool.parallel_for(chunks, [&](std::size_t chunk) {
+            auto const offset = chunk * grain;
+            fn(view.subview(offset, std::min(grain, view.size() - offset)));
+        });
+    }
+
+    /// Calls fn(element) in parallel for each element of a view.
+    template<typename T, typename F>
+    void parallel_for_each(
+        array_view<T> view, F fn, parallel_options const& options = {})
+    {
+        parallel_for_chunks(view, [&](array_view<T> chunk) {
+            for (auto& elem : chunk) {
+                fn(elem);
+            }
+        }, options);
+    }
+
+    /// Stores fn(input[i]) to output[i] in parallel.
+    ///
+    /// @exception std::invalid_argument if the sizes of the views differ.
+    template<typename T, typename U, typename F>
+    void parallel_transform(array_view<T> input, array_view<U> output, F fn,
+        parallel_options const& options = {})
+    {
+        if (input.size() != output.size()) {
+            throw std::invalid_argument("array_view sizes differ");
+        }
+        auto const base = input.data();
+        parallel_for_chunks(input, [&](array_view<T> chunk) {
+            auto const offset = static_cast<std::size_t>(chunk.data() - base);
+            auto const out = output.subview(offset, chunk.size());
+            for (std::size_t i = 0; i < chunk.size(); i++) {
+                out[i] = fn(chunk[i]);
+            }
+        }, options);
+    }
+
+    /// Reduces the elements of a view with an associative operation in
+    /// parallel. Each chunk is folded left to right and the partial results
+    /// are then folded into init in the order of the chunks, so the result
+    /// is deterministic for a given grain size.
+    ///
+    /// @param op   Binary operation callable as op(R, T) and op(R, R) where
+    ///             R is the type of init.
+    template<typename T, typename R, typename Op>
+    R parallel_reduce(array_view<T> view, R init, Op op,
+        parallel_options const& options = {})
+    {
+        struct partial
+        {
+            std::size_t offset;
+            R value;
+        };
+        std::vector<partial> results;
+        std::mutex results_mutex;
+        auto const base = view.data();
+
+        parallel_for_chunks(view, [&](array_view<T> chunk) {
+            R value = chunk.front();
+            for (std::size_t i = 1; i < chunk.size(); i++) {
+                value = op(std::move(value), chunk[i]);
+            }
+            auto const offset = static_cast<std::size_t>(chunk.data() - base);
+            std::lock_guard<std::mutex> lock{results_mutex};
+            results.push_back({offset, std::move(value)});
+        }, options);
+
+        std::sort(results.begin(), results.end(),
+            [](partial const& lhs, partial const& rhs) {
+                return lhs.offset < rhs.offset;
+            });
+        for (auto& result : results) {
+            init = op(std::move(init), std::move(result.value));
+        }
+        return init;
+    }
+} // namespace ext
+
+#endif // INCLUDED_ARRAY_VIEW_PARALLEL_HPP
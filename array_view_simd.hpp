@@ -0,0 +1,635 @@
+// array_view_simd - Vectorized reduction and search over array_view
+//
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ARRAY_VIEW_SIMD_HPP
+#define INCLUDED_ARRAY_VIEW_SIMD_HPP
+
+#include <algorithm> // min
+#include <cstddef> // size_t
+#include <cstdint> // int32_t, int64_t
+#include <cstring> // memcpy
+#include <stdexcept> // invalid_argument, out_of_range
+#include <type_traits> // conditional, integral_constant, make_unsigned, ...
+#include <utility> // declval
+
+#include "array_view.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) \
+    && (defined(__x86_64__) || defined(__i386__))
+#define ARRAY_VIEW_SIMD_X86 1
+#else
+#define ARRAY_VIEW_SIMD_X86 0
+#endif
+
+namespace ext
+{
+    namespace simd
+    {
+        /// Instruction set levels used by the algorithms in this namespace.
+        enum class isa
+        {
+            scalar,
+            sse2,
+            avx2,
+            avx512
+        };
+
+        /// Returns the best instruction set supported by the running CPU.
+        inline isa detect_isa() noexcept
+        {
+#if ARRAY_VIEW_SIMD_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) {
+                return isa::avx512;
+            }
+            if (__builtin_cpu_supports("avx2")) {
+                return isa::avx2;
+            }
+            if (__builtin_cpu_supports("sse2")) {
+                return isa::sse2;
+            }
+#endif
+            return isa::scalar;
+        }
+
+        /// Returns the best instruction set supported by the running CPU.
+        /// The CPU is queried only once.
+        inline isa best_isa() noexcept
+        {
+            static isa const level = detect_isa();
+            return level;
+        }
+    } // namespace simd
+} // namespace ext
+
+namespace array_view_detail
+{
+    namespace simd
+    {
+        using ext::simd::isa;
+
+        // Kernels operate on at most this many elements at a time so that
+        // per-lane counters and indices do not overflow.
+        constexpr std::size_t max_chunk = std::size_t(1) << 30;
+
+        // Integers are accumulated in unsigned arithmetic so that overflow
+        // wraps around instead of being undefined.
+        template<typename T>
+        using accumulator_t =
+            typename std::conditional<std::is_integral<T>::value,
+                std::make_unsigned<T>, std::common_type<T>>::type::type;
+
+        // Tests if vector kernels are available for T.
+        template<typename T>
+        struct is_vectorizable
+            : std::integral_constant<bool,
+                  ARRAY_VIEW_SIMD_X86 && std::is_arithmetic<T>::value
+                      && !std::is_same<T, bool>::value
+                      && !std::is_same<T, long double>::value
+                      && (sizeof(T) == 4 || sizeof(T) == 8)>
+        {
+        };
+
+        // Reference implementation used for non-vectorizable types, for
+        // the tails of vector kernels and as the fallback.
+        struct scalar_kernels
+        {
+            template<typename T>
+            static T sum(T const* data, std::size_t size)
+            {
+                accumulator_t<T> total = 0;
+                for (std::size_t i = 0; i < size; i++) {
+                    total = static_cast<accumulator_t<T>>(
+                        total + static_cast<accumulator_t<T>>(data[i]));
+                }
+                return static_cast<T>(total);
+            }
+
+            template<typename T>
+            static T dot(T const* lhs, T const* rhs, std::size_t size)
+            {
+                using acc = accumulator_t<T>;
+                acc total = 0;
+                for (std::size_t i = 0; i < size; i++) {
+                    total = static_cast<acc>(total
+                        + static_cast<acc>(static_cast<acc>(lhs[i])
+                            * static_cast<acc>(rhs[i])));
+                }
+                return static_cast<T>(total);
+            }
+
+            template<bool Max, typename T>
+            static std::size_t arg_extremum(T const* data, std::size_t size)
+            {
+                std::size_t best = 0;
+                for (std::size_t i = 1; i < size; i++) {
+                    if (Max ? data[best] < data[i] : data[i] < data[best]) {
+                        best = i;
+                    }
+                }
+                return best;
+            }
+
+            template<typename T>
+            static std::size_t count(
+                T const* data, std::size_t size, T const& value)
+            {
+                std::size_t total = 0;
+                for (std::size_t i = 0; i < size; i++) {
+                    total += data[i] == value ? 1 : 0;
+                }
+                return total;
+            }
+
+            template<typename T>
+            static std::size_t find(
+                T const* data, std::size_t size, T const& value)
+            {
+                for (std::size_t i = 0; i < size; i++) {
+                    if (data[i] == value) {
+                        return i;
+                    }
+                }
+                return size;
+            }
+        };
+
+#if ARRAY_VIEW_SIMD_X86
+
+#define ARRAY_VIEW_SIMD_INLINE inline __attribute__((always_inline))
+
+        // Kernels written with GCC vector extensions. These are always
+        // inlined into the ISA-specific entry points below, where the target
+        // attribute selects the actual instruction set.
+        template<typename T, std::size_t Width>
+        struct vector_kernels
+        {
+            using acc = accumulator_t<T>;
+            typedef T vec __attribute__((vector_size(Width * sizeof(T))));
+            typedef acc acc_vec
+                __attribute__((vector_size(Width * sizeof(T))));
+            using mask = typename std::conditional<sizeof(T) == 4,
+                std::int32_t, std::int64_t>::type;
+            typedef mask mask_vec
+                __attribute__((vector_size(Width * sizeof(T))));
+
+            ARRAY_VIEW_SIMD_INLINE static T sum(
+                T const* data, std::size_t size)
+            {
+                acc_vec total0 = {};
+                acc_vec total1 = {};
+                std::size_t i = 0;
+                for (; i + 2 * Width <= size; i += 2 * Width) {
+                    vec x0, x1;
+                    std::memcpy(&x0, data + i, sizeof x0);
+                    std::memcpy(&x1, data + i + Width, sizeof x1);
+                    total0 += (acc_vec) x0;
+                    total1 += (acc_vec) x1;
+                }
+                total0 += total1;
+
+                acc total = 0;
+                for (std::size_t k = 0; k < Width; k++) {
+                    total = static_cast<acc>(total + total0[k]);
+                }
+                return static_cast<T>(static_cast<acc>(total
+                    + static_cast<acc>(
+                        scalar_kernels::sum(data + i, size - i))));
+            }
+
+            ARRAY_VIEW_SIMD_INLINE static T dot(
+                T const* lhs, T const* rhs, std::size_t size)
+            {
+                acc_vec total0 = {};
+                acc_vec total1 = {};
+                std::size_t i = 0;
+                for (; i + 2 * Width <= size; i += 2 * Width) {
+                    vec x0, x1, y0, y1;
+                    std::memcpy(&x0, lhs + i, sizeof x0);
+                    std::memcpy(&x1, lhs + i + Width, sizeof x1);
+                    std::memcpy(&y0, rhs + i, sizeof y0);
+                    std::memcpy(&y1, rhs + i + Width, sizeof y1);
+                    total0 += (acc_vec) x0 * (acc_vec) y0;
+                    total1 += (acc_vec) x1 * (acc_vec) y1;
+                }
+                total0 += total1;
+
+                acc total = 0;
+                for (std::size_t k = 0; k < Width; k++) {
+                    total = static_cast<acc>(total + total0[k]);
+                }
+                return static_cast<T>(static_cast<acc>(total
+                    + static_cast<acc>(
+                        scalar_kernels::dot(lhs + i, rhs + i, size - i))));
+            }
+
+            // Each lane tracks its own extremum and the index at which it
+            // was found. Strict comparison keeps the first occurrence.
+            template<bool Max>
+            ARRAY_VIEW_SIMD_INLINE static std::size_t arg_extremum(
+                T const* data, std::size_t size)
+            {
+                if (size < Width) {
+                    return scalar_kernels::arg_extremum<Max>(data, size);
+                }
+
+                vec best;
+                std::memcpy(&best, data, sizeof best);
+                mask_vec index = {};
+                for (std::size_t k = 0; k < Width; k++) {
+                    index[k] = static_cast<mask>(k);
+                }
+                mask_vec best_index = index;
+
+                std::size_t i = Width;
+                for (; i + Width <= size; i += Width) {
+                    vec x;
+                    std::memcpy(&x, data + i, sizeof x);
+                    index += static_cast<mask>(Width);
+                    mask_vec const better =
+                        (mask_vec)(Max ? best < x : x < best);
+                    best = better ? x : best;
+                    best_index = better ? index : best_index;
+                }
+
+                T value = best[0];
+                auto result = static_cast<std::size_t>(best_index[0]);
+                for (std::size_t k = 1; k < Width; k++) {
+                    T const candidate = best[k];
+                    auto const at = static_cast<std::size_t>(best_index[k]);
+                    bool const better =
+                        Max ? value < candidate : candidate < value;
+                    if (better || (candidate == value && at < result)) {
+                        value = candidate;
+                        result = at;
+                    }
+                }
+                for (; i < size; i++) {
+                    if (Max ? value < data[i] : data[i] < value) {
+                        value = data[i];
+                        result = i;
+                    }
+                }
+                return result;
+            }
+
+            ARRAY_VIEW_SIMD_INLINE static std::size_t count(
+                T const* data, std::size_t size, T const& value)
+            {
+                vec const target = vec{} + value;
+                mask_vec total = {};
+                std::size_t i = 0;
+                for (; i + Width <= size; i += Width) {
+                    vec x;
+                    std::memcpy(&x, data + i, sizeof x);
+                    total -= (mask_vec)(x == target);
+                }
+
+                std::size_t result = 0;
+                for (std::size_t k = 0; k < Width; k++) {
+                    result += static_cast<std::size_t>(total[k]);
+                }
+                return result
+                    + scalar_kernels::count(data + i, size - i, value);
+            }
+
+            // Scans blocks of four vectors without branching and falls back
+            // to the scalar loop in the block containing the match.
+            ARRAY_VIEW_SIMD_INLINE static std::size_t find(
+                T const* data, std::size_t size, T const& value)
+            {
+                vec const target = vec{} + value;
+                std::size_t i = 0;
+                for (; i + 4 * Width <= size; i += 4 * Width) {
+                    vec x0, x1, x2, x3;
+                    std::memcpy(&x0, data + i, sizeof x0);
+                    std::memcpy(&x1, data + i + Width, sizeof x1);
+                    std::memcpy(&x2, data + i + 2 * Width, sizeof x2);
+                    std::memcpy(&x3, data + i + 3 * Width, sizeof x3);
+                    mask_vec const hits = (mask_vec)((x0 == target)
+                        | (x1 == target) | (x2 == target) | (x3 == target));
+
+                    mask any = 0;
+                    for (std::size_t k = 0; k < Width; k++) {
+                        any |= hits[k];
+                    }
+                    if (any != 0) {
+                        break;
+                    }
+                }
+                return i + scalar_kernels::find(data + i, size - i, value);
+            }
+        };
+
+        // Defines an entry point struct compiled for an instruction set.
+#define ARRAY_VIEW_SIMD_DEFINE_ISA(NAME, TARGET, BYTES)                      \
+    struct NAME                                                              \
+    {                                                                        \
+        template<typename T>                                                 \
+        using kernels = vector_kernels<T, BYTES / sizeof(T)>;                \
+                                                                             \
+        template<typename T>                                                 \
+        __attribute__((target(TARGET))) static T sum(                        \
+            T const* data, std::size_t size)                                 \
+        {                                                                    \
+            return kernels<T>::sum(data, size);                              \
+        }                                                                    \
+                                                                             \
+        template<typename T>                                                 \
+        __attribute__((target(TARGET))) static T dot(                        \
+            T const* lhs, T const* rhs, std::size_t size)                    \
+        {                                                                    \
+            return kernels<T>::dot(lhs, rhs, size);                          \
+        }                                                                    \
+                                                                             \
+        template<bool Max, typename T>                                       \
+        __attribute__((target(TARGET))) static std::size_t arg_extremum(     \
+            T const* data, std::size_t size)                                 \
+        {                                                                    \
+            return kernels<T>::template arg_extremum<Max>(data, size);       \
+        }                                                                    \
+                                                                             \
+        template<typename T>                                                 \
+        __attribute__((target(TARGET))) static std::size_t count(            \
+            T const* data, std::size_t size, T const& value)                 \
+        {                                                                    \
+            return kernels<T>::count(data, size, value);                     \
+        }                                                                    \
+                                                                             \
+        template<typename T>                                                 \
+        __attribute__((target(TARGET))) static std::size_t find(             \
+            T const* data, std::size_t size, T const& value)                 \
+        {                                                                    \
+            return kernels<T>::find(data, size, value);                      \
+        }                                                                    \
+    };
+
+        ARRAY_VIEW_SIMD_DEFINE_ISA(sse2_kernels, "sse2", 16)
+        ARRAY_VIEW_SIMD_DEFINE_ISA(avx2_kernels, "avx2", 32)
+        ARRAY_VIEW_SIMD_DEFINE_ISA(avx512_kernels, "avx512f", 64)
+
+#undef ARRAY_VIEW_SIMD_DEFINE_ISA
+#undef ARRAY_VIEW_SIMD_INLINE
+
+        // Calls Op with the kernels of the best usable instruction set.
+        template<typename Op, typename... Args>
+        auto dispatch(std::true_type, isa level, Args const&... args)
+            -> decltype(Op::template run<scalar_kernels>(args...))
+        {
+            auto const best = ext::simd::best_isa();
+            switch (level < best ? level : best) {
+            case isa::avx512:
+                return Op::template run<avx512_kernels>(args...);
+            case isa::avx2:
+                return Op::template run<avx2_kernels>(args...);
+            case isa::sse2:
+                return Op::template run<sse2_kernels>(args...);
+            case isa::scalar:
+                break;
+            }
+            return Op::template run<scalar_kernels>(args...);
+        }
+
+#endif // ARRAY_VIEW_SIMD_X86
+
+        template<typename Op, typename... Args>
+        auto dispatch(std::false_type, isa, Args const&... args)
+            -> decltype(Op::template run<scalar_kernels>(args...))
+        {
+            return Op::template run<scalar_kernels>(args...);
+        }
+
+        // Calls Op with the best kernels available for T.
+        template<typename Op, typename T, typename... Args>
+        auto dispatch(isa level, T const* data, Args const&... args)
+            -> decltype(Op::template run<scalar_kernels>(data, args...))
+        {
+            return dispatch<Op>(is_vectorizable<T>{}, level, data, args...);
+        }
+
+        struct sum_op
+        {
+            template<typename K, typename T>
+            static T run(T const* data, std::size_t const& size)
+            {
+                return K::sum(data, size);
+            }
+        };
+
+        struct dot_op
+        {
+            template<typename K, typename T>
+            static T run(T const* lhs, T const* rhs, std::size_t const& size)
+            {
+                return K::dot(lhs, rhs, size);
+            }
+        };
+
+        template<bool Max>
+        struct arg_extremum_op
+        {
+            template<typename K, typename T>
+            static std::size_t run(T const* data, std::size_t const& size)
+            {
+                return K::template arg_extremum<Max>(data, size);
+            }
+        };
+
+        struct count_op
+        {
+            template<typename K, typename T>
+            static std::size_t run(
+                T const* data, std::size_t const& size, T const& value)
+            {
+                return K::count(data, size, value);
+            }
+        };
+
+        struct find_op
+        {
+            template<typename K, typename T>
+            static std::size_t run(
+                T const* data, std::size_t const& size, T const& value)
+            {
+                return K::find(data, size, value);
+            }
+        };
+
+        template<bool Max, typename T>
+        std::size_t arg_extremum(
+            isa level, ext::array_view<T const> view)
+        {
+            if (view.empty()) {
+                return 0;
+            }
+
+            std::size_t best = 0;
+            for (std::size_t start = 0; start < view.size();
+                 start += max_chunk) {
+                auto const chunk = view.subview(
+                    start, std::min(max_chunk, view.size() - start));
+                auto const idx = start
+                    + dispatch<arg_extremum_op<Max>>(
+                        level, chunk.data(), chunk.size());
+                if (Max ? view[best] < view[idx] : view[idx] < view[best]) {
+                    best = idx;
+                }
+            }
+            return best;
+        }
+    } // namespace simd
+} // namespace array_view_detail
+
+namespace ext
+{
+    namespace simd
+    {
+        /// Returns the sum of the elements. Integer sums wrap around on
+        /// overflow. Floating-point sums are computed in a fixed but
+        /// ISA-dependent order, so the result may differ from sequential
+        /// summation by rounding.
+        ///
+        /// @param view     The elements to sum up.
+        /// @param level    The instruction set to use at most. The best one
+        ///                 supported by the CPU is used by default.
+        template<typename T>
+        typename std::remove_cv<T>::type sum(
+            array_view<T> view, isa level = best_isa())
+        {
+            using V = typename std::remove_cv<T>::type;
+            return array_view_detail::simd::dispatch<
+                array_view_detail::simd::sum_op>(
+                level, static_cast<V const*>(view.data()), view.size());
+        }
+
+        /// Returns the inner product of two views of the same length.
+        ///
+        /// @exception std::invalid_argument if the sizes of the views differ.
+        template<typename T, typename U>
+        typename std::remove_cv<T>::type dot(
+            array_view<T> lhs, array_view<U> rhs, isa level = best_isa())
+        {
+            using V = typename std::remove_cv<T>::type;
+            static_assert(
+                std::is_same<V, typename std::remove_cv<U>::type>::value,
+                "element types must be the same");
+
+            if (lhs.size() != rhs.size()) {
+                throw std::invalid_argument("array_view sizes differ");
+            }
+            return array_view_detail::simd::dispatch<
+                array_view_detail::simd::dot_op>(level,
+                static_cast<V const*>(lhs.data()),
+                static_cast<V const*>(rhs.data()), lhs.size());
+        }
+
+        /// Returns the index of the first smallest element, or zero if the
+        /// view is empty. The result is unspecified if the view
+        /// contains NaN.
+        template<typename T>
+        std::size_t argmin(array_view<T> view, isa level = best_isa())
+        {
+            if (view.empty()) {
+                return 0;
+            }
+            return array_view_detail::simd::arg_extremum<false>(
+                level, view.as_const());
+        }
+
+        /// Returns the index of the first largest element, or zero if the
+        /// view is empty. The result is unspecified if the view
+        /// contains NaN.
+        template<typename T>
+        std::size_t argmax(array_view<T> view, isa level = best_isa())
+        {
+            if (view.empty()) {
+                return 0;
+            }
+            return array_view_detail::simd::arg_extremum<true>(
+                level, view.as_const());
+        }
+
+        /// Returns the smallest element.
+        ///
+        /// @exception std::out_of_range if the view is empty.
+        template<typename T>
+        typename std::remove_cv<T>::type min(
+            array_view<T> view, isa level = best_isa())
+        {
+            return view.at(argmin(view, level));
+        }
+
+        /// Returns the largest element.
+        ///
+        /// @exception std::out_of_range if the view is empty.
+        template<typename T>
+        typename std::remove_cv<T>::type max(
+            array_view<T> view, isa level = best_isa())
+        {
+            return view.at(argmax(view, level));
+        }
+
+        /// Returns the number of elements equal to value.
+        template<typename T>
+        std::size_t count(array_view<T> view,
+            typename std::remove_cv<T>::type const& value,
+            isa level = best_isa())
+        {
+            using V = typename std::remove_cv<T>::type;
+            auto const max_chunk = array_view_detail::simd::max_chunk;
+
+            std::size_t total = 0;
+            for (std::size_t start = 0; start < view.size();
+                 start += max_chunk) {
+                auto const chunk = view.as_const().subview(
+                    start, std::min(max_chunk, view.size() - start));
+                total += array_view_detail::simd::dispatch<
+                    array_view_detail::simd::count_op>(level,
+                    static_cast<V const*>(chunk.data()), chunk.size(), value);
+            }
+            return total;
+        }
+
+        /// Returns the index of the first element equal to value, or the
+        /// size of the view if there is no such element.
+        template<typename T>
+        std::size_t find(array_view<T> view,
+            typename std::remove_cv<T>::type const& value,
+            isa level = best_isa())
+        {
+            using V = typename std::remove_cv<T>::type;
+            return array_view_detail::simd::dispatch<
+                array_view_detail::simd::find_op>(
+                level, static_cast<V const*>(view.data()), view.size(),
+                value);
+        }
+    } // namespace simd
+} // namespace ext
+
+#undef ARRAY_VIEW_SIMD_X86
+
+#endif // INCLUDED_ARRAY_VIEW_SIMD_HPP
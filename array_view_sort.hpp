@@ -0,0 +1,416 @@
+// array_view_sort - Radix sort of array_views of numbers and keyed records
+//
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ARRAY_VIEW_SORT_HPP
+#define INCLUDED_ARRAY_VIEW_SORT_HPP
+
+#include <algorithm> // fill, max, min, move
+#include <cstddef> // size_t
+#include <cstdint> // uint8_t, uint16_t, uint32_t, uint64_t
+#include <cstring> // memcpy
+#include <memory> // unique_ptr
+#include <stdexcept> // invalid_argument
+#include <type_traits> // decay, enable_if, is_arithmetic, is_floating_point,
+                       // is_signed, remove_cv
+#include <utility> // declval, swap
+#include <vector> // vector
+
+#include "array_view.hpp"
+#include "array_view_parallel.hpp"
+
+namespace array_view_detail
+{
+    template<std::size_t Size>
+    struct unsigned_of_size;
+
+    template<>
+    struct unsigned_of_size<1>
+    {
+        using type = std::uint8_t;
+    };
+
+    template<>
+    struct unsigned_of_size<2>
+    {
+        using type = std::uint16_t;
+    };
+
+    template<>
+    struct unsigned_of_size<4>
+    {
+        using type = std::uint32_t;
+    };
+
+    template<>
+    struct unsigned_of_size<8>
+    {
+        using type = std::uint64_t;
+    };
+
+    template<typename K>
+    using radix_unsigned_t = typename unsigned_of_size<sizeof(K)>::type;
+
+    // Maps a key to an unsigned integer whose order matches the order of
+    // the keys. Signed integers get the sign bit flipped. Negative floats
+    // get all bits flipped and positive floats get the sign bit set, which
+    // orders -0.0 before +0.0 and NaNs beyond the infinities.
+    template<typename K>
+    typename std::enable_if<!std::is_floating_point<K>::value,
+        radix_unsigned_t<K>>::type
+    radix_key(K key) noexcept
+    {
+        using U = radix_unsigned_t<K>;
+        auto const bits = static_cast<U>(key);
+        if (std::is_signed<K>::value) {
+            return static_cast<U>(bits ^ (U(1) << (8 * sizeof(U) - 1)));
+        }
+        return bits;
+    }
+
+    template<typename K>
+    typename std::enable_if<std::is_floating_point<K>::value,
+        radix_unsigned_t<K>>::type
+    radix_key(K key) noexcept
+    {
+        using U = radix_unsigned_t<K>;
+        U bits;
+        std::memcpy(&bits, &key, sizeof bits);
+        U const sign = U(1) << (8 * sizeof(U) - 1);
+        return (bits & sign) ? static_cast<U>(~bits) : (bits | sign);
+    }
+
+    constexpr std::size_t radix_bits = 8;
+    constexpr std::size_t radix_buckets = std::size_t(1) << radix_bits;
+
+    template<typename U>
+    std::size_t radix_digit(U key, std::size_t pass) noexcept
+    {
+        return static_cast<std::size_t>(key >> (radix_bits * pass))
+            & (radix_buckets - 1);
+    }
+
+    // The key type of elements of type T extracted with Key.
+    template<typename T, typename Key>
+    using radix_key_t = typename std::decay<decltype(
+        std::declval<Key const&>()(std::declval<T const&>()))>::type;
+
+    struct identity_key
+    {
+        template<typename T>
+        T operator()(T const& value) const
+        {
+            return value;
+        }
+    };
+
+    template<typename T, typename Key>
+    void check_radix_args(
+        ext::array_view<T> data, ext::array_view<T> scratch, Key const&)
+    {
+        static_assert(std::is_arithmetic<radix_key_t<T, Key>>::value,
+            "radix sort keys must be integers or floating-point numbers");
+        if (scratch.size() < data.size()) {
+            throw std::invalid_argument("radix sort scratch is too small");
+        }
+    }
+
+    // Counts the digits of all passes in [first, last).
+    template<typename T, typename Key, std::size_t Passes>
+    void radix_histograms(T const* first, T const* last, Key const& key,
+        std::size_t (&counts)[Passes][radix_buckets]) noexcept
+    {
+        for (; first != last; ++first) {
+            auto const k = radix_key(key(*first));
+            for (std::size_t pass = 0; pass < Passes; pass++) {
+                counts[pass][radix_digit(k, pass)]++;
+            }
+        }
+    }
+
+    // Tests if all n elements share the same digit in a pass, in which case
+    // the pass would not move anything.
+    inline bool is_trivial_pass(
+        std::size_t const (&counts)[radix_buckets], std::size_t n) noexcept
+    {
+        for (auto const count : counts) {
+            if (count != 0) {
+                return count == n;
+            }
+        }
+        return true;
+    }
+
+    // Stable LSD radix sort with one byte per pass, alternating between
+    // data and scratch.
+    template<typename T, typename Key>
+    void radix_sort(
+        ext::array_view<T> data, ext::array_view<T> scratch, Key const& key)
+    {
+        using U = radix_unsigned_t<radix_key_t<T, Key>>;
+        constexpr std::size_t passes = sizeof(U);
+        auto const n = data.size();
+
+        std::size_t counts[passes][radix_buckets] = {};
+        radix_histograms(data.data(), data.data() + n, key, counts);
+
+        T* src = data.data();
+        T* dest = scratch.data();
+        for (std::size_t pass = 0; pass < passes; pass++) {
+            if (is_trivial_pass(counts[pass], n)) {
+                continue;
+            }
+
+            std::size_t offsets[radix_buckets];
+            std::size_t offset = 0;
+            for (std::size_t digit = 0; digit < radix_buckets; digit++) {
+                offsets[digit] = offset;
+                offset += counts[pass][digit];
+            }
+            for (std::size_t i = 0; i < n; i++) {
+                auto const digit = radix_digit(radix_key(key(src[i])), pass);
+                dest[offsets[digit]++] = std::move(src[i]);
+            }
+            std::swap(src, dest);
+        }
+
+        if (src != data.data()) {
+            std::move(src, src + n, data.data());
+        }
+    }
+
+    // Parallel variant of radix_sort. The data is split into fixed blocks.
+    // Each pass counts the digits of every block in parallel, assigns each
+    // (digit, block) pair its output range and scatters the blocks in
+    // parallel, so the sort stays stable.
+    template<typename T, typename Key>
+    void parallel_radix_sort(ext::array_view<T> data,
+        ext::array_view<T> scratch, Key const& key,
+        ext::parallel_options const& options)
+    {
+        using U = radix_unsigned_t<radix_key_t<T, Key>>;
+        constexpr std::size_t passes = sizeof(U);
+        constexpr std::size_t min_grain = std::size_t(1) << 14;
+
+        auto& pool =
+            options.pool ? *options.pool : ext::default_thread_pool();
+        auto const n = data.size();
+        auto grain = options.grain_size;
+        if (grain == 0) {
+            auto const tasks = 4 * pool.concurrency();
+            grain = std::max((n + tasks - 1) / tasks, min_grain);
+        }
+        auto const blocks = (n + grain - 1) / grain;
+        if (blocks <= 1) {
+            radix_sort(data, scratch, key);
+            return;
+        }
+
+        struct block_histograms
+        {
+            std::size_t counts[passes][radix_buckets];
+        };
+        std::vector<block_histograms> histograms(blocks);
+        pool.parallel_for(blocks, [&](std::size_t block) {
+            auto& hist = histograms[block];
+            hist = block_histograms{};
+            auto const first = data.data() + block * grain;
+            auto const last = data.data() + std::min(n, (block + 1) * grain);
+            radix_histograms(first, last, key, hist.counts);
+        });
+
+        std::size_t totals[passes][radix_buckets] = {};
+        for (auto const& hist : histograms) {
+            for (std::size_t pass = 0; pass < passes; pass++) {
+                for (std::size_t digit = 0; digit < radix_buckets; digit++) {
+                    totals[pass][digit] += hist.counts[pass][digit];
+                }
+            }
+        }
+
+        // Digit counts and then output offsets of each block.
+        std::vector<std::size_t> offsets(blocks * radix_buckets);
+        T* src = data.data();
+        T* dest = scratch.data();
+
+        for (std::size_t pass = 0; pass < passes; pass++) {
+            if (is_trivial_pass(totals[pass], n)) {
+                continue;
+            }
+
+            pool.parallel_for(blocks, [&](std::size_t block) {
+                auto const counts = offsets.data() + block * radix_buckets;
+                std::fill(counts, counts + radix_buckets, std::size_t(0));
+                auto const last = std::min(n, (block + 1) * grain);
+                for (auto i = block * grain; i < last; i++) {
+                    counts[radix_digit(radix_key(key(src[i])), pass)]++;
+                }
+            });
+
+            std::size_t offset = 0;
+            for (std::size_t digit = 0; digit < radix_buckets; digit++) {
+                for (std::size_t block = 0; block < blocks; block++) {
+                    auto& slot = offsets[block * radix_buckets + digit];
+                    auto const count = slot;
+                    slot = offset;
+                    offset += count;
+                }
+            }
+
+            pool.parallel_for(blocks, [&](std::size_t block) {
+                auto const cursors = offsets.data() + block * radix_buckets;
+                auto const last = std::min(n, (block + 1) * grain);
+                for (auto i = block * grain; i < last; i++) {
+                    auto const digit =
+                        radix_digit(radix_key(key(src[i])), pass);
+                    dest[cursors[digit]++] = std::move(src[i]);
+                }
+            });
+            std::swap(src, dest);
+        }
+
+        if (src != data.data()) {
+            auto const from = src;
+            pool.parallel_for(blocks, [&](std::size_t block) {
+                auto const first = block * grain;
+                auto const last = std::min(n, first + grain);
+                std::move(from + first, from + last, data.data() + first);
+            });
+        }
+    }
+
+    template<typename T>
+    std::unique_ptr<T[]> make_radix_scratch(std::size_t size)
+    {
+        return std::unique_ptr<T[]>{new T[size]};
+    }
+} // namespace array_view_detail
+
+namespace ext
+{
+    /// Sorts a view of records in ascending order of the arithmetic keys
+    /// returned by key(record) with a stable LSD radix sort, using the
+    /// first data.size() elements of scratch as temporary storage. The
+    /// contents of the scratch are unspecified afterwards. The key function
+    /// is called several times per record, so it should be cheap, such as
+    /// a member access.
+    ///
+    /// Floating-point keys are ordered by value with -0.0 before +0.0,
+    /// negative NaNs first and positive NaNs last.
+    ///
+    /// @code
+    /// ext::radix_sort_by(events, scratch,
+    ///     [](event const& e) { return e.time; });
+    /// @endcode
+    ///
+    /// @exception std::invalid_argument if scratch is smaller than data.
+    template<typename T, typename Key>
+    void radix_sort_by(array_view<T> data, array_view<T> scratch, Key key)
+    {
+        array_view_detail::check_radix_args(data, scratch, key);
+        array_view_detail::radix_sort(data, scratch, key);
+    }
+
+    /// Sorts a view of integers or floating-point numbers in ascending
+    /// order using caller-provided scratch. Takes O(n) time.
+    ///
+    /// @exception std::invalid_argument if scratch is smaller than data.
+    template<typename T>
+    void radix_sort(array_view<T> data, array_view<T> scratch)
+    {
+        radix_sort_by(data, scratch, array_view_detail::identity_key{});
+    }
+
+    /// Same as radix_sort_by(data, scratch, key) but allocates the scratch.
+    ///
+    /// @exception std::bad_alloc if the scratch array cannot be allocated.
+    template<typename T, typename Key>
+    void radix_sort_by(array_view<T> data, Key key)
+    {
+        auto const scratch =
+            array_view_detail::make_radix_scratch<T>(data.size());
+        radix_sort_by(data, array_view<T>{scratch.get(), data.size()}, key);
+    }
+
+    /// Same as radix_sort(data, scratch) but allocates the scratch.
+    ///
+    /// @exception std::bad_alloc if the scratch array cannot be allocated.
+    template<typename T>
+    void radix_sort(array_view<T> data)
+    {
+        radix_sort_by(data, array_view_detail::identity_key{});
+    }
+
+    /// Multi-threaded variant of radix_sort_by(data, scratch, key). The
+    /// result is identical. options.grain_size is the number of elements
+    /// per block; small inputs are sorted on the calling thread.
+    ///
+    /// @exception std::invalid_argument if scratch is smaller than data.
+    template<typename T, typename Key>
+    void parallel_radix_sort_by(array_view<T> data, array_view<T> scratch,
+        Key key, parallel_options const& options = {})
+    {
+        array_view_detail::check_radix_args(data, scratch, key);
+        array_view_detail::parallel_radix_sort(data, scratch, key, options);
+    }
+
+    /// Multi-threaded variant of radix_sort(data, scratch).
+    ///
+    /// @exception std::invalid_argument if scratch is smaller than data.
+    template<typename T>
+    void parallel_radix_sort(array_view<T> data, array_view<T> scratch,
+        parallel_options const& options = {})
+    {
+        parallel_radix_sort_by(
+            data, scratch, array_view_detail::identity_key{}, options);
+    }
+
+    /// Multi-threaded variant of radix_sort_by(data, key).
+    ///
+    /// @exception std::bad_alloc if the scratch array cannot be allocated.
+    template<typename T, typename Key>
+    void parallel_radix_sort_by(
+        array_view<T> data, Key key, parallel_options const& options = {})
+    {
+        auto const scratch =
+            array_view_detail::make_radix_scratch<T>(data.size());
+        parallel_radix_sort_by(
+            data, array_view<T>{scratch.get(), data.size()}, key, options);
+    }
+
+    /// Multi-threaded variant of radix_sort(data).
+    ///
+    /// @exception std::bad_alloc if the scratch array cannot be allocated.
+    template<typename T>
+    void parallel_radix_sort(
+        array_view<T> data, parallel_options const& options = {})
+    {
+        parallel_radix_sort_by(
+            data, array_view_detail::identity_key{}, options);
+    }
+} // namespace ext
+
+#endif // INCLUDED_ARRAY_VIEW_SORT_HPP
@@ -0,0 +1,561 @@
+// array_view_window - Sliding-window aggregates over array_view
+//
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ARRAY_VIEW_WINDOW_HPP
+#define INCLUDED_ARRAY_VIEW_WINDOW_HPP
+
+#include <cmath> // abs
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+#include <functional> // less, greater
+#include <stdexcept> // invalid_argument
+#include <type_traits> // enable_if, is_arithmetic, is_floating_point,
+                       // is_same, remove_cv
+#include <vector> // vector
+
+#include "array_view.hpp"
+
+namespace ext
+{
+    /// How running sums are accumulated.
+    enum class summation
+    {
+        /// Plain addition and subtraction. Rounding errors of floating-point
+        /// values accumulate over the stream.
+        naive,
+
+        /// Neumaier's compensated summation, which keeps the error of a
+        /// floating-point running sum near one rounding regardless of the
+        /// length of the stream at about three times the cost. Integer sums
+        /// are exact either way.
+        compensated
+    };
+
+    /// An aggregate of the values in a window.
+    enum class window_aggregate
+    {
+        min,
+        max,
+        sum,
+        mean
+    };
+} // namespace ext
+
+namespace array_view_detail
+{
+    inline void check_window_length(std::size_t length)
+    {
+        if (length == 0) {
+            throw std::invalid_argument("window length must be positive");
+        }
+    }
+
+    // Returns the number of full windows of the given length in n values.
+    inline std::size_t window_count(std::size_t n, std::size_t length)
+    {
+        return n < length ? 0 : n - length + 1;
+    }
+
+    inline void check_window_output(
+        std::size_t dest, std::size_t n, std::size_t length)
+    {
+        if (dest != window_count(n, length)) {
+            throw std::invalid_argument(
+                "destination size does not match the window count");
+        }
+    }
+
+    // Extreme of the last length values pushed. The queue holds the values
+    // that can still become the extreme, in arrival order, with the current
+    // extreme at the front; each value is pushed and popped once, so a push
+    // takes amortized constant time.
+    template<typename T, typename Compare>
+    class monotonic_queue
+    {
+      public:
+        explicit monotonic_queue(std::size_t length)
+            : length_{length}
+            , slots_(ring_capacity(length + 1))
+            , mask_{slots_.size() - 1}
+        {
+        }
+
+        void push(T value, std::uint64_t index)
+        {
+            Compare const better;
+            while (size_ > 0 && !better(back().value, value)) {
+                size_--;
+            }
+            slots_[(head_ + size_) & mask_] = {value, index};
+            size_++;
+            if (front_index() + length_ <= index) {
+                head_ = (head_ + 1) & mask_;
+                size_--;
+            }
+        }
+
+        T front() const noexcept
+        {
+            return slots_[head_].value;
+        }
+
+        void clear() noexcept
+        {
+            head_ = 0;
+            size_ = 0;
+        }
+
+      private:
+        struct slot
+        {
+            T value;
+            std::uint64_t index;
+        };
+
+        slot const& back() const noexcept
+        {
+            return slots_[(head_ + size_ - 1) & mask_];
+        }
+
+        std::uint64_t front_index() const noexcept
+        {
+            return slots_[head_].index;
+        }
+
+        // Returns the least power of two not less than n, so that ring
+        // positions wrap with a mask instead of a division.
+        static std::size_t ring_capacity(std::size_t n) noexcept
+        {
+            std::size_t capacity = 1;
+            while (capacity < n) {
+                capacity *= 2;
+            }
+            return capacity;
+        }
+
+        std::size_t length_;
+        std::vector<slot> slots_;
+        std::size_t mask_;
+        std::size_t head_ = 0;
+        std::size_t size_ = 0;
+    };
+
+    // Sum of a stream of additions and subtractions.
+    template<typename T, bool = std::is_floating_point<T>::value>
+    class running_sum
+    {
+      public:
+        explicit running_sum(ext::summation) noexcept
+        {
+        }
+
+        void add(T value) noexcept
+        {
+            sum_ += value;
+        }
+
+        void subtract(T value) noexcept
+        {
+            sum_ -= value;
+        }
+
+        T value() const noexcept
+        {
+            return sum_;
+        }
+
+        void clear() noexcept
+        {
+            sum_ = T();
+        }
+
+      private:
+        T sum_ = T();
+    };
+
+    template<typename T>
+    class running_sum<T, true>
+    {
+      public:
+        explicit running_sum(ext::summation mode) noexcept
+            : compensated_{mode == ext::summation::compensated}
+        {
+        }
+
+        void add(T value) noexcept
+        {
+            if (!compensated_) {
+                sum_ += value;
+                return;
+            }
+            auto const total = sum_ + value;
+            if (std::abs(sum_) >= std::abs(value)) {
+                error_ += (sum_ - total) + value;
+            } else {
+                error_ += (value - total) + sum_;
+            }
+            sum_ = total;
+        }
+
+        void subtract(T value) noexcept
+        {
+            add(-value);
+        }
+
+        T value() const noexcept
+        {
+            return sum_ + error_;
+        }
+
+        void clear() noexcept
+        {
+            sum_ = T();
+            error_ = T();
+        }
+
+      private:
+        bool compensated_;
+        T sum_ = T();
+        T error_ = T();
+    };
+
+    template<typename T>
+    T window_mean(T sum, std::size_t count) noexcept
+    {
+        return sum / static_cast<T>(count);
+    }
+
+    template<typename T, typename Compare>
+    void sliding_extreme(
+        ext::array_view<T const> src, std::size_t length,
+        ext::array_view<T> dest)
+    {
+        check_window_length(length);
+        check_window_output(dest.size(), src.size(), length);
+
+        monotonic_queue<T, Compare> queue{length};
+        for (std::size_t i = 0; i < src.size(); i++) {
+            queue.push(src[i], i);
+            if (i + 1 >= length) {
+                dest[i + 1 - length] = queue.front();
+            }
+        }
+    }
+
+    template<typename T, typename F>
+    void sliding_sums(ext::array_view<T const> src, std::size_t length,
+        ext::array_view<T> dest, ext::summation mode, F finish)
+    {
+        check_window_length(length);
+        check_window_output(dest.size(), src.size(), length);
+
+        running_sum<T> sum{mode};
+        for (std::size_t i = 0; i < src.size(); i++) {
+            sum.add(src[i]);
+            if (i >= length) {
+                sum.subtract(src[i - length]);
+            }
+            if (i + 1 >= length) {
+                dest[i + 1 - length] = finish(sum.value());
+            }
+        }
+    }
+
+    template<typename T>
+    struct window_identity
+    {
+        T operator()(T value) const noexcept
+        {
+            return value;
+        }
+    };
+
+    template<typename T>
+    struct window_divide
+    {
+        std::size_t length;
+
+        T operator()(T value) const noexcept
+        {
+            return window_mean(value, length);
+        }
+    };
+} // namespace array_view_detail
+
+namespace ext
+{
+    /// Returns the number of full windows of the given length in n values,
+    /// which is the size of the output of the sliding_* functions.
+    inline std::size_t window_count(std::size_t n, std::size_t length)
+    {
+        return array_view_detail::window_count(n, length);
+    }
+
+    /// Computes the minimum of every window of length consecutive values.
+    /// dest[i] receives the minimum of src[i], ..., src[i + length - 1].
+    /// Takes O(n) time for any window length. The result is unspecified if
+    /// src contains NaNs.
+    ///
+    /// @code
+    /// std::vector<double> lows(ext::window_count(samples.size(), 60));
+    /// ext::sliding_min(samples, 60, ext::make_array_view(lows));
+    /// @endcode
+    ///
+    /// @exception std::invalid_argument if length is zero or the size of
+    /// dest is not window_count(src.size(), length).
+    template<typename T, typename U,
+        typename = typename std::enable_if<std::is_same<T,
+            typename std::remove_cv<U>::type>::value>::type>
+    void sliding_min(
+        array_view<U> src, std::size_t length, array_view<T> dest)
+    {
+        array_view_detail::sliding_extreme<T, std::less<T>>(
+            src, length, dest);
+    }
+
+    /// Computes the maximum of every window of length consecutive values
+    /// in O(n) time. See sliding_min().
+    ///
+    /// @exception std::invalid_argument if length is zero or the size of
+    /// dest is not window_count(src.size(), length).
+    template<typename T, typename U,
+        typename = typename std::enable_if<std::is_same<T,
+            typename std::remove_cv<U>::type>::value>::type>
+    void sliding_max(
+        array_view<U> src, std::size_t length, array_view<T> dest)
+    {
+        array_view_detail::sliding_extreme<T, std::greater<T>>(
+            src, length, dest);
+    }
+
+    /// Computes the sum of every window of length consecutive values with a
+    /// running sum in O(n) time.
+    ///
+    /// @exception std::invalid_argument if length is zero or the size of
+    /// dest is not window_count(src.size(), length).
+    template<typename T, typename U,
+        typename = typename std::enable_if<std::is_same<T,
+            typename std::remove_cv<U>::type>::value>::type>
+    void sliding_sum(array_view<U> src, std::size_t length,
+        array_view<T> dest, summation mode = summation::naive)
+    {
+        array_view_detail::sliding_sums<T>(src, length, dest, mode,
+            array_view_detail::window_identity<T>{});
+    }
+
+    /// Computes the mean of every window of length consecutive values with
+    /// a running sum in O(n) time. Integer means are truncated.
+    ///
+    /// @exception std::invalid_argument if length is zero or the size of
+    /// dest is not window_count(src.size(), length).
+    template<typename T, typename U,
+        typename = typename std::enable_if<std::is_same<T,
+            typename std::remove_cv<U>::type>::value>::type>
+    void sliding_mean(array_view<U> src, std::size_t length,
+        array_view<T> dest, summation mode = summation::naive)
+    {
+        array_view_detail::sliding_sums<T>(src, length, dest, mode,
+            array_view_detail::window_divide<T>{length});
+    }
+
+    /// Aggregates of the last length values of a stream, updated in
+    /// amortized O(1) time per value. Values can be pushed in batches of
+    /// any size; history is never rescanned.
+    ///
+    /// @code
+    /// ext::sliding_window<double> window{60};
+    /// std::vector<double> highs;
+    /// for (ext::array_view<double const> batch : batches) {
+    ///     highs.resize(batch.size());
+    ///     auto const n = window.push(batch, ext::window_aggregate::max,
+    ///         ext::make_array_view(highs));
+    ///     report(ext::make_array_view(highs).first(n));
+    /// }
+    /// @endcode
+    template<typename T>
+    class sliding_window
+    {
+        static_assert(std::is_arithmetic<T>::value,
+            "window values must be arithmetic");
+
+      public:
+        using value_type = T;
+
+        /// Creates an empty window of the given length.
+        ///
+        /// @exception std::invalid_argument if length is zero.
+        explicit sliding_window(
+            std::size_t length, summation mode = summation::naive)
+            : length_{(array_view_detail::check_window_length(length),
+                  length)}
+            , values_(length)
+            , min_{length}
+            , max_{length}
+            , sum_{mode}
+        {
+        }
+
+        /// Returns the window length.
+        std::size_t length() const noexcept
+        {
+            return length_;
+        }
+
+        /// Returns the number of values in the window, which is less than
+        /// the length only until length values have been pushed.
+        std::size_t size() const noexcept
+        {
+            return count_ < length_ ? static_cast<std::size_t>(count_)
+                                    : length_;
+        }
+
+        /// Tests if no value has been pushed.
+        bool empty() const noexcept
+        {
+            return count_ == 0;
+        }
+
+        /// Tests if the window holds length values.
+        bool full() const noexcept
+        {
+            return count_ >= length_;
+        }
+
+        /// Returns the number of values pushed since construction or the
+        /// last clear().
+        std::uint64_t count() const noexcept
+        {
+            return count_;
+        }
+
+        /// Appends a value, dropping the oldest one if the window is full.
+        void push(T value)
+        {
+            auto const slot = static_cast<std::size_t>(count_ % length_);
+            sum_.add(value);
+            if (full()) {
+                sum_.subtract(values_[slot]);
+            }
+            values_[slot] = value;
+            min_.push(value, count_);
+            max_.push(value, count_);
+            count_++;
+        }
+
+        /// Appends values in order.
+        void push(array_view<T const> batch)
+        {
+            for (auto const value : batch) {
+                push(value);
+            }
+        }
+
+        /// Appends values in order and writes an aggregate of each full
+        /// window to dest, one per value that completes a window. Returns
+        /// the number of results written.
+        ///
+        /// @exception std::invalid_argument if dest is smaller than batch.
+        std::size_t push(array_view<T const> batch, window_aggregate which,
+            array_view<T> dest)
+        {
+            if (dest.size() < batch.size()) {
+                throw std::invalid_argument(
+                    "destination is smaller than the batch");
+            }
+            std::size_t written = 0;
+            for (auto const value : batch) {
+                push(value);
+                if (full()) {
+                    dest[written++] = get(which);
+                }
+            }
+            return written;
+        }
+
+        /// Returns the minimum value in the window. The behavior is
+        /// undefined if the window is empty.
+        T min() const noexcept
+        {
+            return min_.front();
+        }
+
+        /// Returns the maximum value in the window. The behavior is
+        /// undefined if the window is empty.
+        T max() const noexcept
+        {
+            return max_.front();
+        }
+
+        /// Returns the sum of the values in the window.
+        T sum() const noexcept
+        {
+            return sum_.value();
+        }
+
+        /// Returns the mean of the values in the window. Integer means are
+        /// truncated. The behavior is undefined if the window is empty.
+        T mean() const noexcept
+        {
+            return array_view_detail::window_mean(sum(), size());
+        }
+
+        /// Returns an aggregate of the values in the window.
+        T get(window_aggregate which) const noexcept
+        {
+            switch (which) {
+              case window_aggregate::min:
+                return min();
+              case window_aggregate::max:
+                return max();
+              case window_aggregate::sum:
+                return sum();
+              case window_aggregate::mean:
+                break;
+            }
+            return mean();
+        }
+
+        /// Removes all values.
+        void clear() noexcept
+        {
+            count_ = 0;
+            min_.clear();
+            max_.clear();
+            sum_.clear();
+        }
+
+      private:
+        std::size_t length_;
+        std::vector<T> values_;
+        array_view_detail::monotonic_queue<T, std::less<T>> min_;
+        array_view_detail::monotonic_queue<T, std::greater<T>> max_;
+        array_view_detail::running_sum<T> sum_;
+        std::uint64_t count_ = 0;
+    };
+} // namespace ext
+
+#endif // INCLUDED_ARRAY_VIEW_WINDOW_HPP
@@ -0,0 +1,132 @@
+// Compares sum and axpy loops over array_view and aligned_array_view.
+//
+// The kernels are not inlined so that the compiler cannot see where the
+// buffers come from. Only the aligned view tells the compiler that the data
+// is aligned, which lets it drop the peeling prologue and use aligned loads.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include <aligned_array_view.hpp>
+#include <array_view.hpp>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+namespace
+{
+    constexpr std::size_t alignment = 64;
+
+    using aligned_floats = ext::aligned_array_view<float, alignment>;
+    using aligned_const_floats =
+        ext::aligned_array_view<float const, alignment>;
+    using aligned_const_ints =
+        ext::aligned_array_view<std::int32_t const, alignment>;
+
+    BENCH_NOINLINE std::int32_t sum_plain(
+        ext::array_view<std::int32_t const> xs)
+    {
+        std::int32_t total = 0;
+        for (auto x : xs) {
+            total += x;
+        }
+        return total;
+    }
+
+    BENCH_NOINLINE std::int32_t sum_aligned(aligned_const_ints xs)
+    {
+        std::int32_t total = 0;
+        for (auto x : xs) {
+            total += x;
+        }
+        return total;
+    }
+
+    BENCH_NOINLINE void axpy_plain(float a, ext::array_view<float const> xs,
+        ext::array_view<float> ys)
+    {
+        for (std::size_t i = 0; i < ys.size(); i++) {
+            ys[i] += a * xs[i];
+        }
+    }
+
+    BENCH_NOINLINE void axpy_aligned(
+        float a, aligned_const_floats xs, aligned_floats ys)
+    {
+        for (std::size_t i = 0; i < ys.size(); i++) {
+            ys[i] += a * xs[i];
+        }
+    }
+
+    // Returns a view of n elements aligned to the alignment boundary.
+    template<typename T>
+    ext::array_view<T> carve_aligned(
+        std::vector<char>& storage, std::size_t n)
+    {
+        void* ptr = storage.data();
+        std::size_t space = storage.size();
+        std::align(alignment, n * sizeof(T), ptr, space);
+        return {static_cast<T*>(ptr), n};
+    }
+
+    // Runs fn repeatedly and returns nanoseconds per element.
+    template<typename F>
+    double measure(std::size_t n, F fn)
+    {
+        using clock = std::chrono::steady_clock;
+
+        std::size_t const reps = 1 + (std::size_t{1} << 26) / n;
+        fn();
+        auto const start = clock::now();
+        for (std::size_t rep = 0; rep < reps; rep++) {
+            fn();
+        }
+        std::chrono::duration<double, std::nano> const elapsed =
+            clock::now() - start;
+        return elapsed.count() / static_cast<double>(reps * n);
+    }
+}
+
+int main()
+{
+    std::size_t const sizes[] = {1000, 10000, 100000};
+    volatile std::int32_t sink = 0;
+
+    std::printf("kernel\tview\tsize\tns_per_element\n");
+
+    for (auto const n : sizes) {
+        std::vector<char> x_storage(n * sizeof(float) + alignment);
+        std::vector<char> y_storage(n * sizeof(float) + alignment);
+        std::vector<char> i_storage(n * sizeof(std::int32_t) + alignment);
+
+        auto const xs = carve_aligned<float>(x_storage, n);
+        auto const ys = carve_aligned<float>(y_storage, n);
+        auto const is = carve_aligned<std::int32_t>(i_storage, n);
+        for (std::size_t i = 0; i < n; i++) {
+            xs[i] = 1.0f;
+            ys[i] = 0.0f;
+            is[i] = static_cast<std::int32_t>(i & 0xff);
+        }
+
+        auto const axs = ext::make_aligned_array_view<alignment>(xs);
+        auto const ays = ext::make_aligned_array_view<alignment>(ys);
+        auto const ais = ext::make_aligned_array_view<alignment>(is);
+
+        std::printf("sum\tarray_view\t%zu\t%.4f\n", n,
+            measure(n, [&] { sink = sum_plain(is); }));
+        std::printf("sum\taligned_array_view\t%zu\t%.4f\n", n,
+            measure(n, [&] { sink = sum_aligned(ais); }));
+        std::printf("axpy\tarray_view\t%zu\t%.4f\n", n,
+            measure(n, [&] { axpy_plain(0.5f, xs, ys); }));
+        std::printf("axpy\taligned_array_view\t%zu\t%.4f\n", n,
+            measure(n, [&] { axpy_aligned(0.5f, axs, ays); }));
+    }
+    static_cast<void>(sink);
+}
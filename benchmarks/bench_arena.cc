@@ -0,0 +1,108 @@
+// Compares scratch allocation with std::vector and ext::arena in a loop
+// shaped like a request handler.
+//
+// Each request allocates a few dozen short-lived arrays of mixed sizes, does
+// a little work on them and discards them. The arena is reset after every
+// request, so it stops allocating from the heap after the first request.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+#include <arena.hpp>
+#include <array_view.hpp>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+namespace
+{
+    constexpr std::size_t arrays_per_request = 32;
+
+    // Sizes of the scratch arrays, cycled through by the requests.
+    std::size_t const scratch_sizes[] = {4, 16, 48, 100, 8, 32, 250, 64};
+
+    std::size_t scratch_size(std::size_t request, std::size_t index)
+    {
+        auto const count = sizeof scratch_sizes / sizeof *scratch_sizes;
+        return scratch_sizes[(request + index) % count];
+    }
+
+    // The work done with each scratch array. Kept cheap so that allocation
+    // cost is visible.
+    BENCH_NOINLINE float touch(ext::array_view<float> scratch)
+    {
+        float total = 0;
+        for (std::size_t i = 0; i < scratch.size(); i += 16) {
+            scratch[i] = static_cast<float>(i);
+            total += scratch[i];
+        }
+        return total;
+    }
+
+    float request_with_vectors(std::size_t request)
+    {
+        float total = 0;
+        for (std::size_t i = 0; i < arrays_per_request; i++) {
+            std::vector<float> scratch(scratch_size(request, i));
+            total += touch(ext::make_array_view(scratch));
+        }
+        return total;
+    }
+
+    float request_with_arena(ext::arena& arena, std::size_t request)
+    {
+        float total = 0;
+        for (std::size_t i = 0; i < arrays_per_request; i++) {
+            auto const size = scratch_size(request, i);
+            total += touch(arena.allocate<float>(size, 0.0f));
+        }
+        arena.reset();
+        return total;
+    }
+
+    // Runs requests and returns nanoseconds per request.
+    template<typename F>
+    double measure(std::size_t requests, F fn)
+    {
+        using clock = std::chrono::steady_clock;
+
+        fn(0);
+        auto const start = clock::now();
+        for (std::size_t request = 0; request < requests; request++) {
+            fn(request);
+        }
+        std::chrono::duration<double, std::nano> const elapsed =
+            clock::now() - start;
+        return elapsed.count() / static_cast<double>(requests);
+    }
+}
+
+int main()
+{
+    std::size_t const requests = 200000;
+    volatile float sink = 0;
+
+    std::printf("allocator\trequests\tns_per_request\n");
+
+    std::printf("std::vector\t%zu\t%.1f\n", requests,
+        measure(requests,
+            [&](std::size_t request) { sink = request_with_vectors(request); }));
+
+    ext::arena arena;
+    std::printf("arena\t%zu\t%.1f\n", requests,
+        measure(requests, [&](std::size_t request) {
+            sink = request_with_arena(arena, request);
+        }));
+
+    std::printf("thread_local_arena\t%zu\t%.1f\n", requests,
+        measure(requests, [&](std::size_t request) {
+            sink = request_with_arena(ext::thread_local_arena(), request);
+        }));
+
+    static_cast<void>(sink);
+}
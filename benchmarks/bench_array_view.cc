@@ -0,0 +1,284 @@
+// Compares the hot operations of array_view with raw pointer and length
+// code and with std::vector.
+//
+// Each operation is measured for several element types and for working sets
+// sized to fit in L1, L2 and L3 caches and to spill into DRAM. The kernels
+// are not inlined, so each variant is compiled as a separate loop exactly as
+// it would be behind a function boundary in user code. Any difference
+// between the array_view and raw pointer columns is an abstraction cost.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <type_traits>
+#include <vector>
+
+#include <array_view.hpp>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+namespace
+{
+    // Length of the subviews taken by the slicing kernels.
+    constexpr std::size_t slice_size = 64;
+
+    //
+    // Iteration with range-based for.
+    //
+
+    template<typename T>
+    BENCH_NOINLINE T iterate_raw(T const* data, std::size_t size)
+    {
+        T total = 0;
+        for (T const* ptr = data; ptr != data + size; ++ptr) {
+            total += *ptr;
+        }
+        return total;
+    }
+
+    template<typename T>
+    BENCH_NOINLINE T iterate_vector(std::vector<T> const& vector)
+    {
+        T total = 0;
+        for (auto const x : vector) {
+            total += x;
+        }
+        return total;
+    }
+
+    template<typename T>
+    BENCH_NOINLINE T iterate_view(ext::array_view<T const> view)
+    {
+        T total = 0;
+        for (auto const x : view) {
+            total += x;
+        }
+        return total;
+    }
+
+    //
+    // Indexed access with operator[].
+    //
+
+    template<typename T>
+    BENCH_NOINLINE T index_raw(T const* data, std::size_t size)
+    {
+        T total = 0;
+        for (std::size_t i = 0; i < size; i++) {
+            total += data[i];
+        }
+        return total;
+    }
+
+    template<typename T>
+    BENCH_NOINLINE T index_vector(std::vector<T> const& vector)
+    {
+        T total = 0;
+        for (std::size_t i = 0; i < vector.size(); i++) {
+            total += vector[i];
+        }
+        return total;
+    }
+
+    template<typename T>
+    BENCH_NOINLINE T index_view(ext::array_view<T const> view)
+    {
+        T total = 0;
+        for (std::size_t i = 0; i < view.size(); i++) {
+            total += view[i];
+        }
+        return total;
+    }
+
+    //
+    // Slicing into short subranges and consuming each one.
+    //
+
+    template<typename T>
+    BENCH_NOINLINE T slice_raw(T const* data, std::size_t size)
+    {
+        T total = 0;
+        for (std::size_t offset = 0; offset < size; offset += slice_size) {
+            T const* slice = data + offset;
+            std::size_t const count =
+                size - offset < slice_size ? size - offset : slice_size;
+            for (std::size_t i = 0; i < count; i++) {
+                total += slice[i];
+            }
+        }
+        return total;
+    }
+
+    template<typename T>
+    BENCH_NOINLINE T slice_vector(std::vector<T> const& vector)
+    {
+        T total = 0;
+        for (std::size_t offset = 0; offset < vector.size();
+             offset += slice_size) {
+            auto const first = vector.begin() + offset;
+            auto const last = vector.size() - offset < slice_size
+                ? vector.end()
+                : first + slice_size;
+            for (auto it = first; it != last; ++it) {
+                total += *it;
+            }
+        }
+        return total;
+    }
+
+    template<typename T>
+    BENCH_NOINLINE T slice_view(ext::array_view<T const> view)
+    {
+        T total = 0;
+        while (!view.empty()) {
+            auto const count =
+                view.size() < slice_size ? view.size() : slice_size;
+            for (auto const x : view.first(count)) {
+                total += x;
+            }
+            view = view.drop_first(count);
+        }
+        return total;
+    }
+
+    //
+    // Passing a range across a function boundary.
+    //
+
+    template<typename T>
+    BENCH_NOINLINE T callee_raw(T const* data, std::size_t size)
+    {
+        return data[0] + data[size - 1];
+    }
+
+    template<typename T>
+    BENCH_NOINLINE T callee_vector(std::vector<T> const& vector)
+    {
+        return vector.front() + vector.back();
+    }
+
+    template<typename T>
+    BENCH_NOINLINE T callee_view(ext::array_view<T const> view)
+    {
+        return view.front() + view.back();
+    }
+
+    // Runs fn repeatedly so that about budget elements are processed and
+    // returns nanoseconds per element.
+    template<typename F>
+    double measure(std::size_t n, std::size_t budget, F fn)
+    {
+        using clock = std::chrono::steady_clock;
+
+        std::size_t const reps = 1 + budget / n;
+        fn();
+        auto const start = clock::now();
+        for (std::size_t rep = 0; rep < reps; rep++) {
+            fn();
+        }
+        std::chrono::duration<double, std::nano> const elapsed =
+            clock::now() - start;
+        return elapsed.count() / static_cast<double>(reps * n);
+    }
+
+    // Prints one result row.
+    void report(char const* operation, char const* type, char const* variant,
+        std::size_t bytes, double ns)
+    {
+        std::printf("%s\t%s\t%s\t%zu\t%.4f\n", operation, type, variant, bytes,
+            ns);
+    }
+
+    template<typename T>
+    void run(char const* type)
+    {
+        static_assert(std::is_unsigned<T>::value
+                || std::is_floating_point<T>::value,
+            "accumulating signed integers may overflow");
+
+        // Roughly L1, L2, L3 and DRAM resident working sets.
+        std::size_t const byte_sizes[] = {
+            std::size_t(16) << 10,
+            std::size_t(256) << 10,
+            std::size_t(4) << 20,
+            std::size_t(64) << 20,
+        };
+        std::size_t const budget = std::size_t(1) << 25;
+        volatile T sink = 0;
+
+        for (auto const bytes : byte_sizes) {
+            auto const n = bytes / sizeof(T);
+            std::vector<T> vector(n);
+            for (std::size_t i = 0; i < n; i++) {
+                vector[i] = static_cast<T>(i & 0xff);
+            }
+            auto const data = vector.data();
+            auto const view = ext::make_array_view(vector).as_const();
+
+            report("iterate", type, "raw", bytes, measure(n, budget, [&] {
+                sink = iterate_raw(data, n);
+            }));
+            report("iterate", type, "vector", bytes, measure(n, budget, [&] {
+                sink = iterate_vector(vector);
+            }));
+            report("iterate", type, "array_view", bytes,
+                measure(n, budget, [&] { sink = iterate_view(view); }));
+
+            report("index", type, "raw", bytes, measure(n, budget, [&] {
+                sink = index_raw(data, n);
+            }));
+            report("index", type, "vector", bytes, measure(n, budget, [&] {
+                sink = index_vector(vector);
+            }));
+            report("index", type, "array_view", bytes,
+                measure(n, budget, [&] { sink = index_view(view); }));
+
+            report("slice", type, "raw", bytes, measure(n, budget, [&] {
+                sink = slice_raw(data, n);
+            }));
+            report("slice", type, "vector", bytes, measure(n, budget, [&] {
+                sink = slice_vector(vector);
+            }));
+            report("slice", type, "array_view", bytes,
+                measure(n, budget, [&] { sink = slice_view(view); }));
+        }
+
+        // Call overhead does not depend on the size, so the per-element
+        // figure of the pass benchmark is the cost of one call.
+        std::size_t const calls = std::size_t(1) << 24;
+        std::vector<T> vector(slice_size, T(1));
+        auto const data = vector.data();
+        auto const view = ext::make_array_view(vector).as_const();
+        auto const bytes = vector.size() * sizeof(T);
+
+        report("pass", type, "raw", bytes, measure(1, calls, [&] {
+            sink = callee_raw(data, vector.size());
+        }));
+        report("pass", type, "vector", bytes, measure(1, calls, [&] {
+            sink = callee_vector(vector);
+        }));
+        report("pass", type, "array_view", bytes,
+            measure(1, calls, [&] { sink = callee_view(view); }));
+
+        static_cast<void>(sink);
+    }
+}
+
+int main()
+{
+    // The compiler goes to stderr so that stdout stays a plain table.
+#if defined(__VERSION__)
+    std::fprintf(stderr, "compiler: %s\n", __VERSION__);
+#endif
+    std::printf("operation\ttype\tvariant\tbytes\tns_per_element\n");
+
+    run<std::uint32_t>("uint32");
+    run<std::uint64_t>("uint64");
+    run<float>("float");
+    run<double>("double");
+}
@@ -0,0 +1,136 @@
+// Measures the throughput of deep equality, lexicographic comparison and
+// hashing of array_view contents against element-wise baselines.
+//
+// The inputs of equal and compare differ only in the last element, so the
+// whole array is scanned.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include <array_view.hpp>
+#include <array_view_compare.hpp>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+namespace
+{
+    BENCH_NOINLINE bool equal_elementwise(
+        ext::array_view<std::uint32_t const> lhs,
+        ext::array_view<std::uint32_t const> rhs)
+    {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+        for (std::size_t i = 0; i < lhs.size(); i++) {
+            if (lhs[i] != rhs[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    BENCH_NOINLINE bool equal_deep(ext::array_view<std::uint32_t const> lhs,
+        ext::array_view<std::uint32_t const> rhs)
+    {
+        return ext::equal(lhs, rhs);
+    }
+
+    BENCH_NOINLINE bool less_elementwise(
+        ext::array_view<unsigned char const> lhs,
+        ext::array_view<unsigned char const> rhs)
+    {
+        return std::lexicographical_compare(
+            lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    BENCH_NOINLINE bool less_deep(ext::array_view<unsigned char const> lhs,
+        ext::array_view<unsigned char const> rhs)
+    {
+        return ext::compare(lhs, rhs) < 0;
+    }
+
+    // FNV-1a, the usual hand-rolled byte-at-a-time hash.
+    BENCH_NOINLINE std::uint64_t hash_fnv1a(
+        ext::array_view<unsigned char const> bytes)
+    {
+        std::uint64_t h = 0xcbf29ce484222325ULL;
+        for (auto const byte : bytes) {
+            h ^= byte;
+            h *= 0x100000001b3ULL;
+        }
+        return h;
+    }
+
+    BENCH_NOINLINE std::uint64_t hash_deep(
+        ext::array_view<unsigned char const> bytes)
+    {
+        return ext::hash(bytes);
+    }
+
+    // Runs fn repeatedly and returns gigabytes per second.
+    template<typename F>
+    double measure(std::size_t bytes, F fn)
+    {
+        using clock = std::chrono::steady_clock;
+
+        std::size_t const reps = 1 + (std::size_t{1} << 30) / bytes;
+        fn();
+        auto const start = clock::now();
+        for (std::size_t rep = 0; rep < reps; rep++) {
+            fn();
+        }
+        std::chrono::duration<double> const elapsed = clock::now() - start;
+        return static_cast<double>(bytes * reps) / elapsed.count() * 1e-9;
+    }
+}
+
+int main()
+{
+    std::size_t const byte_sizes[] = {
+        std::size_t(4) << 10,
+        std::size_t(256) << 10,
+        std::size_t(16) << 20,
+    };
+    volatile std::uint64_t sink = 0;
+
+    std::printf("operation\timplementation\tbytes\tgb_per_second\n");
+
+    for (auto const bytes : byte_sizes) {
+        auto const n = bytes / sizeof(std::uint32_t);
+        std::vector<std::uint32_t> a(n);
+        for (std::size_t i = 0; i < n; i++) {
+            a[i] = static_cast<std::uint32_t>(i * 2654435761u);
+        }
+        auto b = a;
+        b.back()++;
+
+        auto const va = ext::make_array_view(a).as_const();
+        auto const vb = ext::make_array_view(b).as_const();
+        ext::array_view<unsigned char const> const ba{
+            reinterpret_cast<unsigned char const*>(a.data()), bytes};
+        ext::array_view<unsigned char const> const bb{
+            reinterpret_cast<unsigned char const*>(b.data()), bytes};
+
+        std::printf("equal\telementwise\t%zu\t%.2f\n", bytes,
+            measure(bytes, [&] { sink = equal_elementwise(va, vb); }));
+        std::printf("equal\text::equal\t%zu\t%.2f\n", bytes,
+            measure(bytes, [&] { sink = equal_deep(va, vb); }));
+        std::printf("compare\tlexicographical_compare\t%zu\t%.2f\n", bytes,
+            measure(bytes, [&] { sink = less_elementwise(ba, bb); }));
+        std::printf("compare\text::compare\t%zu\t%.2f\n", bytes,
+            measure(bytes, [&] { sink = less_deep(ba, bb); }));
+        std::printf("hash\tfnv1a\t%zu\t%.2f\n", bytes,
+            measure(bytes, [&] { sink = hash_fnv1a(ba); }));
+        std::printf("hash\text::hash\t%zu\t%.2f\n", bytes,
+            measure(bytes, [&] { sink = hash_deep(ba); }));
+    }
+    static_cast<void>(sink);
+}
@@ -0,0 +1,122 @@
+// Measures bulk copy and fill of large frames with cached and streaming
+// stores, together with their effect on a cache-sensitive workload running
+// concurrently in another thread.
+//
+// The concurrent workload repeatedly sums a working set that fits in cache.
+// Cached stores of a frame larger than the cache evict that working set,
+// which shows up as a longer time per pass.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <array_view.hpp>
+#include <array_view_copy.hpp>
+
+namespace
+{
+    using clock = std::chrono::steady_clock;
+
+    // Sums the working set until stop is set and returns the median time
+    // of a pass in nanoseconds. The median ignores passes interrupted by
+    // the scheduler.
+    double run_victim(ext::array_view<std::uint64_t const> working_set,
+        std::atomic<bool> const& stop, std::atomic<bool>& started)
+    {
+        std::vector<double> pass_ns;
+        pass_ns.reserve(1 << 16);
+        std::uint64_t total = 0;
+        started = true;
+        while (!stop.load(std::memory_order_relaxed)) {
+            auto const start = clock::now();
+            for (auto const value : working_set) {
+                total += value;
+            }
+            std::chrono::duration<double, std::nano> const elapsed =
+                clock::now() - start;
+            if (pass_ns.size() < pass_ns.capacity()) {
+                pass_ns.push_back(elapsed.count());
+            }
+        }
+        volatile std::uint64_t sink = total;
+        static_cast<void>(sink);
+
+        if (pass_ns.empty()) {
+            return 0;
+        }
+        auto const middle = pass_ns.begin() + pass_ns.size() / 2;
+        std::nth_element(pass_ns.begin(), middle, pass_ns.end());
+        return *middle;
+    }
+
+    // Runs fn repeatedly while the victim runs and prints a table row.
+    template<typename F>
+    void measure(char const* operation, char const* mode, std::size_t bytes,
+        ext::array_view<std::uint64_t const> working_set, F fn)
+    {
+        int const reps = 20;
+        std::atomic<bool> stop{false};
+        std::atomic<bool> started{false};
+        double victim_ns = 0;
+        std::thread victim{[&] {
+            victim_ns = run_victim(working_set, stop, started);
+        }};
+        while (!started) {
+            std::this_thread::yield();
+        }
+
+        auto const start = clock::now();
+        for (int rep = 0; rep < reps; rep++) {
+            fn();
+        }
+        std::chrono::duration<double> const elapsed = clock::now() - start;
+
+        stop = true;
+        victim.join();
+
+        auto const gbps = bytes == 0
+            ? 0.0
+            : double(bytes) * reps / elapsed.count() * 1e-9;
+        std::printf("%s\t%s\t%zu\t%.2f\t%.0f\n", operation, mode, bytes, gbps,
+            victim_ns);
+    }
+}
+
+int main()
+{
+    std::size_t const frame_bytes = std::size_t(64) << 20;
+    std::size_t const working_set_bytes = std::size_t(1) << 20;
+
+    std::vector<unsigned char> source(frame_bytes, 1);
+    std::vector<unsigned char> dest(frame_bytes);
+    std::vector<std::uint64_t> working_set(
+        working_set_bytes / sizeof(std::uint64_t), 1);
+
+    auto const src = ext::make_array_view(source).as_const();
+    auto const dst = ext::make_array_view(dest);
+    auto const ws = ext::make_array_view(working_set).as_const();
+
+    std::printf(
+        "operation\tmode\tbytes\tgb_per_second\tvictim_ns_per_pass\n");
+
+    // Baseline: the victim alone, with the main thread sleeping.
+    measure("none", "-", 0, ws, [] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    });
+
+    measure("copy", "cached", frame_bytes, ws,
+        [&] { ext::copy(dst, src, ext::store_mode::cached); });
+    measure("copy", "streaming", frame_bytes, ws,
+        [&] { ext::copy(dst, src, ext::store_mode::streaming); });
+
+    unsigned char const value = 0x5a;
+    measure("fill", "cached", frame_bytes, ws,
+        [&] { ext::fill(dst, value, ext::store_mode::cached); });
+    measure("fill", "streaming", frame_bytes, ws,
+        [&] { ext::fill(dst, value, ext::store_mode::streaming); });
+}
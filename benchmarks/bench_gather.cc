@@ -0,0 +1,122 @@
+// Measures selecting elements by index: materializing the selection into a
+// new vector, summing through an indirect_view, and bulk gather and scatter
+// at each instruction set level, for cache-resident and DRAM-sized tables.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <array_view.hpp>
+#include <array_view_simd.hpp>
+#include <indirect_view.hpp>
+
+namespace
+{
+    // Runs fn a few times and returns the best time in nanoseconds per
+    // selected element.
+    template<typename F>
+    double measure(std::size_t count, F fn)
+    {
+        using clock = std::chrono::steady_clock;
+
+        double best = 0;
+        for (int rep = 0; rep < 5; rep++) {
+            auto const start = clock::now();
+            fn();
+            std::chrono::duration<double, std::nano> const elapsed =
+                clock::now() - start;
+            if (rep == 0 || elapsed.count() < best) {
+                best = elapsed.count();
+            }
+        }
+        return best / double(count);
+    }
+
+    char const* isa_name(ext::simd::isa level)
+    {
+        switch (level) {
+        case ext::simd::isa::scalar:
+            return "scalar";
+        case ext::simd::isa::sse2:
+            return "sse2";
+        case ext::simd::isa::avx2:
+            return "avx2";
+        case ext::simd::isa::avx512:
+            return "avx512";
+        }
+        return "?";
+    }
+}
+
+int main()
+{
+    std::size_t const table_sizes[] = {
+        std::size_t(1) << 14,
+        std::size_t(1) << 24,
+    };
+    std::size_t const selected = std::size_t(1) << 22;
+    ext::simd::isa const levels[] = {ext::simd::isa::scalar,
+        ext::simd::isa::avx2, ext::simd::isa::avx512};
+    volatile float sink = 0;
+
+    std::printf("operation\tvariant\ttable_bytes\tns_per_element\n");
+
+    for (auto const size : table_sizes) {
+        std::vector<float> table(size, 1.0f);
+        std::vector<std::uint32_t> indices(selected);
+        std::mt19937 random;
+        std::uniform_int_distribution<std::uint32_t> dist{
+            0, static_cast<std::uint32_t>(size - 1)};
+        for (auto& index : indices) {
+            index = dist(random);
+        }
+        auto const view = ext::make_indirect_view(
+            ext::make_array_view(table), ext::make_array_view(indices));
+        std::vector<float> out(selected);
+        auto const bytes = size * sizeof(float);
+
+        auto const materialize_ns = measure(selected, [&] {
+            std::vector<float> copy;
+            copy.reserve(selected);
+            for (auto const index : indices) {
+                copy.push_back(table[index]);
+            }
+            float total = 0;
+            for (auto const value : copy) {
+                total += value;
+            }
+            sink = total;
+        });
+        std::printf("sum\tmaterialize\t%zu\t%.2f\n", bytes, materialize_ns);
+
+        auto const indirect_ns = measure(selected, [&] {
+            float total = 0;
+            for (auto const value : view) {
+                total += value;
+            }
+            sink = total;
+        });
+        std::printf("sum\tindirect_view\t%zu\t%.2f\n", bytes, indirect_ns);
+
+        for (auto const level : levels) {
+            auto const gather_ns = measure(selected, [&] {
+                ext::gather(
+                    ext::make_array_view(out), view.as_const(), level);
+            });
+            std::printf("gather\t%s\t%zu\t%.2f\n", isa_name(level), bytes,
+                gather_ns);
+        }
+        for (auto const level : levels) {
+            auto const scatter_ns = measure(selected, [&] {
+                ext::scatter(
+                    view, ext::make_array_view(out).as_const(), level);
+            });
+            std::printf("scatter\t%s\t%zu\t%.2f\n", isa_name(level), bytes,
+                scatter_ns);
+        }
+    }
+    static_cast<void>(sink);
+}
@@ -0,0 +1,105 @@
+// Measures scanning 20-bit IDs stored as plain uint32_t against the same
+// IDs bit-packed, summed through the proxy view and through bulk unpack
+// into a small chunk at each instruction set level.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <array_view.hpp>
+#include <array_view_simd.hpp>
+#include <packed_array_view.hpp>
+
+namespace
+{
+    // Runs fn a few times and returns the best time in nanoseconds per
+    // value.
+    template<typename F>
+    double measure(std::size_t count, F fn)
+    {
+        using clock = std::chrono::steady_clock;
+
+        double best = 0;
+        for (int rep = 0; rep < 5; rep++) {
+            auto const start = clock::now();
+            fn();
+            std::chrono::duration<double, std::nano> const elapsed =
+                clock::now() - start;
+            if (rep == 0 || elapsed.count() < best) {
+                best = elapsed.count();
+            }
+        }
+        return best / double(count);
+    }
+}
+
+int main()
+{
+    constexpr unsigned bits = 20;
+    std::size_t const size = std::size_t(1) << 24;
+    std::size_t const chunk_size = 1024;
+    volatile std::uint64_t sink = 0;
+
+    std::mt19937 random;
+    std::vector<std::uint32_t> plain(size);
+    for (auto& value : plain) {
+        value = random() & ((1u << bits) - 1);
+    }
+    std::vector<std::uint64_t> words(ext::packed_word_count(size, bits));
+    ext::packed_array_view<bits> const packed{
+        ext::make_array_view(words), size};
+    std::vector<std::uint32_t> chunk(chunk_size);
+    auto const chunk_view = ext::make_array_view(chunk);
+
+    std::printf("operation\tvariant\tbytes\tns_per_value\n");
+
+    auto const plain_ns = measure(size, [&] {
+        std::uint64_t total = 0;
+        for (auto const value : plain) {
+            total += value;
+        }
+        sink = total;
+    });
+    std::printf("sum\tuint32\t%zu\t%.3f\n", size * sizeof(std::uint32_t),
+        plain_ns);
+
+    auto const pack_ns = measure(size,
+        [&] { ext::pack(packed, ext::make_array_view(plain).as_const()); });
+    std::printf("pack\tscalar\t%zu\t%.3f\n",
+        words.size() * sizeof(std::uint64_t), pack_ns);
+
+    auto const proxy_ns = measure(size, [&] {
+        std::uint64_t total = 0;
+        for (std::uint32_t const value : packed.as_const()) {
+            total += value;
+        }
+        sink = total;
+    });
+    std::printf("sum\tpacked_proxy\t%zu\t%.3f\n",
+        words.size() * sizeof(std::uint64_t), proxy_ns);
+
+    ext::simd::isa const levels[] = {ext::simd::isa::scalar,
+        ext::simd::isa::avx2};
+    char const* const names[] = {"unpack_scalar", "unpack_avx2"};
+    for (std::size_t k = 0; k < 2; k++) {
+        auto const unpack_ns = measure(size, [&] {
+            std::uint64_t total = 0;
+            for (std::size_t base = 0; base < size; base += chunk_size) {
+                auto const count = std::min(chunk_size, size - base);
+                auto const out = chunk_view.first(count);
+                ext::unpack(out, packed.subview(base, count), levels[k]);
+                for (auto const value : out) {
+                    total += value;
+                }
+            }
+            sink = total;
+        });
+        std::printf("sum\t%s\t%zu\t%.3f\n", names[k],
+            words.size() * sizeof(std::uint64_t), unpack_ns);
+    }
+    static_cast<void>(sink);
+}
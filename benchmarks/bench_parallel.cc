@@ -0,0 +1,101 @@
+// Measures scaling of the parallel algorithms from one thread to the
+// hardware concurrency.
+//
+// The workloads are a memory-light transform with uneven per-element cost,
+// which exercises work stealing, and a plain reduction.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <array_view.hpp>
+#include <array_view_parallel.hpp>
+
+namespace
+{
+    // Runs fn a few times and returns the best time in milliseconds.
+    template<typename F>
+    double measure(F fn)
+    {
+        using clock = std::chrono::steady_clock;
+
+        double best = 0;
+        for (int rep = 0; rep < 5; rep++) {
+            auto const start = clock::now();
+            fn();
+            std::chrono::duration<double, std::milli> const elapsed =
+                clock::now() - start;
+            if (rep == 0 || elapsed.count() < best) {
+                best = elapsed.count();
+            }
+        }
+        return best;
+    }
+
+    // Per-element work whose cost grows along the array.
+    double uneven_work(double x, std::size_t i)
+    {
+        auto const iterations = 1 + i % 64;
+        for (std::size_t k = 0; k < iterations; k++) {
+            x = std::sqrt(x + 1.0);
+        }
+        return x;
+    }
+}
+
+int main()
+{
+    std::size_t const size = std::size_t(1) << 22;
+    std::vector<double> input(size, 1.0);
+    std::vector<double> output(size);
+    auto const in = ext::make_array_view(input).as_const();
+    auto const out = ext::make_array_view(output);
+
+    auto const max_threads =
+        std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    volatile double sink = 0;
+
+    // Powers of two up to the hardware concurrency, which is always included.
+    std::vector<std::size_t> thread_counts;
+    for (std::size_t threads = 1; threads < max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+
+    std::printf("workload\tthreads\tgrain\tmilliseconds\n");
+
+    for (auto const threads : thread_counts) {
+        ext::thread_pool pool{threads - 1};
+
+        for (std::size_t const grain : {std::size_t(0), std::size_t(4096)}) {
+            ext::parallel_options options;
+            options.pool = &pool;
+            options.grain_size = grain;
+
+            auto const transform_ms = measure([&] {
+                ext::parallel_for_chunks(out,
+                    [&](ext::array_view<double> chunk) {
+                        auto const offset = static_cast<std::size_t>(
+                            chunk.data() - out.data());
+                        for (std::size_t i = 0; i < chunk.size(); i++) {
+                            chunk[i] = uneven_work(in[offset + i], offset + i);
+                        }
+                    },
+                    options);
+            });
+            std::printf("uneven_transform\t%zu\t%zu\t%.3f\n", threads, grain,
+                transform_ms);
+
+            auto const reduce_ms = measure([&] {
+                sink = ext::parallel_reduce(in, 0.0,
+                    [](double acc, double x) { return acc + x; }, options);
+            });
+            std::printf("reduce\t%zu\t%zu\t%.3f\n", threads, grain, reduce_ms);
+        }
+    }
+    static_cast<void>(sink);
+}
@@ -0,0 +1,117 @@
+// Measures write throughput of threads updating their own parts of a shared
+// array, with parts split naively by element count and with parts split at
+// cache line boundaries by ext::partition.
+//
+// Each thread repeatedly increments every element of its part. With naive
+// parts, neighbouring threads write to the cache lines at the boundaries
+// concurrently, so those lines bounce between cores. The effect is largest
+// for small parts and needs at least two cores to show up.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <array_view.hpp>
+#include <array_view_chunks.hpp>
+
+namespace
+{
+    using clock = std::chrono::steady_clock;
+
+    void update(ext::array_view<std::uint32_t> part, std::size_t passes)
+    {
+        for (std::size_t pass = 0; pass < passes; pass++) {
+            for (auto& value : part) {
+                // Keep every store: the point is the memory traffic.
+                *static_cast<std::uint32_t volatile*>(&value) += 1;
+            }
+        }
+    }
+
+    // Runs one thread per part and returns the writes per second.
+    template<typename Parts>
+    double measure_once(Parts const& parts, std::size_t passes)
+    {
+        std::atomic<std::size_t> ready{0};
+        std::atomic<bool> go{false};
+        std::vector<std::thread> threads;
+        std::size_t writes = 0;
+        for (ext::array_view<std::uint32_t> part : parts) {
+            writes += part.size() * passes;
+            threads.emplace_back([&, part] {
+                ready++;
+                while (!go) {
+                    std::this_thread::yield();
+                }
+                update(part, passes);
+            });
+        }
+        while (ready < threads.size()) {
+            std::this_thread::yield();
+        }
+
+        auto const start = clock::now();
+        go = true;
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        std::chrono::duration<double> const elapsed = clock::now() - start;
+        return double(writes) / elapsed.count();
+    }
+
+    // Returns the best of a few runs.
+    template<typename Parts>
+    double measure(Parts const& parts, std::size_t passes)
+    {
+        double best = 0;
+        for (int rep = 0; rep < 5; rep++) {
+            best = std::max(best, measure_once(parts, passes));
+        }
+        return best;
+    }
+
+    // Splits a view into n parts of equal element count, ignoring cache
+    // lines.
+    std::vector<ext::array_view<std::uint32_t>> naive_partition(
+        ext::array_view<std::uint32_t> view, std::size_t n)
+    {
+        std::vector<ext::array_view<std::uint32_t>> parts;
+        for (std::size_t i = 0; i < n; i++) {
+            auto const begin = view.size() * i / n;
+            auto const end = view.size() * (i + 1) / n;
+            parts.push_back(view.subview(begin, end - begin));
+        }
+        return parts;
+    }
+}
+
+int main()
+{
+    auto const threads =
+        std::max<std::size_t>(std::thread::hardware_concurrency(), 2);
+    std::size_t const total_writes = std::size_t(1) << 28;
+
+    std::printf(
+        "threads\telements_per_thread\tpartition\twrites_per_second\n");
+
+    for (std::size_t const per_thread : {20, 100, 1000, 100000}) {
+        // Start three elements into a cache line so that naive boundaries
+        // fall inside lines.
+        auto const size = per_thread * threads;
+        std::vector<std::uint32_t> buffer(size + 64);
+        auto const offset = (64 - reinterpret_cast<std::uintptr_t>(
+            buffer.data()) % 64) % 64 / sizeof(std::uint32_t) + 3;
+        auto const view = ext::make_array_view(buffer).subview(offset, size);
+        auto const passes = std::max<std::size_t>(total_writes / size, 1);
+
+        std::printf("%zu\t%zu\tnaive\t%.3g\n", threads, per_thread,
+            measure(naive_partition(view, threads), passes));
+        std::printf("%zu\t%zu\taligned\t%.3g\n", threads, per_thread,
+            measure(ext::partition(view, threads), passes));
+    }
+}
@@ -0,0 +1,164 @@
+// Measures producer-to-consumer throughput of a mutex-protected queue and
+// of spsc_ring_buffer used element by element and in bulk via regions.
+//
+// The producer generates consecutive integers and the consumer sums them,
+// so the work per element is negligible and the transfer cost dominates.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <array_view.hpp>
+#include <spsc_ring_buffer.hpp>
+
+namespace
+{
+    using element = std::uint32_t;
+
+    constexpr std::size_t total = std::size_t(1) << 23;
+    constexpr std::size_t capacity = 4096;
+
+    // Runs producer and consumer on two threads and returns elements per
+    // second.
+    template<typename P, typename C>
+    double measure(P producer, C consumer)
+    {
+        using clock = std::chrono::steady_clock;
+
+        auto const start = clock::now();
+        std::thread thread{producer};
+        consumer();
+        thread.join();
+        std::chrono::duration<double> const elapsed = clock::now() - start;
+        return static_cast<double>(total) / elapsed.count();
+    }
+
+    double mutex_queue_throughput(std::uint64_t& sum)
+    {
+        std::deque<element> queue;
+        std::mutex mutex;
+
+        return measure(
+            [&] {
+                for (std::size_t i = 0; i < total;) {
+                    std::unique_lock<std::mutex> lock{mutex};
+                    if (queue.size() < capacity) {
+                        queue.push_back(static_cast<element>(i++));
+                    } else {
+                        lock.unlock();
+                        std::this_thread::yield();
+                    }
+                }
+            },
+            [&] {
+                for (std::size_t received = 0; received < total;) {
+                    std::unique_lock<std::mutex> lock{mutex};
+                    if (!queue.empty()) {
+                        sum += queue.front();
+                        queue.pop_front();
+                        received++;
+                    } else {
+                        lock.unlock();
+                        std::this_thread::yield();
+                    }
+                }
+            });
+    }
+
+    double ring_element_throughput(std::uint64_t& sum)
+    {
+        ext::spsc_ring_buffer<element> ring{capacity};
+
+        return measure(
+            [&] {
+                for (std::size_t i = 0; i < total;) {
+                    if (ring.try_push(static_cast<element>(i))) {
+                        i++;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            },
+            [&] {
+                element value;
+                for (std::size_t received = 0; received < total;) {
+                    if (ring.try_pop(value)) {
+                        sum += value;
+                        received++;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+    }
+
+    double ring_bulk_throughput(std::uint64_t& sum)
+    {
+        ext::spsc_ring_buffer<element> ring{capacity};
+
+        auto const fill = [](ext::array_view<element> segment,
+                              std::size_t& next) {
+            for (auto& slot : segment) {
+                slot = static_cast<element>(next++);
+            }
+        };
+
+        return measure(
+            [&] {
+                for (std::size_t next = 0; next < total;) {
+                    auto space = ring.write_regions();
+                    if (space.empty()) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    auto const count = std::min(space.size(), total - next);
+                    space.first = space.first.first(
+                        std::min(count, space.first.size()));
+                    space.second =
+                        space.second.first(count - space.first.size());
+                    fill(space.first, next);
+                    fill(space.second, next);
+                    ring.commit_write(count);
+                }
+            },
+            [&] {
+                for (std::size_t received = 0; received < total;) {
+                    auto const data = ring.read_regions();
+                    if (data.empty()) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    for (auto const value : data.first) {
+                        sum += value;
+                    }
+                    for (auto const value : data.second) {
+                        sum += value;
+                    }
+                    ring.commit_read(data.size());
+                    received += data.size();
+                }
+            });
+    }
+}
+
+int main()
+{
+    std::uint64_t sum = 0;
+
+    std::printf("queue\telements\telements_per_second\n");
+    std::printf(
+        "mutex_deque\t%zu\t%.4g\n", total, mutex_queue_throughput(sum));
+    std::printf(
+        "spsc_element\t%zu\t%.4g\n", total, ring_element_throughput(sum));
+    std::printf(
+        "spsc_regions\t%zu\t%.4g\n", total, ring_bulk_throughput(sum));
+
+    // Every run transfers 0 + 1 + ... + (total - 1).
+    auto const expected = std::uint64_t(total) * (total - 1) / 2 * 3;
+    return sum == expected ? 0 : 1;
+}
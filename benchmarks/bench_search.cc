@@ -0,0 +1,83 @@
+// Compares std::lower_bound on a sorted array with single and batched
+// lookups of eytzinger_index, for tables from L2 cache to DRAM size.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <array_view.hpp>
+#include <eytzinger_index.hpp>
+
+namespace
+{
+    // Runs fn once and returns nanoseconds per query.
+    template<typename F>
+    double measure(std::size_t queries, F fn)
+    {
+        using clock = std::chrono::steady_clock;
+
+        auto const start = clock::now();
+        fn();
+        std::chrono::duration<double, std::nano> const elapsed =
+            clock::now() - start;
+        return elapsed.count() / double(queries);
+    }
+}
+
+int main()
+{
+    std::size_t const table_sizes[] = {
+        std::size_t(1) << 14,
+        std::size_t(1) << 18,
+        std::size_t(1) << 22,
+        std::size_t(1) << 25,
+    };
+    std::size_t const query_count = std::size_t(1) << 22;
+
+    std::mt19937 random;
+    std::uniform_int_distribution<std::uint32_t> dist;
+
+    std::vector<std::uint32_t> queries(query_count);
+    for (auto& query : queries) {
+        query = dist(random);
+    }
+    auto const query_view = ext::make_array_view(queries).as_const();
+    std::vector<std::size_t> results(query_count);
+    auto const result_view = ext::make_array_view(results);
+
+    std::printf("implementation\ttable_bytes\tns_per_query\n");
+
+    for (auto const size : table_sizes) {
+        std::vector<std::uint32_t> table(size);
+        for (auto& key : table) {
+            key = dist(random);
+        }
+        std::sort(table.begin(), table.end());
+        auto const index =
+            ext::make_eytzinger_index(ext::make_array_view(table));
+        auto const bytes = size * sizeof(std::uint32_t);
+
+        auto const std_ns = measure(query_count, [&] {
+            for (std::size_t i = 0; i < query_count; i++) {
+                results[i] = static_cast<std::size_t>(
+                    std::lower_bound(table.begin(), table.end(), queries[i])
+                    - table.begin());
+            }
+        });
+        auto const single_ns = measure(query_count, [&] {
+            for (std::size_t i = 0; i < query_count; i++) {
+                results[i] = index.lower_bound(queries[i]);
+            }
+        });
+        auto const batch_ns = measure(query_count,
+            [&] { index.lower_bound(query_view, result_view); });
+
+        std::printf("std::lower_bound\t%zu\t%.1f\n", bytes, std_ns);
+        std::printf("eytzinger\t%zu\t%.1f\n", bytes, single_ns);
+        std::printf("eytzinger_batch\t%zu\t%.1f\n", bytes, batch_ns);
+    }
+}
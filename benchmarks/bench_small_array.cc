@@ -0,0 +1,98 @@
+// Measures building a temporary array of a few elements, viewing it as an
+// array_view and consuming it, with std::vector and with small_array.
+//
+// Global operator new is replaced to count heap allocations per array.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include <array_view.hpp>
+#include <small_array.hpp>
+
+namespace
+{
+    std::size_t allocations = 0;
+}
+
+void* operator new(std::size_t size)
+{
+    allocations++;
+    if (auto const ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace
+{
+    using clock = std::chrono::steady_clock;
+
+    // A vector reserving room for the largest array up front, which still
+    // allocates once.
+    struct reserved_vector : std::vector<int>
+    {
+        reserved_vector()
+        {
+            reserve(64);
+        }
+    };
+
+    int consume(ext::array_view<int const> view)
+    {
+        int total = 0;
+        for (auto const value : view) {
+            total += value;
+        }
+        return total;
+    }
+
+    // Builds and consumes reps arrays of n elements with Container and
+    // prints a table row.
+    template<typename Container>
+    void measure(char const* name, std::size_t n)
+    {
+        std::size_t const reps = 2000000;
+        volatile int sink = 0;
+
+        auto const start_allocations = allocations;
+        auto const start = clock::now();
+        for (std::size_t rep = 0; rep < reps; rep++) {
+            Container array;
+            for (std::size_t i = 0; i < n; i++) {
+                array.push_back(static_cast<int>(rep + i));
+            }
+            sink = sink + consume(ext::make_array_view(array).as_const());
+        }
+        std::chrono::duration<double, std::nano> const elapsed =
+            clock::now() - start;
+
+        std::printf("%s\t%zu\t%.1f\t%.2f\n", name, n,
+            elapsed.count() / double(reps),
+            double(allocations - start_allocations) / double(reps));
+    }
+}
+
+int main()
+{
+    std::printf("container\telements\tns_per_array\tallocations_per_array\n");
+
+    for (std::size_t const n : {4, 16, 32, 64}) {
+        measure<std::vector<int>>("std::vector", n);
+        measure<reserved_vector>("std::vector+reserve", n);
+        measure<ext::small_array<int, 32>>("small_array<32>", n);
+    }
+}
@@ -0,0 +1,81 @@
+// Compares radix_sort and parallel_radix_sort with std::sort on random
+// uint64_t and float keys.
+//
+// Sizes go from 1e6 up to the maximum given as the first argument, 1e8 by
+// default. Sorting 1e9 uint64_t keys needs about 16 GB of memory.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <array_view.hpp>
+#include <array_view_sort.hpp>
+
+namespace
+{
+    // Runs fn on a fresh copy of input and returns the time in
+    // milliseconds. The copy is not timed.
+    template<typename T, typename F>
+    double measure(std::vector<T> const& input, std::vector<T>& work, F fn)
+    {
+        using clock = std::chrono::steady_clock;
+
+        std::copy(input.begin(), input.end(), work.begin());
+        auto const start = clock::now();
+        fn(ext::make_array_view(work));
+        std::chrono::duration<double, std::milli> const elapsed =
+            clock::now() - start;
+        return elapsed.count();
+    }
+
+    template<typename T, typename Dist>
+    void run(char const* type, std::size_t size, Dist dist)
+    {
+        std::mt19937_64 random{size};
+        std::vector<T> input(size);
+        for (auto& value : input) {
+            value = static_cast<T>(dist(random));
+        }
+        std::vector<T> work(size);
+        std::vector<T> scratch(size);
+        auto const scratch_view = ext::make_array_view(scratch);
+
+        auto const std_ms = measure(input, work, [](ext::array_view<T> v) {
+            std::sort(v.begin(), v.end());
+        });
+        auto const radix_ms = measure(input, work, [&](ext::array_view<T> v) {
+            ext::radix_sort(v, scratch_view);
+        });
+        auto const parallel_ms =
+            measure(input, work, [&](ext::array_view<T> v) {
+                ext::parallel_radix_sort(v, scratch_view);
+            });
+
+        std::printf("%s\t%zu\tstd::sort\t%.1f\n", type, size, std_ms);
+        std::printf("%s\t%zu\tradix_sort\t%.1f\n", type, size, radix_ms);
+        std::printf("%s\t%zu\tparallel_radix_sort\t%.1f\n", type, size,
+            parallel_ms);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t max_size = 100000000;
+    if (argc > 1) {
+        max_size = std::strtoull(argv[1], nullptr, 10);
+    }
+
+    std::printf("type\tsize\timplementation\tmilliseconds\n");
+
+    for (std::size_t size = 1000000; size <= max_size; size *= 10) {
+        run<std::uint64_t>("uint64", size,
+            std::uniform_int_distribution<std::uint64_t>{});
+        run<float>("float", size,
+            std::uniform_real_distribution<float>{-1e6f, 1e6f});
+    }
+}
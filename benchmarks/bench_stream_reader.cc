@@ -0,0 +1,158 @@
+// Measures reading a file in chunks and processing every record, once with
+// reading and processing serialized on one thread and once with
+// stream_reader reading ahead on a background thread.
+//
+// Usage: bench_stream_reader [file]
+//
+// Without an argument a temporary 256 MiB file is written first, so it is
+// most likely served from the page cache; pass a file that is not cached
+// to measure reads from the device.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <array_view.hpp>
+#include <stream_reader.hpp>
+
+namespace
+{
+    using clock = std::chrono::steady_clock;
+
+    // Some work per record, roughly as expensive as reading it.
+    std::uint64_t process(ext::array_view<std::uint64_t const> batch)
+    {
+        std::uint64_t total = 0;
+        for (auto value : batch) {
+            for (int round = 0; round < 4; round++) {
+                value ^= value >> 31;
+                value *= 0x9e3779b97f4a7c15u;
+            }
+            total += value;
+        }
+        return total;
+    }
+
+    std::string write_temporary(std::size_t bytes)
+    {
+        char path[] = "/tmp/bench_stream_reader_XXXXXX";
+        int const fd = ::mkstemp(path);
+        if (fd == -1) {
+            std::perror("mkstemp");
+            std::exit(1);
+        }
+        std::vector<std::uint64_t> chunk(std::size_t(1) << 17);
+        for (std::size_t i = 0; i < chunk.size(); i++) {
+            chunk[i] = i;
+        }
+        auto const chunk_bytes = chunk.size() * sizeof(std::uint64_t);
+        for (std::size_t written = 0; written < bytes;
+             written += chunk_bytes) {
+            if (::write(fd, chunk.data(), chunk_bytes)
+                != static_cast<ssize_t>(chunk_bytes)) {
+                std::perror("write");
+                std::exit(1);
+            }
+        }
+        ::close(fd);
+        return path;
+    }
+
+    void print_row(char const* mode, std::size_t buffers, std::size_t bytes,
+        double seconds, double stall_seconds, std::uint64_t checksum)
+    {
+        std::printf("%s\t%zu\t%zu\t%.0f\t%.3f\t%.3f\t%llx\n", mode, buffers,
+            bytes, double(bytes) / seconds / (1 << 20), seconds,
+            stall_seconds, static_cast<unsigned long long>(checksum));
+    }
+
+    // Reads and processes each chunk in turn on the calling thread.
+    void measure_serial(std::string const& path, std::size_t chunk_bytes)
+    {
+        int const fd = ::open(path.c_str(), O_RDONLY);
+        std::vector<std::uint64_t> buffer(
+            chunk_bytes / sizeof(std::uint64_t));
+        std::uint64_t checksum = 0;
+        std::size_t total = 0;
+        double read_seconds = 0;
+
+        auto const start = clock::now();
+        for (;;) {
+            auto const read_start = clock::now();
+            auto const n = ::pread(fd, buffer.data(), chunk_bytes,
+                static_cast<off_t>(total));
+            std::chrono::duration<double> const read_time =
+                clock::now() - read_start;
+            read_seconds += read_time.count();
+            if (n <= 0) {
+                break;
+            }
+            total += static_cast<std::size_t>(n);
+            checksum += process(ext::make_array_view(buffer.data(),
+                static_cast<std::size_t>(n) / sizeof(std::uint64_t)));
+        }
+        std::chrono::duration<double> const elapsed = clock::now() - start;
+        ::close(fd);
+
+        // Every read stalls the processing.
+        print_row(
+            "serial", 1, total, elapsed.count(), read_seconds, checksum);
+    }
+
+    void measure_stream(std::string const& path, std::size_t chunk_bytes,
+        std::size_t buffers)
+    {
+        ext::stream_options options;
+        options.chunk_bytes = chunk_bytes;
+        options.buffer_count = buffers;
+
+        auto const start = clock::now();
+        ext::stream_reader<std::uint64_t> reader{path, options};
+        std::uint64_t checksum = 0;
+        for (;;) {
+            auto const batch = reader.next();
+            if (batch.empty()) {
+                break;
+            }
+            checksum += process(batch);
+        }
+        std::chrono::duration<double> const elapsed = clock::now() - start;
+
+        auto const stats = reader.stats();
+        print_row("stream_reader", buffers, stats.bytes_read,
+            elapsed.count(), stats.stall_seconds, checksum);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t const chunk_bytes = std::size_t(1) << 20;
+
+    std::string path;
+    bool const temporary = argc < 2;
+    if (temporary) {
+        path = write_temporary(std::size_t(256) << 20);
+    } else {
+        path = argv[1];
+    }
+
+    std::printf(
+        "mode\tbuffers\tbytes\tmib_per_second\tseconds\tstall_seconds\t"
+        "checksum\n");
+
+    measure_serial(path, chunk_bytes);
+    measure_stream(path, chunk_bytes, 2);
+    measure_stream(path, chunk_bytes, 4);
+
+    if (temporary) {
+        std::remove(path.c_str());
+    }
+}
@@ -0,0 +1,107 @@
+// Compares moving minimum and moving sum computed by rescanning every window
+// with the incremental sliding_min and sliding_sum, and with a streaming
+// sliding_window fed in batches, for growing window lengths.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <array_view.hpp>
+#include <array_view_window.hpp>
+
+namespace
+{
+    // Runs fn once and returns nanoseconds per input element.
+    template<typename F>
+    double measure(std::size_t elements, F fn)
+    {
+        using clock = std::chrono::steady_clock;
+
+        auto const start = clock::now();
+        fn();
+        std::chrono::duration<double, std::nano> const elapsed =
+            clock::now() - start;
+        return elapsed.count() / double(elements);
+    }
+
+    void rescan_min(ext::array_view<double const> src, std::size_t length,
+        ext::array_view<double> dest)
+    {
+        for (std::size_t i = 0; i < dest.size(); i++) {
+            dest[i] = *std::min_element(
+                src.begin() + i, src.begin() + i + length);
+        }
+    }
+
+    void rescan_sum(ext::array_view<double const> src, std::size_t length,
+        ext::array_view<double> dest)
+    {
+        for (std::size_t i = 0; i < dest.size(); i++) {
+            dest[i] = std::accumulate(
+                src.begin() + i, src.begin() + i + length, 0.0);
+        }
+    }
+
+    void stream(ext::array_view<double const> src, std::size_t length,
+        ext::window_aggregate which, ext::array_view<double> dest)
+    {
+        std::size_t const batch_size = 4096;
+        ext::sliding_window<double> window{length};
+        std::size_t written = 0;
+        for (std::size_t offset = 0; offset < src.size();
+             offset += batch_size) {
+            auto const batch = src.subview(
+                offset, std::min(batch_size, src.size() - offset));
+            written += window.push(batch, which,
+                dest.drop_first(written).first(batch.size()));
+        }
+    }
+}
+
+int main()
+{
+    std::size_t const size = std::size_t(1) << 20;
+    std::size_t const lengths[] = {8, 64, 512};
+
+    std::mt19937 random;
+    std::normal_distribution<double> dist;
+    std::vector<double> values(size);
+    for (auto& value : values) {
+        value = dist(random);
+    }
+    auto const src = ext::make_array_view(values).as_const();
+    std::vector<double> output(size);
+
+    std::printf("aggregate\timplementation\twindow\tns_per_element\n");
+
+    for (auto const length : lengths) {
+        auto const dest = ext::make_array_view(output).first(
+            ext::window_count(size, length));
+
+        std::printf("min\trescan\t%zu\t%.2f\n", length, measure(size, [&] {
+            rescan_min(src, length, dest);
+        }));
+        std::printf("min\tsliding_min\t%zu\t%.2f\n", length,
+            measure(size, [&] { ext::sliding_min(src, length, dest); }));
+        std::printf("min\tsliding_window\t%zu\t%.2f\n", length,
+            measure(size, [&] {
+                stream(src, length, ext::window_aggregate::min,
+                    ext::make_array_view(output));
+            }));
+
+        std::printf("sum\trescan\t%zu\t%.2f\n", length, measure(size, [&] {
+            rescan_sum(src, length, dest);
+        }));
+        std::printf("sum\tsliding_sum\t%zu\t%.2f\n", length,
+            measure(size, [&] { ext::sliding_sum(src, length, dest); }));
+        std::printf("sum\tsliding_sum_compensated\t%zu\t%.2f\n", length,
+            measure(size, [&] {
+                ext::sliding_sum(
+                    src, length, dest, ext::summation::compensated);
+            }));
+    }
+}
@@ -0,0 +1,343 @@
+// eytzinger_index - Cache-friendly search index over a sorted array_view
+//
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_EYTZINGER_INDEX_HPP
+#define INCLUDED_EYTZINGER_INDEX_HPP
+
+#include <algorithm> // copy, is_sorted, min
+#include <cstddef> // ptrdiff_t, size_t
+#include <cstdint> // uintptr_t
+#include <stdexcept> // invalid_argument
+#include <type_traits> // remove_cv
+#include <utility> // move, swap
+#include <vector> // vector
+
+#include "array_view.hpp"
+
+namespace array_view_detail
+{
+    constexpr std::size_t search_cache_line = 64;
+
+    inline void prefetch(void const* ptr) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(ptr);
+#else
+        static_cast<void>(ptr);
+#endif
+    }
+
+    // Returns the number of trailing one bits of value.
+    inline unsigned trailing_ones(std::size_t value) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return value == static_cast<std::size_t>(-1)
+            ? static_cast<unsigned>(8 * sizeof value)
+            : static_cast<unsigned>(__builtin_ctzll(~value));
+#else
+        unsigned count = 0;
+        for (; value & 1; value >>= 1) {
+            count++;
+        }
+        return count;
+#endif
+    }
+
+    // Returns the number of bits needed to represent value.
+    inline unsigned bit_width(std::size_t value) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return value == 0
+            ? 0
+            : static_cast<unsigned>(8 * sizeof(unsigned long long))
+                - static_cast<unsigned>(__builtin_clzll(value));
+#else
+        unsigned width = 0;
+        for (; value != 0; value >>= 1) {
+            width++;
+        }
+        return width;
+#endif
+    }
+} // namespace array_view_detail
+
+namespace ext
+{
+    /// Read-only search index over a sorted array, answering lower_bound
+    /// queries with positions in the original array.
+    ///
+    /// The elements are copied into the Eytzinger (breadth-first binary
+    /// heap) order, in which the nodes visited by the first levels of every
+    /// search share a few cache lines, and the array is aligned so that the
+    /// 64 / sizeof(T) descendants four levels below a node (for 4-byte
+    /// keys) occupy a single cache line, which is prefetched while the
+    /// current level is compared. The search is branchless.
+    ///
+    /// The batched lower_bound() interleaves the searches of a group of
+    /// queries level by level, so that the cache misses of independent
+    /// queries overlap.
+    ///
+    /// The index takes sizeof(T) bytes per element and does not refer to
+    /// the original array after construction. Positions are computed from
+    /// the final node of a search, so no lookup table is touched.
+    template<typename T>
+    class eytzinger_index
+    {
+      public:
+        /// The type of the keys.
+        using value_type = typename std::remove_cv<T>::type;
+
+        /// The type of size and position values.
+        using size_type = std::size_t;
+
+        /// The number of queries processed together by the batched
+        /// lower_bound().
+        static constexpr size_type batch_size = 16;
+
+        /// The default constructor creates an empty index.
+        eytzinger_index() = default;
+
+        /// Builds an index of a sorted array.
+        ///
+        /// @exception std::invalid_argument if sorted is not sorted.
+        explicit eytzinger_index(array_view<value_type const> sorted)
+            : size_{sorted.size()}
+        {
+            if (!std::is_sorted(sorted.begin(), sorted.end())) {
+                throw std::invalid_argument("search keys are not sorted");
+            }
+
+            allocate_nodes();
+            size_type rank = 0;
+            build(sorted, 1, rank);
+        }
+
+        /// Copies an index. The copy is aligned on its own.
+        eytzinger_index(eytzinger_index const& other)
+        {
+            // Empty and moved-from indices have no nodes to copy.
+            if (other.keys_.empty()) {
+                return;
+            }
+            size_ = other.size_;
+            allocate_nodes();
+            std::copy(other.nodes(), other.nodes() + size_ + 1,
+                keys_.begin() + static_cast<std::ptrdiff_t>(offset_));
+        }
+
+        /// Moves an index, leaving other empty.
+        eytzinger_index(eytzinger_index&& other) noexcept
+        {
+            swap(other);
+        }
+
+        eytzinger_index& operator=(eytzinger_index const& other)
+        {
+            eytzinger_index{other}.swap(*this);
+            return *this;
+        }
+
+        eytzinger_index& operator=(eytzinger_index&& other) noexcept
+        {
+            eytzinger_index{std::move(other)}.swap(*this);
+            return *this;
+        }
+
+        /// Swaps the contents with other.
+        void swap(eytzinger_index& other) noexcept
+        {
+            using std::swap;
+            swap(size_, other.size_);
+            swap(offset_, other.offset_);
+            swap(keys_, other.keys_);
+        }
+
+        /// Returns the number of indexed keys.
+        size_type size() const noexcept
+        {
+            return size_;
+        }
+
+        /// Tests if the index is empty.
+        bool empty() const noexcept
+        {
+            return size_ == 0;
+        }
+
+        /// Returns the position of the first key not less than value in the
+        /// original array, or size() if there is no such key.
+        size_type lower_bound(value_type const& value) const noexcept
+        {
+            auto const keys = nodes();
+            size_type k = 1;
+            while (k <= size_) {
+                array_view_detail::prefetch(keys + prefetch_node(k));
+                k = 2 * k + (keys[k] < value);
+            }
+            return rank_of(k >> (array_view_detail::trailing_ones(k) + 1));
+        }
+
+        /// Stores lower_bound(queries[i]) to results[i] for all i. Queries
+        /// are searched in interleaved groups of batch_size.
+        ///
+        /// @exception std::invalid_argument if the sizes of the views differ.
+        void lower_bound(array_view<value_type const> queries,
+            array_view<size_type> results) const
+        {
+            if (queries.size() != results.size()) {
+                throw std::invalid_argument("array_view sizes differ");
+            }
+
+            auto const keys = nodes();
+            auto const height = array_view_detail::bit_width(size_);
+
+            for (size_type base = 0; base < queries.size();
+                 base += batch_size) {
+                auto const count =
+                    std::min(batch_size, queries.size() - base);
+                auto const group = queries.subview(base, count);
+                size_type ks[batch_size];
+                for (size_type j = 0; j < count; j++) {
+                    ks[j] = 1;
+                }
+
+                for (unsigned level = 0; level < height; level++) {
+                    for (size_type j = 0; j < count; j++) {
+                        auto const k = ks[j];
+                        if (k <= size_) {
+                            array_view_detail::prefetch(
+                                keys + prefetch_node(k));
+                            ks[j] = 2 * k + (keys[k] < group[j]);
+                        }
+                    }
+                }
+
+                for (size_type j = 0; j < count; j++) {
+                    auto const k = ks[j];
+                    results[base + j] = rank_of(
+                        k >> (array_view_detail::trailing_ones(k) + 1));
+                }
+            }
+        }
+
+      private:
+        // The number of nodes in a cache line, whose first descendant this
+        // many levels down is prefetched.
+        static constexpr size_type nodes_per_line =
+            sizeof(value_type) < array_view_detail::search_cache_line
+            ? array_view_detail::search_cache_line / sizeof(value_type)
+            : 1;
+
+        value_type const* nodes() const noexcept
+        {
+            return keys_.data() + offset_;
+        }
+
+        // Allocates room for size_ + 1 nodes and places node 0 at a cache
+        // line boundary when the element size allows it. Node 0 is unused,
+        // so nodes are indexed from 1 as in a heap.
+        void allocate_nodes()
+        {
+            constexpr size_type line = array_view_detail::search_cache_line;
+            auto const slack = line / sizeof(value_type) + 1;
+            keys_.assign(size_ + 1 + slack, value_type());
+            auto const address =
+                reinterpret_cast<std::uintptr_t>(keys_.data());
+            auto const padding = (line - address % line) % line;
+            offset_ = padding % sizeof(value_type) == 0
+                ? padding / sizeof(value_type)
+                : 0;
+        }
+
+        // Returns the position in the sorted array of the key at node k, or
+        // size_ for node 0. In a perfect tree of height h the in-order rank
+        // of node j + 2^d at depth d is (2j + 1) 2^(h - 1 - d) - 1. The
+        // missing nodes of the last level occupy the even ranks from
+        // 2 (size_ - 2^(h - 1) + 1) on, and the ones before the node are
+        // subtracted.
+        size_type rank_of(size_type k) const noexcept
+        {
+            if (k == 0) {
+                return size_;
+            }
+            auto const height = array_view_detail::bit_width(size_);
+            auto const depth = array_view_detail::bit_width(k) - 1;
+            auto const first = size_type(1) << depth;
+            auto const perfect =
+                ((2 * (k - first) + 1) << (height - 1 - depth)) - 1;
+            auto const last_level =
+                size_ - ((size_type(1) << (height - 1)) - 1);
+            auto const leaves_before = (perfect + 1) / 2;
+            return leaves_before > last_level
+                ? perfect - (leaves_before - last_level)
+                : perfect;
+        }
+
+        // Returns the first descendant of node k in the cache line fetched
+        // ahead, clamped to the array.
+        size_type prefetch_node(size_type k) const noexcept
+        {
+            return std::min(k * nodes_per_line, size_);
+        }
+
+        // Fills the subtree rooted at node k with the in-order sequence of
+        // sorted starting at rank.
+        void build(array_view<value_type const> sorted, size_type k,
+            size_type& rank)
+        {
+            if (k > size_) {
+                return;
+            }
+            build(sorted, 2 * k, rank);
+            keys_[offset_ + k] = sorted[rank];
+            rank++;
+            build(sorted, 2 * k + 1, rank);
+        }
+
+        size_type size_ = 0;
+        size_type offset_ = 0;
+        std::vector<value_type> keys_;
+    };
+
+    template<typename T>
+    constexpr std::size_t eytzinger_index<T>::batch_size;
+
+    template<typename T>
+    constexpr std::size_t eytzinger_index<T>::nodes_per_line;
+
+    /// Builds an eytzinger_index of a sorted array.
+    ///
+    /// @exception std::invalid_argument if sorted is not sorted.
+    template<typename T>
+    eytzinger_index<typename std::remove_cv<T>::type> make_eytzinger_index(
+        array_view<T> sorted)
+    {
+        return eytzinger_index<typename std::remove_cv<T>::type>{sorted};
+    }
+} // namespace ext
+
+#endif // INCLUDED_EYTZINGER_INDEX_HPP
@@ -0,0 +1,662 @@
+// indirect_view - View of array_view elements selected by an index array
+//
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_INDIRECT_VIEW_HPP
+#define INCLUDED_INDIRECT_VIEW_HPP
+
+#include <cstddef> // ptrdiff_t, size_t
+#include <cstdint> // int32_t, uint32_t
+#include <cstring> // memcpy
+#include <iterator> // random_access_iterator_tag, reverse_iterator
+#include <stdexcept> // invalid_argument, out_of_range
+#include <type_traits> // enable_if, integral_constant, is_same,
+                       // is_trivially_copyable, remove_cv
+
+#include "array_view.hpp"
+#include "array_view_simd.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) \
+    && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define ARRAY_VIEW_GATHER_X86 1
+#else
+#define ARRAY_VIEW_GATHER_X86 0
+#endif
+
+namespace array_view_detail
+{
+    // Tag of constructors skipping the validation of indices.
+    struct unchecked_indices
+    {
+    };
+} // namespace array_view_detail
+
+namespace ext
+{
+    /// Random access iterator over the elements of an array selected by an
+    /// index array.
+    template<typename T>
+    class indirect_iterator
+    {
+      public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename std::remove_cv<T>::type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        /// The default constructor creates a singular iterator.
+        indirect_iterator() noexcept = default;
+
+        /// This constructor creates an iterator pointing to
+        /// data[*index].
+        indirect_iterator(pointer data, std::uint32_t const* index) noexcept
+            : data_{data}
+            , index_{index}
+        {
+        }
+
+        /// A mutable iterator is implicitly convertible to a read-only one.
+        operator indirect_iterator<T const>() const noexcept
+        {
+            return {data_, index_};
+        }
+
+        reference operator*() const noexcept
+        {
+            return data_[*index_];
+        }
+
+        pointer operator->() const noexcept
+        {
+            return data_ + *index_;
+        }
+
+        reference operator[](difference_type n) const noexcept
+        {
+            return data_[index_[n]];
+        }
+
+        indirect_iterator& operator++() noexcept
+        {
+            ++index_;
+            return *this;
+        }
+
+        indirect_iterator operator++(int) noexcept
+        {
+            auto const copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        indirect_iterator& operator--() noexcept
+        {
+            --index_;
+            return *this;
+        }
+
+        indirect_iterator operator--(int) noexcept
+        {
+            auto const copy = *this;
+            --*this;
+            return copy;
+        }
+
+        indirect_iterator& operator+=(difference_type n) noexcept
+        {
+            index_ += n;
+            return *this;
+        }
+
+        indirect_iterator& operator-=(difference_type n) noexcept
+        {
+            index_ -= n;
+            return *this;
+        }
+
+        friend indirect_iterator operator+(
+            indirect_iterator it, difference_type n) noexcept
+        {
+            return it += n;
+        }
+
+        friend indirect_iterator operator+(
+            difference_type n, indirect_iterator it) noexcept
+        {
+            return it += n;
+        }
+
+        friend indirect_iterator operator-(
+            indirect_iterator it, difference_type n) noexcept
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(indirect_iterator const& lhs,
+            indirect_iterator const& rhs) noexcept
+        {
+            return lhs.index_ - rhs.index_;
+        }
+
+        friend bool operator==(indirect_iterator const& lhs,
+            indirect_iterator const& rhs) noexcept
+        {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(indirect_iterator const& lhs,
+            indirect_iterator const& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(indirect_iterator const& lhs,
+            indirect_iterator const& rhs) noexcept
+        {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(indirect_iterator const& lhs,
+            indirect_iterator const& rhs) noexcept
+        {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(indirect_iterator const& lhs,
+            indirect_iterator const& rhs) noexcept
+        {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(indirect_iterator const& lhs,
+            indirect_iterator const& rhs) noexcept
+        {
+            return !(lhs < rhs);
+        }
+
+      private:
+        pointer data_ = nullptr;
+        std::uint32_t const* index_ = nullptr;
+    };
+
+    /// Lightweight view of the elements of an array selected by an array of
+    /// indices, such as the rows picked by a query.
+    ///
+    /// The view does not own the data or the indices. The i-th element of
+    /// the view is data[indices[i]], so iterating the view visits the
+    /// selected elements in index order without copying them. Indices may
+    /// repeat. They are validated once on construction.
+    template<typename T>
+    class indirect_view
+    {
+      public:
+        /// The non-qualified type of the elements.
+        using value_type = typename std::remove_cv<T>::type;
+
+        /// The type of a pointer to an element.
+        using pointer = T*;
+
+        /// The type of a reference to an element.
+        using reference = T&;
+
+        /// The type of size and index values.
+        using size_type = std::size_t;
+
+        /// The type of the indices.
+        using index_type = std::uint32_t;
+
+        /// The type of iterators. Guaranteed to be a random access iterator.
+        using iterator = indirect_iterator<T>;
+
+        /// The type of reverse iterators. Guaranteed to be a random access
+        /// iterator.
+        using reverse_iterator = std::reverse_iterator<iterator>;
+
+        /// The type of read-only indirect_view with the same value_type.
+        using const_indirect_view = indirect_view<T const>;
+
+        /// The default constructor creates an empty view.
+        indirect_view() = default;
+
+        /// Creates a view of data[indices[0]], data[indices[1]], ...
+        ///
+        /// @exception std::out_of_range if an index is out of the bounds of
+        /// data.
+        indirect_view(
+            array_view<T> data, array_view<index_type const> indices)
+            : data_{data}
+            , indices_{indices}
+        {
+            for (auto const index : indices) {
+                if (index >= data.size()) {
+                    throw std::out_of_range(
+                        "indirect_view index out-of-bounds");
+                }
+            }
+        }
+
+        /// Tests if the view is empty.
+        bool empty() const noexcept
+        {
+            return indices_.empty();
+        }
+
+        /// Returns the number of selected elements.
+        size_type size() const noexcept
+        {
+            return indices_.size();
+        }
+
+        /// Returns the underlying array.
+        array_view<T> data() const noexcept
+        {
+            return data_;
+        }
+
+        /// Returns the indices of the selected elements.
+        array_view<index_type const> indices() const noexcept
+        {
+            return indices_;
+        }
+
+        /// Returns a reference to the first selected element. The behavior
+        /// is undefined if the view is empty.
+        reference front() const noexcept
+        {
+            return operator[](0);
+        }
+
+        /// Returns a reference to the last selected element. The behavior is
+        /// undefined if the view is empty.
+        reference back() const noexcept
+        {
+            return operator[](size() - 1);
+        }
+
+        /// Returns a reference to the idx-th selected element. The behavior
+        /// is undefined if the index is out of bounds.
+        reference operator[](size_type idx) const noexcept
+        {
+            return data_.data()[indices_[idx]];
+        }
+
+        /// Returns a reference to the idx-th selected element.
+        ///
+        /// @exception std::out_of_range if the index is out of bounds.
+        reference at(size_type idx) const
+        {
+            if (idx >= size()) {
+                throw std::out_of_range("indirect_view access out-of-bounds");
+            }
+            return operator[](idx);
+        }
+
+        /// Returns an iterator to the beginning.
+        iterator begin() const noexcept
+        {
+            return {data_.data(), indices_.data()};
+        }
+
+        /// Returns an iterator to the end.
+        iterator end() const noexcept
+        {
+            return {data_.data(), indices_.data() + indices_.size()};
+        }
+
+        /// Returns a reverse iterator to the reverse beginning.
+        reverse_iterator rbegin() const noexcept
+        {
+            return reverse_iterator{end()};
+        }
+
+        /// Returns a reverse iterator to the reverse end.
+        reverse_iterator rend() const noexcept
+        {
+            return reverse_iterator{begin()};
+        }
+
+        /// Returns a read-only view of the same elements.
+        const_indirect_view as_const() const noexcept
+        {
+            return *this;
+        }
+
+        /// A view is always implicitly convertible to a read-only view.
+        operator const_indirect_view() const noexcept
+        {
+            return const_indirect_view{
+                data_, indices_, array_view_detail::unchecked_indices{}};
+        }
+
+        /// Swaps the viewed elements.
+        void swap(indirect_view& other) noexcept
+        {
+            auto const this_copy = *this;
+            *this = other;
+            other = this_copy;
+        }
+
+        /// Returns a view of the selection with given region.
+        indirect_view subview(size_type offset, size_type count) const
+            noexcept
+        {
+            return {data_, indices_.subview(offset, count),
+                array_view_detail::unchecked_indices{}};
+        }
+
+        /// Returns a view of the first count selected elements.
+        indirect_view first(size_type count) const noexcept
+        {
+            return subview(0, count);
+        }
+
+        /// Returns a view of the last count selected elements.
+        indirect_view last(size_type count) const noexcept
+        {
+            return subview(size() - count, count);
+        }
+
+        /// Returns a view of the selection except the first count elements.
+        indirect_view drop_first(size_type count) const noexcept
+        {
+            return subview(count, size() - count);
+        }
+
+        /// Returns a view of the selection except the last count elements.
+        indirect_view drop_last(size_type count) const noexcept
+        {
+            return subview(0, size() - count);
+        }
+
+      private:
+        template<typename>
+        friend class indirect_view;
+
+        indirect_view(array_view<T> data,
+            array_view<index_type const> indices,
+            array_view_detail::unchecked_indices) noexcept
+            : data_{data}
+            , indices_{indices}
+        {
+        }
+
+        array_view<T> data_;
+        array_view<index_type const> indices_;
+    };
+
+    /// Creates an indirect_view of the elements of data selected by indices.
+    ///
+    /// @exception std::out_of_range if an index is out of the bounds of
+    /// data.
+    template<typename T>
+    indirect_view<T> make_indirect_view(
+        array_view<T> data, array_view<std::uint32_t const> indices)
+    {
+        return indirect_view<T>{data, indices};
+    }
+} // namespace ext
+
+namespace array_view_detail
+{
+    using ext::simd::isa;
+
+    // Tests if T can be moved by hardware gather and scatter instructions,
+    // which handle 4- and 8-byte lanes.
+    template<typename T>
+    struct is_gatherable
+        : std::integral_constant<bool,
+              ARRAY_VIEW_GATHER_X86 && std::is_trivially_copyable<T>::value
+                  && (sizeof(T) == 4 || sizeof(T) == 8)>
+    {
+    };
+
+    template<typename T>
+    void gather_scalar(T* dest, T const* data, std::uint32_t const* indices,
+        std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; i++) {
+            dest[i] = data[indices[i]];
+        }
+    }
+
+    template<typename T>
+    void scatter_scalar(T* data, std::uint32_t const* indices, T const* src,
+        std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; i++) {
+            data[indices[i]] = src[i];
+        }
+    }
+
+#if ARRAY_VIEW_GATHER_X86
+
+    // The gather and scatter instructions take signed 32-bit indices, so
+    // the kernels are used only for arrays of at most 2^31 elements.
+    constexpr std::size_t max_gather_size = std::size_t(1) << 31;
+
+    __attribute__((target("avx2"))) inline void gather_avx2(void* dest,
+        void const* data, std::uint32_t const* indices, std::size_t count,
+        std::size_t size)
+    {
+        auto out = static_cast<unsigned char*>(dest);
+        std::size_t i = 0;
+        if (size == 4) {
+            auto const base = static_cast<int const*>(data);
+            for (; i + 8 <= count; i += 8, out += 32) {
+                __m256i const index = _mm256_loadu_si256(
+                    reinterpret_cast<__m256i const*>(indices + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+                    _mm256_i32gather_epi32(base, index, 4));
+            }
+        } else {
+            auto const base = static_cast<long long const*>(data);
+            for (; i + 4 <= count; i += 4, out += 32) {
+                __m128i const index = _mm_loadu_si128(
+                    reinterpret_cast<__m128i const*>(indices + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+                    _mm256_i32gather_epi64(base, index, 8));
+            }
+        }
+        for (; i < count; i++, out += size) {
+            std::memcpy(out,
+                static_cast<unsigned char const*>(data) + indices[i] * size,
+                size);
+        }
+    }
+
+    // GCC implements the AVX-512 gather and scatter intrinsics as macros
+    // without optimization, and their internal mask conversion triggers
+    // -Wsign-conversion. Gathers take an explicit zero source since the
+    // unmasked intrinsics read an undefined vector.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+
+    __attribute__((target("avx512f"))) inline void gather_avx512(void* dest,
+        void const* data, std::uint32_t const* indices, std::size_t count,
+        std::size_t size)
+    {
+        auto out = static_cast<unsigned char*>(dest);
+        std::size_t i = 0;
+        if (size == 4) {
+            for (; i + 16 <= count; i += 16, out += 64) {
+                __m512i const index = _mm512_loadu_si512(indices + i);
+                _mm512_storeu_si512(out,
+                    _mm512_mask_i32gather_epi32(
+                        _mm512_setzero_si512(), 0xffff, index, data, 4));
+            }
+        } else {
+            for (; i + 8 <= count; i += 8, out += 64) {
+                __m256i const index = _mm256_loadu_si256(
+                    reinterpret_cast<__m256i const*>(indices + i));
+                _mm512_storeu_si512(out,
+                    _mm512_mask_i32gather_epi64(
+                        _mm512_setzero_si512(), 0xff, index, data, 8));
+            }
+        }
+        for (; i < count; i++, out += size) {
+            std::memcpy(out,
+                static_cast<unsigned char const*>(data) + indices[i] * size,
+                size);
+        }
+    }
+
+    // Lanes with equal indices are written in lane order, so the last
+    // write wins as in the scalar loop.
+    __attribute__((target("avx512f"))) inline void scatter_avx512(
+        void* data, std::uint32_t const* indices, void const* src,
+        std::size_t count, std::size_t size)
+    {
+        auto in = static_cast<unsigned char const*>(src);
+        std::size_t i = 0;
+        if (size == 4) {
+            for (; i + 16 <= count; i += 16, in += 64) {
+                __m512i const index = _mm512_loadu_si512(indices + i);
+                _mm512_i32scatter_epi32(
+                    data, index, _mm512_loadu_si512(in), 4);
+            }
+        } else {
+            for (; i + 8 <= count; i += 8, in += 64) {
+                __m256i const index = _mm256_loadu_si256(
+                    reinterpret_cast<__m256i const*>(indices + i));
+                _mm512_i32scatter_epi64(
+                    data, index, _mm512_loadu_si512(in), 8);
+            }
+        }
+        for (; i < count; i++, in += size) {
+            std::memcpy(
+                static_cast<unsigned char*>(data) + indices[i] * size, in,
+                size);
+        }
+    }
+
+#pragma GCC diagnostic pop
+
+    template<typename T>
+    void gather(std::true_type, isa level, T* dest, T const* data,
+        std::size_t data_size, std::uint32_t const* indices,
+        std::size_t count)
+    {
+        auto const best = ext::simd::best_isa();
+        if (data_size <= max_gather_size) {
+            switch (level < best ? level : best) {
+            case isa::avx512:
+                return gather_avx512(dest, data, indices, count, sizeof(T));
+            case isa::avx2:
+                return gather_avx2(dest, data, indices, count, sizeof(T));
+            default:
+                break;
+            }
+        }
+        gather_scalar(dest, data, indices, count);
+    }
+
+    template<typename T>
+    void scatter(std::true_type, isa level, T* data, std::size_t data_size,
+        std::uint32_t const* indices, T const* src, std::size_t count)
+    {
+        auto const best = ext::simd::best_isa();
+        if (data_size <= max_gather_size
+            && (level < best ? level : best) == isa::avx512) {
+            return scatter_avx512(data, indices, src, count, sizeof(T));
+        }
+        scatter_scalar(data, indices, src, count);
+    }
+
+#endif // ARRAY_VIEW_GATHER_X86
+
+    template<typename T>
+    void gather(std::false_type, isa, T* dest, T const* data, std::size_t,
+        std::uint32_t const* indices, std::size_t count)
+    {
+        gather_scalar(dest, data, indices, count);
+    }
+
+    template<typename T>
+    void scatter(std::false_type, isa, T* data, std::size_t,
+        std::uint32_t const* indices, T const* src, std::size_t count)
+    {
+        scatter_scalar(data, indices, src, count);
+    }
+} // namespace array_view_detail
+
+namespace ext
+{
+    /// Copies the selected elements of src to dest in order. 4- and 8-byte
+    /// trivially copyable elements are loaded with AVX2 or AVX-512 gather
+    /// instructions where available.
+    ///
+    /// @param dest     The contiguous destination.
+    /// @param src      The selected elements to copy.
+    /// @param level    The instruction set to use at most. The best one
+    ///                 supported by the CPU is used by default.
+    ///
+    /// @exception std::invalid_argument if the sizes differ.
+    template<typename T, typename U,
+        typename = typename std::enable_if<std::is_same<T,
+            typename std::remove_cv<U>::type>::value>::type>
+    void gather(array_view<T> dest, indirect_view<U> src,
+        simd::isa level = simd::best_isa())
+    {
+        if (dest.size() != src.size()) {
+            throw std::invalid_argument("array_view sizes differ");
+        }
+        array_view_detail::gather(array_view_detail::is_gatherable<T>{},
+            level, dest.data(), src.data().data(), src.data().size(),
+            src.indices().data(), src.size());
+    }
+
+    /// Copies the elements of src to the selected elements of dest in
+    /// order. If an index repeats, the element is assigned the last
+    /// corresponding value of src. 4- and 8-byte trivially copyable
+    /// elements are stored with AVX-512 scatter instructions where
+    /// available.
+    ///
+    /// @param dest     The selected elements to assign.
+    /// @param src      The contiguous source.
+    /// @param level    The instruction set to use at most. The best one
+    ///                 supported by the CPU is used by default.
+    ///
+    /// @exception std::invalid_argument if the sizes differ.
+    template<typename T, typename U,
+        typename = typename std::enable_if<std::is_same<T,
+            typename std::remove_cv<U>::type>::value>::type>
+    void scatter(indirect_view<T> dest, array_view<U> src,
+        simd::isa level = simd::best_isa())
+    {
+        if (dest.size() != src.size()) {
+            throw std::invalid_argument("array_view sizes differ");
+        }
+        array_view_detail::scatter(array_view_detail::is_gatherable<T>{},
+            level, dest.data().data(), dest.data().size(),
+            dest.indices().data(), src.data(), src.size());
+    }
+} // namespace ext
+
+#undef ARRAY_VIEW_GATHER_X86
+
+#endif // INCLUDED_INDIRECT_VIEW_HPP
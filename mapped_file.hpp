@@ -0,0 +1,358 @@
+// mapped_file - Memory-mapped file exposed as array_view
+//
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_MAPPED_FILE_HPP
+#define INCLUDED_MAPPED_FILE_HPP
+
+#include <cerrno> // errno
+#include <cstddef> // size_t
+#include <stdexcept> // invalid_argument, out_of_range
+#include <string> // string
+#include <system_error> // system_error, system_category
+#include <type_traits> // is_trivially_copyable
+#include <utility> // swap
+
+#include <fcntl.h> // open, O_RDONLY, O_RDWR
+#include <sys/mman.h> // mmap, munmap, madvise, msync
+#include <sys/stat.h> // fstat
+#include <unistd.h> // close, sysconf
+
+#include "aligned_array_view.hpp"
+#include "array_view.hpp"
+
+namespace array_view_detail
+{
+    [[noreturn]] inline void throw_errno(char const* what)
+    {
+        throw std::system_error(errno, std::system_category(), what);
+    }
+
+    // Closes a file descriptor on scope exit.
+    class fd_guard
+    {
+      public:
+        explicit fd_guard(int fd) noexcept
+            : fd_{fd}
+        {
+        }
+
+        ~fd_guard()
+        {
+            ::close(fd_);
+        }
+
+        fd_guard(fd_guard const&) = delete;
+        fd_guard& operator=(fd_guard const&) = delete;
+
+        int get() const noexcept
+        {
+            return fd_;
+        }
+
+      private:
+        int fd_;
+    };
+
+    inline std::size_t page_size()
+    {
+        static std::size_t const size =
+            static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        return size;
+    }
+} // namespace array_view_detail
+
+namespace ext
+{
+    /// Access mode of a file mapping.
+    enum class map_mode
+    {
+        /// Pages are mapped read-only.
+        read_only,
+
+        /// Pages are mapped shared and writable. Modifications are written
+        /// back to the file.
+        read_write,
+    };
+
+    /// Expected access pattern passed to the kernel via madvise(2).
+    enum class map_advice
+    {
+        normal,
+        sequential,
+        random,
+        willneed,
+        dontneed,
+    };
+
+    /// Owner of a memory-mapped region of a file (POSIX only).
+    ///
+    /// The mapped bytes are accessed through typed array views, so large
+    /// binary arrays can be used in place without reading them into memory
+    /// first. Pages are loaded on first access.
+    ///
+    /// @code
+    /// ext::mapped_file file{"points.bin"};
+    /// file.advise(ext::map_advice::sequential);
+    /// ext::array_view<point const> points = file.view<point>();
+    /// @endcode
+    class mapped_file
+    {
+      public:
+        /// Special length value denoting the rest of the file.
+        static constexpr std::size_t whole = static_cast<std::size_t>(-1);
+
+        /// Creates an empty mapping.
+        mapped_file() = default;
+
+        /// Maps length bytes of a file starting at given byte offset. The
+        /// offset need not be a multiple of the page size.
+        ///
+        /// @exception std::system_error if the file cannot be opened or
+        /// mapped.
+        /// @exception std::out_of_range if the range exceeds the file.
+        explicit mapped_file(std::string const& path,
+            map_mode mode = map_mode::read_only, std::size_t offset = 0,
+            std::size_t length = whole)
+            : mode_{mode}
+        {
+            bool const writable = mode == map_mode::read_write;
+
+            array_view_detail::fd_guard fd{
+                ::open(path.c_str(), writable ? O_RDWR : O_RDONLY)};
+            if (fd.get() == -1) {
+                array_view_detail::throw_errno("cannot open file");
+            }
+
+            struct stat status;
+            if (::fstat(fd.get(), &status) == -1) {
+                array_view_detail::throw_errno("cannot stat file");
+            }
+            auto const file_size = static_cast<std::size_t>(status.st_size);
+
+            if (offset > file_size) {
+                throw std::out_of_range("offset exceeds file size");
+            }
+            if (length == whole) {
+                length = file_size - offset;
+            }
+            if (length > file_size - offset) {
+                throw std::out_of_range("length exceeds file size");
+            }
+            if (length == 0) {
+                return;
+            }
+
+            // mmap requires a page-aligned offset.
+            auto const slack = offset % array_view_detail::page_size();
+            auto const map_size = length + slack;
+            void* const addr = ::mmap(nullptr, map_size,
+                writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                writable ? MAP_SHARED : MAP_PRIVATE, fd.get(),
+                static_cast<off_t>(offset - slack));
+            if (addr == MAP_FAILED) {
+                array_view_detail::throw_errno("cannot map file");
+            }
+
+            map_addr_ = addr;
+            map_size_ = map_size;
+            data_ = static_cast<unsigned char*>(addr) + slack;
+            size_ = length;
+        }
+
+        ~mapped_file()
+        {
+            close();
+        }
+
+        mapped_file(mapped_file const&) = delete;
+        mapped_file& operator=(mapped_file const&) = delete;
+
+        mapped_file(mapped_file&& other) noexcept
+        {
+            swap(other);
+        }
+
+        mapped_file& operator=(mapped_file&& other) noexcept
+        {
+            mapped_file{std::move(other)}.swap(*this);
+            return *this;
+        }
+
+        /// Unmaps the region. Does nothing if nothing is mapped.
+        void close() noexcept
+        {
+            if (map_addr_) {
+                ::munmap(map_addr_, map_size_);
+            }
+            map_addr_ = nullptr;
+            map_size_ = 0;
+            data_ = nullptr;
+            size_ = 0;
+        }
+
+        /// Returns the access mode.
+        map_mode mode() const noexcept
+        {
+            return mode_;
+        }
+
+        /// Returns the number of mapped bytes.
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        /// Tests if no byte is mapped.
+        bool empty() const noexcept
+        {
+            return size_ == 0;
+        }
+
+        /// Returns a pointer to the first mapped byte.
+        unsigned char const* data() const noexcept
+        {
+            return data_;
+        }
+
+        /// Returns a view of the mapped bytes.
+        array_view<unsigned char const> bytes() const noexcept
+        {
+            return {data_, size_};
+        }
+
+        /// Returns a view of the mapped bytes as an array of T.
+        ///
+        /// @exception std::invalid_argument if the mapped size is not a
+        /// multiple of sizeof(T) or the data is not aligned for T.
+        template<typename T>
+        array_view<T const> view() const
+        {
+            static_assert(std::is_trivially_copyable<T>::value,
+                "mapped type must be trivially copyable");
+            return {checked_data<T const>(), size_ / sizeof(T)};
+        }
+
+        /// Returns a writable view of the mapped bytes as an array of T.
+        ///
+        /// @exception std::invalid_argument if the mapping is read-only, the
+        /// mapped size is not a multiple of sizeof(T) or the data is not
+        /// aligned for T.
+        template<typename T>
+        array_view<T> writable_view()
+        {
+            static_assert(std::is_trivially_copyable<T>::value,
+                "mapped type must be trivially copyable");
+            if (mode_ != map_mode::read_write) {
+                throw std::invalid_argument("file is mapped read-only");
+            }
+            return {checked_data<T>(), size_ / sizeof(T)};
+        }
+
+        /// Gives the kernel a hint on the access pattern of the mapping.
+        ///
+        /// @exception std::system_error if madvise fails.
+        void advise(map_advice advice)
+        {
+            if (!map_addr_) {
+                return;
+            }
+            auto const native = native_advice(advice);
+            if (::madvise(map_addr_, map_size_, native) == -1) {
+                array_view_detail::throw_errno("madvise failed");
+            }
+        }
+
+        /// Writes modified pages back to the file and waits for completion.
+        ///
+        /// @exception std::system_error if msync fails.
+        void flush()
+        {
+            if (!map_addr_) {
+                return;
+            }
+            if (::msync(map_addr_, map_size_, MS_SYNC) == -1) {
+                array_view_detail::throw_errno("msync failed");
+            }
+        }
+
+        /// Swaps the mapping with other.
+        void swap(mapped_file& other) noexcept
+        {
+            using std::swap;
+            swap(mode_, other.mode_);
+            swap(map_addr_, other.map_addr_);
+            swap(map_size_, other.map_size_);
+            swap(data_, other.data_);
+            swap(size_, other.size_);
+        }
+
+      private:
+        template<typename T>
+        T* checked_data() const
+        {
+            if (size_ % sizeof(T) != 0) {
+                throw std::invalid_argument(
+                    "mapped size is not a multiple of element size");
+            }
+            if (!array_view_detail::is_aligned(data_, alignof(T))) {
+                throw std::invalid_argument("mapped data is misaligned");
+            }
+            return reinterpret_cast<T*>(data_);
+        }
+
+        static int native_advice(map_advice advice) noexcept
+        {
+            switch (advice) {
+              case map_advice::sequential:
+                return MADV_SEQUENTIAL;
+              case map_advice::random:
+                return MADV_RANDOM;
+              case map_advice::willneed:
+                return MADV_WILLNEED;
+              case map_advice::dontneed:
+                return MADV_DONTNEED;
+              case map_advice::normal:
+                break;
+            }
+            return MADV_NORMAL;
+        }
+
+        map_mode mode_ = map_mode::read_only;
+        void* map_addr_ = nullptr;
+        std::size_t map_size_ = 0;
+        unsigned char* data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+
+    /// Swaps two mappings.
+    inline void swap(mapped_file& a, mapped_file& b) noexcept
+    {
+        a.swap(b);
+    }
+} // namespace ext
+
+#endif // INCLUDED_MAPPED_FILE_HPP
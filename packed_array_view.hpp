@@ -0,0 +1,776 @@
+// packed_array_view - View of bit-packed unsigned integers in 64-bit words
+//
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_PACKED_ARRAY_VIEW_HPP
+#define INCLUDED_PACKED_ARRAY_VIEW_HPP
+
+#include <cstddef> // ptrdiff_t, size_t
+#include <cstdint> // uint32_t, uint64_t
+#include <iterator> // random_access_iterator_tag, reverse_iterator
+#include <stdexcept> // invalid_argument, out_of_range
+#include <type_traits> // conditional, enable_if, is_const, is_same,
+                       // remove_const
+
+#include "array_view.hpp"
+#include "array_view_simd.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) \
+    && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define ARRAY_VIEW_PACKED_X86 1
+#else
+#define ARRAY_VIEW_PACKED_X86 0
+#endif
+
+namespace ext
+{
+    /// Bit width parameter of a packed_array_view whose width is given at
+    /// run time.
+    constexpr unsigned dynamic_bits = 0;
+
+    /// Returns the number of 64-bit words needed to pack size values of
+    /// given bit width.
+    constexpr std::size_t packed_word_count(
+        std::size_t size, unsigned bits) noexcept
+    {
+        return (size * bits + 63) / 64;
+    }
+} // namespace ext
+
+namespace array_view_detail
+{
+    constexpr std::uint64_t low_bits(unsigned bits) noexcept
+    {
+        return bits >= 64 ? ~std::uint64_t(0)
+                          : (std::uint64_t(1) << bits) - 1;
+    }
+
+    // Reads the bits-wide value starting at bit position pos. Values are
+    // packed from the least significant bit of the first word upwards and
+    // may straddle two words.
+    inline std::uint32_t packed_get(std::uint64_t const* words,
+        std::size_t pos, unsigned bits) noexcept
+    {
+        auto const word = pos / 64;
+        auto const shift = static_cast<unsigned>(pos % 64);
+        auto value = words[word] >> shift;
+        if (shift + bits > 64) {
+            value |= words[word + 1] << (64 - shift);
+        }
+        return static_cast<std::uint32_t>(value & low_bits(bits));
+    }
+
+    inline void packed_set(std::uint64_t* words, std::size_t pos,
+        unsigned bits, std::uint32_t value) noexcept
+    {
+        auto const word = pos / 64;
+        auto const shift = static_cast<unsigned>(pos % 64);
+        auto const mask = low_bits(bits);
+        auto const bits_value = value & mask;
+        words[word] =
+            (words[word] & ~(mask << shift)) | (bits_value << shift);
+        if (shift + bits > 64) {
+            auto const high = 64 - shift;
+            words[word + 1] = (words[word + 1] & ~(mask >> high))
+                | (bits_value >> high);
+        }
+    }
+
+    inline void check_packed_bits(unsigned bits)
+    {
+        if (bits == 0 || bits > 32) {
+            throw std::invalid_argument("packed bit width must be 1 to 32");
+        }
+    }
+
+    // Holds the bit width at run time only if it is dynamic.
+    template<unsigned Bits>
+    struct packed_width
+    {
+        static_assert(Bits <= 32, "packed bit width must be 1 to 32");
+
+        explicit packed_width(unsigned bits)
+        {
+            if (bits != Bits) {
+                throw std::invalid_argument("packed bit width mismatch");
+            }
+        }
+
+        packed_width() = default;
+
+        constexpr unsigned get() const noexcept
+        {
+            return Bits;
+        }
+    };
+
+    template<>
+    struct packed_width<ext::dynamic_bits>
+    {
+        explicit packed_width(unsigned bits)
+            : value{bits}
+        {
+            check_packed_bits(bits);
+        }
+
+        packed_width() = default;
+
+        unsigned get() const noexcept
+        {
+            return value;
+        }
+
+        unsigned value = 32;
+    };
+} // namespace array_view_detail
+
+namespace ext
+{
+    /// Proxy reference to a value in a mutable packed_array_view.
+    class packed_reference
+    {
+      public:
+        packed_reference(
+            std::uint64_t* words, std::size_t pos, unsigned bits) noexcept
+            : words_{words}
+            , pos_{pos}
+            , bits_{bits}
+        {
+        }
+
+        /// Reads the value.
+        operator std::uint32_t() const noexcept
+        {
+            return array_view_detail::packed_get(words_, pos_, bits_);
+        }
+
+        /// Writes the value truncated to the bit width.
+        packed_reference const& operator=(std::uint32_t value) const noexcept
+        {
+            array_view_detail::packed_set(words_, pos_, bits_, value);
+            return *this;
+        }
+
+        /// Writes the value of another reference.
+        packed_reference const& operator=(
+            packed_reference const& other) const noexcept
+        {
+            return *this = static_cast<std::uint32_t>(other);
+        }
+
+      private:
+        std::uint64_t* words_;
+        std::size_t pos_;
+        unsigned bits_;
+    };
+
+    /// Random access iterator over a packed_array_view. Dereferencing
+    /// yields a packed_reference, or a value for read-only views.
+    template<unsigned Bits, typename Word>
+    class packed_iterator
+    {
+      public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::uint32_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference =
+            typename std::conditional<std::is_const<Word>::value,
+                std::uint32_t, packed_reference>::type;
+
+        /// The default constructor creates a singular iterator.
+        packed_iterator() = default;
+
+        /// This constructor creates an iterator pointing to the index-th
+        /// value packed in words.
+        packed_iterator(Word* words, std::size_t index,
+            array_view_detail::packed_width<Bits> width) noexcept
+            : words_{words}
+            , index_{index}
+            , width_(width)
+        {
+        }
+
+        /// A mutable iterator is implicitly convertible to a read-only one.
+        operator packed_iterator<Bits, Word const>() const noexcept
+        {
+            return {words_, index_, width_};
+        }
+
+        reference operator*() const noexcept
+        {
+            return dereference(words_, index_ * width_.get(), width_.get());
+        }
+
+        reference operator[](difference_type n) const noexcept
+        {
+            return *(*this + n);
+        }
+
+        packed_iterator& operator++() noexcept
+        {
+            ++index_;
+            return *this;
+        }
+
+        packed_iterator operator++(int) noexcept
+        {
+            auto const copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        packed_iterator& operator--() noexcept
+        {
+            --index_;
+            return *this;
+        }
+
+        packed_iterator operator--(int) noexcept
+        {
+            auto const copy = *this;
+            --*this;
+            return copy;
+        }
+
+        packed_iterator& operator+=(difference_type n) noexcept
+        {
+            index_ = static_cast<std::size_t>(
+                static_cast<difference_type>(index_) + n);
+            return *this;
+        }
+
+        packed_iterator& operator-=(difference_type n) noexcept
+        {
+            return *this += -n;
+        }
+
+        friend packed_iterator operator+(
+            packed_iterator it, difference_type n) noexcept
+        {
+            return it += n;
+        }
+
+        friend packed_iterator operator+(
+            difference_type n, packed_iterator it) noexcept
+        {
+            return it += n;
+        }
+
+        friend packed_iterator operator-(
+            packed_iterator it, difference_type n) noexcept
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(
+            packed_iterator const& lhs, packed_iterator const& rhs) noexcept
+        {
+            return static_cast<difference_type>(lhs.index_)
+                - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(
+            packed_iterator const& lhs, packed_iterator const& rhs) noexcept
+        {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(
+            packed_iterator const& lhs, packed_iterator const& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(
+            packed_iterator const& lhs, packed_iterator const& rhs) noexcept
+        {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(
+            packed_iterator const& lhs, packed_iterator const& rhs) noexcept
+        {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(
+            packed_iterator const& lhs, packed_iterator const& rhs) noexcept
+        {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(
+            packed_iterator const& lhs, packed_iterator const& rhs) noexcept
+        {
+            return !(lhs < rhs);
+        }
+
+      private:
+        static std::uint32_t dereference(std::uint64_t const* words,
+            std::size_t pos, unsigned bits) noexcept
+        {
+            return array_view_detail::packed_get(words, pos, bits);
+        }
+
+        static packed_reference dereference(
+            std::uint64_t* words, std::size_t pos, unsigned bits) noexcept
+        {
+            return {words, pos, bits};
+        }
+
+        Word* words_ = nullptr;
+        std::size_t index_ = 0;
+        array_view_detail::packed_width<Bits> width_;
+    };
+
+    /// Lightweight view of unsigned integers of Bits bits each, packed
+    /// without gaps into an array of 64-bit words.
+    ///
+    /// The view does not own the words. Bits is 1 to 32, or dynamic_bits
+    /// to choose the width at run time; a compile-time width lets the
+    /// compiler fold the shifts and masks. Word is std::uint64_t or
+    /// std::uint64_t const. Values of a mutable view are accessed through
+    /// a proxy reference.
+    ///
+    /// @code
+    /// std::vector<std::uint64_t> words(ext::packed_word_count(n, 20));
+    /// ext::packed_array_view<20> ids{ext::make_array_view(words), n};
+    /// ids[0] = 123456;
+    /// ext::unpack(ext::make_array_view(chunk), ids.subview(0, 1024));
+    /// @endcode
+    template<unsigned Bits = dynamic_bits, typename Word = std::uint64_t>
+    class packed_array_view
+    {
+        static_assert(
+            std::is_same<typename std::remove_const<Word>::type,
+                std::uint64_t>::value,
+            "packed words must be std::uint64_t");
+
+        using width_type = array_view_detail::packed_width<Bits>;
+
+      public:
+        /// The type of the values.
+        using value_type = std::uint32_t;
+
+        /// The type of size and index values.
+        using size_type = std::size_t;
+
+        /// The type of the underlying words.
+        using word_type = Word;
+
+        /// The type returned by operator[]: packed_reference for mutable
+        /// views and value_type for read-only views.
+        using reference =
+            typename std::conditional<std::is_const<Word>::value,
+                value_type, packed_reference>::type;
+
+        /// The type of iterators. Guaranteed to be a random access iterator.
+        using iterator = packed_iterator<Bits, Word>;
+
+        /// The type of reverse iterators.
+        using reverse_iterator = std::reverse_iterator<iterator>;
+
+        /// The type of read-only packed_array_view with the same width.
+        using const_packed_array_view = packed_array_view<Bits, Word const>;
+
+        /// The width fixed at compile time, or dynamic_bits.
+        static constexpr unsigned static_bits = Bits;
+
+        /// The default constructor creates an empty view. The bit width of
+        /// an empty dynamic view is 32.
+        packed_array_view() = default;
+
+        /// Creates a view of size values packed in words. Only for views
+        /// with a compile-time width.
+        ///
+        /// @exception std::invalid_argument if words is too small.
+        packed_array_view(array_view<Word> words, size_type size)
+            : packed_array_view{words, size, Bits}
+        {
+            static_assert(Bits != dynamic_bits, "bit width is required");
+        }
+
+        /// Creates a view of size values of given width packed in words.
+        ///
+        /// @exception std::invalid_argument if bits is not 1 to 32, differs
+        /// from a compile-time width, or words is too small.
+        packed_array_view(
+            array_view<Word> words, size_type size, unsigned bits)
+            : words_{words.data()}
+            , size_{size}
+            , width_{bits}
+        {
+            if (words.size() < packed_word_count(size, bits)) {
+                throw std::invalid_argument("packed words are too few");
+            }
+        }
+
+        /// Returns the number of bits per value.
+        unsigned bits() const noexcept
+        {
+            return width_.get();
+        }
+
+        /// Returns the largest value representable in the view.
+        value_type max_value() const noexcept
+        {
+            return static_cast<value_type>(
+                array_view_detail::low_bits(bits()));
+        }
+
+        /// Tests if the view is empty.
+        bool empty() const noexcept
+        {
+            return size_ == 0;
+        }
+
+        /// Returns the number of values.
+        size_type size() const noexcept
+        {
+            return size_;
+        }
+
+        /// Returns the words holding the values.
+        array_view<Word> words() const noexcept
+        {
+            auto const first = offset_ * bits() / 64;
+            auto const last = packed_word_count(offset_ + size_, bits());
+            return {words_ + first, last - first};
+        }
+
+        /// Returns the bit position of the first value in the first word of
+        /// words(), which is nonzero for some subviews.
+        unsigned bit_offset() const noexcept
+        {
+            return static_cast<unsigned>(offset_ * bits() % 64);
+        }
+
+        /// Returns the idx-th value. The behavior is undefined if the index
+        /// is out of bounds.
+        value_type get(size_type idx) const noexcept
+        {
+            return array_view_detail::packed_get(
+                words_, (offset_ + idx) * bits(), bits());
+        }
+
+        /// Sets the idx-th value to value truncated to the bit width. The
+        /// behavior is undefined if the index is out of bounds.
+        void set(size_type idx, value_type value) const noexcept
+        {
+            static_assert(!std::is_const<Word>::value, "view is read-only");
+            array_view_detail::packed_set(
+                words_, (offset_ + idx) * bits(), bits(), value);
+        }
+
+        /// Returns a reference to the idx-th value. The behavior is
+        /// undefined if the index is out of bounds.
+        reference operator[](size_type idx) const noexcept
+        {
+            return begin()[static_cast<std::ptrdiff_t>(idx)];
+        }
+
+        /// Returns a reference to the idx-th value.
+        ///
+        /// @exception std::out_of_range if the index is out of bounds.
+        reference at(size_type idx) const
+        {
+            if (idx >= size()) {
+                throw std::out_of_range(
+                    "packed_array_view access out-of-bounds");
+            }
+            return operator[](idx);
+        }
+
+        /// Returns an iterator to the beginning.
+        iterator begin() const noexcept
+        {
+            return {words_, offset_, width_};
+        }
+
+        /// Returns an iterator to the end.
+        iterator end() const noexcept
+        {
+            return {words_, offset_ + size_, width_};
+        }
+
+        /// Returns a reverse iterator to the reverse beginning.
+        reverse_iterator rbegin() const noexcept
+        {
+            return reverse_iterator{end()};
+        }
+
+        /// Returns a reverse iterator to the reverse end.
+        reverse_iterator rend() const noexcept
+        {
+            return reverse_iterator{begin()};
+        }
+
+        /// Returns a read-only view of the same values.
+        const_packed_array_view as_const() const noexcept
+        {
+            return *this;
+        }
+
+        /// A view is always implicitly convertible to a read-only view.
+        operator const_packed_array_view() const noexcept
+        {
+            return const_packed_array_view{words_, offset_, size_, width_};
+        }
+
+        /// Returns a view of the values in given region.
+        packed_array_view subview(size_type offset, size_type count) const
+            noexcept
+        {
+            return {words_, offset_ + offset, count, width_};
+        }
+
+        /// Returns a view of the first count values.
+        packed_array_view first(size_type count) const noexcept
+        {
+            return subview(0, count);
+        }
+
+        /// Returns a view of the last count values.
+        packed_array_view last(size_type count) const noexcept
+        {
+            return subview(size() - count, count);
+        }
+
+        /// Returns a view of the values except the first count ones.
+        packed_array_view drop_first(size_type count) const noexcept
+        {
+            return subview(count, size() - count);
+        }
+
+        /// Returns a view of the values except the last count ones.
+        packed_array_view drop_last(size_type count) const noexcept
+        {
+            return subview(0, size() - count);
+        }
+
+      private:
+        template<unsigned, typename>
+        friend class packed_array_view;
+
+        packed_array_view(Word* words, size_type offset, size_type size,
+            width_type width) noexcept
+            : words_{words}
+            , offset_{offset}
+            , size_{size}
+            , width_(width)
+        {
+        }
+
+        Word* words_ = nullptr;
+        size_type offset_ = 0;
+        size_type size_ = 0;
+        width_type width_;
+    };
+
+    template<unsigned Bits, typename Word>
+    constexpr unsigned packed_array_view<Bits, Word>::static_bits;
+
+    /// Creates a packed_array_view of size values of Bits bits in words.
+    ///
+    /// @exception std::invalid_argument if words is too small.
+    template<unsigned Bits, typename Word>
+    packed_array_view<Bits, Word> make_packed_array_view(
+        array_view<Word> words, std::size_t size)
+    {
+        return {words, size};
+    }
+
+    /// Creates a packed_array_view of size values of given width in words.
+    ///
+    /// @exception std::invalid_argument if bits is not 1 to 32 or words is
+    /// too small.
+    template<typename Word>
+    packed_array_view<dynamic_bits, Word> make_packed_array_view(
+        array_view<Word> words, std::size_t size, unsigned bits)
+    {
+        return {words, size, bits};
+    }
+} // namespace ext
+
+namespace array_view_detail
+{
+    using ext::simd::isa;
+
+    inline void unpack_scalar(std::uint32_t* dest,
+        std::uint64_t const* words, std::size_t pos, unsigned bits,
+        std::size_t count) noexcept
+    {
+        for (std::size_t i = 0; i < count; i++, pos += bits) {
+            dest[i] = packed_get(words, pos, bits);
+        }
+    }
+
+    // Packs values through a 64-bit accumulator so that each word is
+    // written once, except for partially covered words at both ends.
+    inline void pack_scalar(std::uint64_t* words, std::size_t pos,
+        unsigned bits, std::uint32_t const* src, std::size_t count) noexcept
+    {
+        std::size_t i = 0;
+        for (; i < count && pos % 64 != 0; i++, pos += bits) {
+            packed_set(words, pos, bits, src[i]);
+        }
+
+        auto const mask = low_bits(bits);
+        auto out = words + pos / 64;
+        std::uint64_t acc = 0;
+        unsigned filled = 0;
+        for (; i < count; i++) {
+            auto const value = src[i] & mask;
+            acc |= value << filled;
+            filled += bits;
+            if (filled >= 64) {
+                *out++ = acc;
+                filled -= 64;
+                acc = filled == 0 ? 0 : value >> (bits - filled);
+            }
+        }
+        if (filled != 0) {
+            auto const keep = ~low_bits(filled);
+            *out = (*out & keep) | acc;
+        }
+    }
+
+#if ARRAY_VIEW_PACKED_X86
+
+    // Unpacks eight values per iteration. Every value of up to 32 bits
+    // lies within the eight bytes starting at the byte containing its
+    // first bit, so each one is fetched with an unaligned 64-bit gather,
+    // shifted into place and masked. x86 is little-endian, so byte
+    // addressing matches the word layout.
+    __attribute__((target("avx2"))) inline void unpack_avx2(
+        std::uint32_t* dest, std::uint64_t const* words, std::size_t limit,
+        std::size_t pos, unsigned bits, std::size_t count) noexcept
+    {
+        auto const bytes = reinterpret_cast<long long const*>(words);
+        auto const step = static_cast<long long>(bits);
+        __m256i const mask =
+            _mm256_set1_epi64x(static_cast<long long>(low_bits(bits)));
+        __m256i const seven = _mm256_set1_epi64x(7);
+        __m256i const low_offsets =
+            _mm256_setr_epi64x(0, step, 2 * step, 3 * step);
+        __m256i const high_offsets =
+            _mm256_setr_epi64x(4 * step, 5 * step, 6 * step, 7 * step);
+        __m256i const even_lanes = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+
+        // The last value of a group must leave eight readable bytes.
+        auto const byte_limit = limit * 8;
+        std::size_t i = 0;
+        for (; i + 8 <= count && (pos + 7 * bits) / 8 + 8 <= byte_limit;
+             i += 8, pos += 8 * bits) {
+            __m256i const base =
+                _mm256_set1_epi64x(static_cast<long long>(pos));
+            __m256i const low_pos = _mm256_add_epi64(base, low_offsets);
+            __m256i const high_pos = _mm256_add_epi64(base, high_offsets);
+
+            __m256i low = _mm256_i64gather_epi64(
+                bytes, _mm256_srli_epi64(low_pos, 3), 1);
+            __m256i high = _mm256_i64gather_epi64(
+                bytes, _mm256_srli_epi64(high_pos, 3), 1);
+            low = _mm256_and_si256(
+                _mm256_srlv_epi64(low, _mm256_and_si256(low_pos, seven)),
+                mask);
+            high = _mm256_and_si256(
+                _mm256_srlv_epi64(high, _mm256_and_si256(high_pos, seven)),
+                mask);
+
+            low = _mm256_permutevar8x32_epi32(low, even_lanes);
+            high = _mm256_permutevar8x32_epi32(high, even_lanes);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i),
+                _mm256_permute2x128_si256(low, high, 0x20));
+        }
+        unpack_scalar(dest + i, words, pos, bits, count - i);
+    }
+
+#endif // ARRAY_VIEW_PACKED_X86
+
+    // limit is the number of readable words from words.
+    inline void unpack(isa level, std::uint32_t* dest,
+        std::uint64_t const* words, std::size_t limit, std::size_t pos,
+        unsigned bits, std::size_t count) noexcept
+    {
+#if ARRAY_VIEW_PACKED_X86
+        auto const best = ext::simd::best_isa();
+        if ((level < best ? level : best) >= isa::avx2) {
+            return unpack_avx2(dest, words, limit, pos, bits, count);
+        }
+#else
+        static_cast<void>(level);
+        static_cast<void>(limit);
+#endif
+        unpack_scalar(dest, words, pos, bits, count);
+    }
+} // namespace array_view_detail
+
+namespace ext
+{
+    /// Copies the values of a packed view into plain 32-bit integers. Uses
+    /// AVX2 where available.
+    ///
+    /// @param dest     The destination.
+    /// @param src      The packed values.
+    /// @param level    The instruction set to use at most. The best one
+    ///                 supported by the CPU is used by default.
+    ///
+    /// @exception std::invalid_argument if the sizes differ.
+    template<unsigned Bits, typename Word>
+    void unpack(array_view<std::uint32_t> dest,
+        packed_array_view<Bits, Word> src,
+        simd::isa level = simd::best_isa())
+    {
+        if (dest.size() != src.size()) {
+            throw std::invalid_argument("array_view sizes differ");
+        }
+        auto const words = src.words();
+        array_view_detail::unpack(level, dest.data(), words.data(),
+            words.size(), src.bit_offset(), src.bits(), src.size());
+    }
+
+    /// Packs plain 32-bit integers into a packed view. Values are truncated
+    /// to the bit width.
+    ///
+    /// @exception std::invalid_argument if the sizes differ.
+    template<unsigned Bits>
+    void pack(packed_array_view<Bits, std::uint64_t> dest,
+        array_view<std::uint32_t const> src)
+    {
+        if (dest.size() != src.size()) {
+            throw std::invalid_argument("array_view sizes differ");
+        }
+        array_view_detail::pack_scalar(dest.words().data(),
+            dest.bit_offset(), dest.bits(), src.data(), src.size());
+    }
+} // namespace ext
+
+#undef ARRAY_VIEW_PACKED_X86
+
+#endif // INCLUDED_PACKED_ARRAY_VIEW_HPP
@@ -0,0 +1,686 @@
+// profiled_array_view - Opt-in access pattern profiling for array_view
+//
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_PROFILED_ARRAY_VIEW_HPP
+#define INCLUDED_PROFILED_ARRAY_VIEW_HPP
+
+#include <array> // array
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t, uintptr_t
+#include <ostream> // ostream
+#include <vector> // vector
+
+#include "array_view.hpp"
+
+namespace ext
+{
+    /// Number of buckets in a stride histogram. Bucket 0 counts repeated
+    /// accesses to the same element, bucket 1 unit strides and bucket k
+    /// strides of 2^(k-1) to 2^k - 1 elements. The last bucket also counts
+    /// all longer strides.
+    constexpr std::size_t stride_buckets = 18;
+
+    /// Snapshot of the accesses recorded at one call site.
+    struct access_profile
+    {
+        /// Source location of the call site.
+        char const* file;
+        int line;
+
+        /// Size of the viewed elements in bytes.
+        std::size_t element_size;
+
+        /// Number of recorded element accesses.
+        std::uint64_t accesses;
+
+        /// Histogram of the absolute distance between consecutive accesses
+        /// through the same view or iterator, in elements.
+        std::array<std::uint64_t, stride_buckets> strides;
+
+        /// Number of consecutive accesses going backward.
+        std::uint64_t backward;
+
+        /// Lowest and highest accessed addresses.
+        std::uintptr_t min_address;
+        std::uintptr_t max_address;
+
+        /// Size of the largest profiled view in bytes.
+        std::size_t max_view_bytes;
+
+        /// Returns the number of bytes spanned by the accessed elements.
+        std::size_t touched_bytes() const noexcept
+        {
+            if (accesses == 0) {
+                return 0;
+            }
+            return static_cast<std::size_t>(max_address - min_address)
+                + element_size;
+        }
+    };
+} // namespace ext
+
+// Profiling is enabled by defining ARRAY_VIEW_PROFILE before including this
+// header. The macro must be defined consistently in all translation units.
+// Otherwise profiled_array_view is an alias of array_view and
+// ARRAY_VIEW_PROFILED(view) expands to the view itself, so profiling costs
+// nothing.
+
+#ifdef ARRAY_VIEW_PROFILE
+
+#include <atomic> // atomic
+#include <cstddef> // ptrdiff_t
+#include <cstdlib> // atexit
+#include <deque> // deque
+#include <iostream> // cerr
+#include <iterator> // random_access_iterator_tag, reverse_iterator
+#include <limits> // numeric_limits
+#include <mutex> // mutex, lock_guard
+#include <stdexcept> // out_of_range
+#include <type_traits> // enable_if, is_convertible, remove_cv
+
+namespace array_view_detail
+{
+    // Returns the histogram bucket of a stride.
+    inline std::size_t stride_bucket(std::size_t distance) noexcept
+    {
+        std::size_t bucket = 0;
+        while (distance != 0 && bucket < ext::stride_buckets - 1) {
+            distance >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+
+    // Atomically lowers or raises a value.
+    template<typename T, typename Compare>
+    void atomic_extend(std::atomic<T>& target, T value, Compare better)
+    {
+        auto current = target.load(std::memory_order_relaxed);
+        while (better(value, current)
+            && !target.compare_exchange_weak(
+                current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Access counters of a call site. Updated concurrently by all threads
+    // using views created at the site.
+    class access_site
+    {
+      public:
+        access_site(char const* file, int line) noexcept
+            : file_{file}
+            , line_{line}
+        {
+            for (auto& count : strides_) {
+                count.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        void record_view(std::size_t element_size, std::size_t bytes)
+        {
+            element_size_.store(element_size, std::memory_order_relaxed);
+            atomic_extend(max_view_bytes_, bytes,
+                [](std::size_t a, std::size_t b) { return a > b; });
+        }
+
+        void record_access(void const* ptr) noexcept
+        {
+            auto const address = reinterpret_cast<std::uintptr_t>(ptr);
+            accesses_.fetch_add(1, std::memory_order_relaxed);
+            atomic_extend(min_address_, address,
+                [](std::uintptr_t a, std::uintptr_t b) { return a < b; });
+            atomic_extend(max_address_, address,
+                [](std::uintptr_t a, std::uintptr_t b) { return a > b; });
+        }
+
+        void record_stride(std::ptrdiff_t stride) noexcept
+        {
+            auto const distance = static_cast<std::size_t>(
+                stride < 0 ? -stride : stride);
+            strides_[stride_bucket(distance)].fetch_add(
+                1, std::memory_order_relaxed);
+            if (stride < 0) {
+                backward_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        ext::access_profile snapshot() const noexcept
+        {
+            ext::access_profile profile;
+            profile.file = file_;
+            profile.line = line_;
+            profile.element_size =
+                element_size_.load(std::memory_order_relaxed);
+            profile.accesses = accesses_.load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i < ext::stride_buckets; i++) {
+                profile.strides[i] = strides_[i].load(std::memory_order_relaxed);
+            }
+            profile.backward = backward_.load(std::memory_order_relaxed);
+            profile.min_address = min_address_.load(std::memory_order_relaxed);
+            profile.max_address = max_address_.load(std::memory_order_relaxed);
+            profile.max_view_bytes =
+                max_view_bytes_.load(std::memory_order_relaxed);
+            return profile;
+        }
+
+      private:
+        char const* file_;
+        int line_;
+        std::atomic<std::size_t> element_size_{0};
+        std::atomic<std::uint64_t> accesses_{0};
+        std::atomic<std::uint64_t> strides_[ext::stride_buckets];
+        std::atomic<std::uint64_t> backward_{0};
+        std::atomic<std::uintptr_t> min_address_{
+            std::numeric_limits<std::uintptr_t>::max()};
+        std::atomic<std::uintptr_t> max_address_{0};
+        std::atomic<std::size_t> max_view_bytes_{0};
+    };
+
+    // Owner of all call sites. Sites are never removed, so references to
+    // them stay valid for the lifetime of the program.
+    class access_site_registry
+    {
+      public:
+        static access_site_registry& instance()
+        {
+            static access_site_registry registry;
+            return registry;
+        }
+
+        access_site& add(char const* file, int line)
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            sites_.emplace_back(file, line);
+            return sites_.back();
+        }
+
+        std::vector<ext::access_profile> snapshot()
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            std::vector<ext::access_profile> profiles;
+            for (auto const& site : sites_) {
+                profiles.push_back(site.snapshot());
+            }
+            return profiles;
+        }
+
+      private:
+        std::mutex mutex_;
+        std::deque<access_site> sites_;
+    };
+
+    // Position of the previous access through a view or iterator. Const
+    // views and iterators may be shared by threads, so the position is
+    // swapped atomically. Copies start from the position of the original.
+    template<typename T>
+    class last_access
+    {
+      public:
+        last_access() = default;
+
+        last_access(last_access const& other) noexcept
+            : ptr_{other.load()}
+        {
+        }
+
+        last_access& operator=(last_access const& other) noexcept
+        {
+            ptr_.store(other.load(), std::memory_order_relaxed);
+            return *this;
+        }
+
+        // Stores ptr and returns the previous position.
+        T* exchange(T* ptr) noexcept
+        {
+            return ptr_.exchange(ptr, std::memory_order_relaxed);
+        }
+
+      private:
+        T* load() const noexcept
+        {
+            return ptr_.load(std::memory_order_relaxed);
+        }
+
+        std::atomic<T*> ptr_{nullptr};
+    };
+
+    // Records an access through a view or iterator and updates its last
+    // accessed position.
+    template<typename T>
+    void record_access(
+        access_site* site, T* ptr, last_access<T>& last) noexcept
+    {
+        if (auto const previous = last.exchange(ptr)) {
+            site->record_stride(ptr - previous);
+        }
+        site->record_access(ptr);
+    }
+} // namespace array_view_detail
+
+namespace ext
+{
+    /// Random access iterator of profiled_array_view. Every dereference is
+    /// recorded.
+    template<typename T>
+    class profiled_iterator
+    {
+      public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename std::remove_cv<T>::type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        profiled_iterator() = default;
+
+        profiled_iterator(T* ptr, array_view_detail::access_site* site) noexcept
+            : ptr_{ptr}
+            , site_{site}
+        {
+        }
+
+        reference operator*() const noexcept
+        {
+            array_view_detail::record_access(site_, ptr_, last_);
+            return *ptr_;
+        }
+
+        pointer operator->() const noexcept
+        {
+            return &**this;
+        }
+
+        reference operator[](difference_type n) const noexcept
+        {
+            return *(*this + n);
+        }
+
+        profiled_iterator& operator++() noexcept
+        {
+            ++ptr_;
+            return *this;
+        }
+
+        profiled_iterator operator++(int) noexcept
+        {
+            auto const copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        profiled_iterator& operator--() noexcept
+        {
+            --ptr_;
+            return *this;
+        }
+
+        profiled_iterator operator--(int) noexcept
+        {
+            auto const copy = *this;
+            --*this;
+            return copy;
+        }
+
+        profiled_iterator& operator+=(difference_type n) noexcept
+        {
+            ptr_ += n;
+            return *this;
+        }
+
+        profiled_iterator& operator-=(difference_type n) noexcept
+        {
+            ptr_ -= n;
+            return *this;
+        }
+
+        friend profiled_iterator operator+(
+            profiled_iterator it, difference_type n) noexcept
+        {
+            return it += n;
+        }
+
+        friend profiled_iterator operator+(
+            difference_type n, profiled_iterator it) noexcept
+        {
+            return it += n;
+        }
+
+        friend profiled_iterator operator-(
+            profiled_iterator it, difference_type n) noexcept
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(profiled_iterator const& lhs,
+            profiled_iterator const& rhs) noexcept
+        {
+            return lhs.ptr_ - rhs.ptr_;
+        }
+
+        friend bool operator==(profiled_iterator const& lhs,
+            profiled_iterator const& rhs) noexcept
+        {
+            return lhs.ptr_ == rhs.ptr_;
+        }
+
+        friend bool operator!=(profiled_iterator const& lhs,
+            profiled_iterator const& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(profiled_iterator const& lhs,
+            profiled_iterator const& rhs) noexcept
+        {
+            return lhs.ptr_ < rhs.ptr_;
+        }
+
+        friend bool operator>(profiled_iterator const& lhs,
+            profiled_iterator const& rhs) noexcept
+        {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(profiled_iterator const& lhs,
+            profiled_iterator const& rhs) noexcept
+        {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(profiled_iterator const& lhs,
+            profiled_iterator const& rhs) noexcept
+        {
+            return !(lhs < rhs);
+        }
+
+      private:
+        T* ptr_ = nullptr;
+        array_view_detail::access_site* site_ = nullptr;
+        mutable array_view_detail::last_access<T> last_;
+    };
+
+    /// View with the interface of array_view that records element accesses
+    /// into the call site where it was created by ARRAY_VIEW_PROFILED.
+    ///
+    /// Accesses through operator[], at(), front(), back() and iterators are
+    /// recorded. Accesses through data() or through array_views converted
+    /// from a profiled view are not.
+    template<typename T>
+    class profiled_array_view
+    {
+      public:
+        using value_type = typename std::remove_cv<T>::type;
+        using pointer = T*;
+        using reference = T&;
+        using size_type = std::size_t;
+        using iterator = profiled_iterator<T>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_array_view = profiled_array_view<T const>;
+
+        profiled_array_view() = default;
+
+        /// Creates a view recording accesses of view into site.
+        profiled_array_view(
+            array_view<T> view, array_view_detail::access_site* site)
+            : view_{view}
+            , site_{site}
+        {
+            if (site_) {
+                site_->record_view(sizeof(T), view.size() * sizeof(T));
+            }
+        }
+
+        /// Allows conversion to a view of const elements.
+        template<typename U,
+            typename = typename std::enable_if<
+                std::is_convertible<U (*)[], T (*)[]>::value>::type>
+        profiled_array_view(profiled_array_view<U> const& other) noexcept
+            : view_{other.unprofiled()}
+            , site_{other.site()}
+        {
+        }
+
+        bool empty() const noexcept
+        {
+            return view_.empty();
+        }
+
+        size_type size() const noexcept
+        {
+            return view_.size();
+        }
+
+        pointer data() const noexcept
+        {
+            return view_.data();
+        }
+
+        reference front() const noexcept
+        {
+            return (*this)[0];
+        }
+
+        reference back() const noexcept
+        {
+            return (*this)[size() - 1];
+        }
+
+        reference operator[](size_type idx) const noexcept
+        {
+            auto const ptr = view_.data() + idx;
+            array_view_detail::record_access(site_, ptr, last_);
+            return *ptr;
+        }
+
+        /// @exception std::out_of_range if the index is out of bounds.
+        reference at(size_type idx) const
+        {
+            if (idx >= size()) {
+                throw std::out_of_range("array_view access out-of-bounds");
+            }
+            return (*this)[idx];
+        }
+
+        iterator begin() const noexcept
+        {
+            return {view_.begin(), site_};
+        }
+
+        iterator end() const noexcept
+        {
+            return {view_.end(), site_};
+        }
+
+        reverse_iterator rbegin() const noexcept
+        {
+            return reverse_iterator{end()};
+        }
+
+        reverse_iterator rend() const noexcept
+        {
+            return reverse_iterator{begin()};
+        }
+
+        const_array_view as_const() const noexcept
+        {
+            return *this;
+        }
+
+        /// Returns the underlying view, whose accesses are not recorded.
+        array_view<T> unprofiled() const noexcept
+        {
+            return view_;
+        }
+
+        /// Allows passing the view to functions taking array_view. Accesses
+        /// through the result are not recorded.
+        template<typename U,
+            typename = typename std::enable_if<
+                std::is_convertible<T (*)[], U (*)[]>::value>::type>
+        operator array_view<U>() const noexcept
+        {
+            return {view_.data(), view_.size()};
+        }
+
+        /// Returns the call site the view records into.
+        array_view_detail::access_site* site() const noexcept
+        {
+            return site_;
+        }
+
+        void swap(profiled_array_view& other) noexcept
+        {
+            auto const this_copy = *this;
+            *this = other;
+            other = this_copy;
+        }
+
+        profiled_array_view subview(size_type offset, size_type count) const
+        {
+            return {view_.subview(offset, count), site_};
+        }
+
+        profiled_array_view first(size_type count) const
+        {
+            return subview(0, count);
+        }
+
+        profiled_array_view last(size_type count) const
+        {
+            return subview(size() - count, count);
+        }
+
+        profiled_array_view drop_first(size_type count) const
+        {
+            return subview(count, size() - count);
+        }
+
+        profiled_array_view drop_last(size_type count) const
+        {
+            return subview(0, size() - count);
+        }
+
+      private:
+        array_view<T> view_;
+        array_view_detail::access_site* site_ = nullptr;
+        mutable array_view_detail::last_access<T> last_;
+    };
+
+    /// Creates a view recording into given call site. Use
+    /// ARRAY_VIEW_PROFILED instead of calling this directly.
+    template<typename T>
+    profiled_array_view<T> make_profiled_array_view(
+        array_view<T> view, array_view_detail::access_site* site)
+    {
+        return {view, site};
+    }
+
+    /// Returns the profiles of all call sites recorded so far.
+    inline std::vector<access_profile> access_profiles()
+    {
+        return array_view_detail::access_site_registry::instance().snapshot();
+    }
+
+    /// Writes a human-readable report of all call sites.
+    inline void write_access_report(std::ostream& os)
+    {
+        os << "array_view access profile\n";
+        for (auto const& profile : access_profiles()) {
+            std::uint64_t transitions = 0;
+            for (auto const count : profile.strides) {
+                transitions += count;
+            }
+            auto const percent = [&](std::uint64_t count) {
+                return transitions == 0 ? 0 : 100 * count / transitions;
+            };
+
+            os << profile.file << ':' << profile.line
+               << ": accesses=" << profile.accesses
+               << " touched_bytes=" << profile.touched_bytes()
+               << " max_view_bytes=" << profile.max_view_bytes
+               << " repeat=" << percent(profile.strides[0]) << '%'
+               << " unit=" << percent(profile.strides[1]) << '%'
+               << " backward=" << percent(profile.backward) << '%'
+               << " strides=";
+            for (std::size_t i = 0; i < stride_buckets; i++) {
+                os << (i == 0 ? "" : ",") << profile.strides[i];
+            }
+            os << '\n';
+        }
+    }
+
+    /// Arranges for the report to be written to stderr at program exit.
+    inline void write_access_report_at_exit()
+    {
+        // Statics are destroyed in the reverse order of their construction
+        // and handler registration, so construct the registry first for it
+        // to outlive the handler.
+        array_view_detail::access_site_registry::instance();
+        std::atexit([] { write_access_report(std::cerr); });
+    }
+} // namespace ext
+
+/// Wraps a view so that its accesses are recorded into a call site
+/// identified by the source location of the macro.
+#define ARRAY_VIEW_PROFILED(view)                                          \
+    ::ext::make_profiled_array_view((view), [] {                           \
+        static auto& site =                                                \
+            ::array_view_detail::access_site_registry::instance().add(     \
+                __FILE__, __LINE__);                                       \
+        return &site;                                                      \
+    }())
+
+#else // ARRAY_VIEW_PROFILE
+
+namespace ext
+{
+    /// Profiling is disabled, so a profiled view is a plain array_view.
+    template<typename T>
+    using profiled_array_view = array_view<T>;
+
+    /// Returns nothing since profiling is disabled.
+    inline std::vector<access_profile> access_profiles()
+    {
+        return {};
+    }
+
+    /// Does nothing since profiling is disabled.
+    inline void write_access_report(std::ostream&)
+    {
+    }
+
+    /// Does nothing since profiling is disabled.
+    inline void write_access_report_at_exit()
+    {
+    }
+} // namespace ext
+
+#define ARRAY_VIEW_PROFILED(view) (view)
+
+#endif // ARRAY_VIEW_PROFILE
+
+#endif // INCLUDED_PROFILED_ARRAY_VIEW_HPP
@@ -0,0 +1,416 @@
+// shared_memory - POSIX shared-memory segments viewed as array_views
+//
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_SHARED_MEMORY_HPP
+#define INCLUDED_SHARED_MEMORY_HPP
+
+#include <atomic> // atomic, atomic_thread_fence
+#include <cerrno> // errno, ENOENT
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+#include <new> // bad_alloc, placement new
+#include <stdexcept> // invalid_argument, out_of_range
+#include <string> // string
+#include <type_traits> // is_trivially_copyable, remove_const
+#include <utility> // move, swap
+
+#include <fcntl.h> // O_CREAT, O_EXCL, O_RDONLY, O_RDWR
+#include <sys/mman.h> // mmap, munmap, shm_open, shm_unlink
+#include <sys/stat.h> // fstat
+#include <unistd.h> // ftruncate
+
+#include "array_view.hpp"
+#include "mapped_file.hpp"
+
+namespace array_view_detail
+{
+    // Header at the start of every segment. Allocation offsets are counted
+    // from the start of the segment, so they mean the same in every process.
+    struct alignas(64) shm_header
+    {
+        static constexpr std::uint64_t signature = 0x31564141534d4853u;
+
+        std::uint64_t magic;
+        std::uint64_t size;
+        std::atomic<std::uint64_t> used;
+    };
+
+    static_assert(ATOMIC_LONG_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2,
+        "shared allocation counter must be lock-free");
+} // namespace array_view_detail
+
+namespace ext
+{
+    /// Typed region of a shared_memory segment, given by its byte offset in
+    /// the segment and its number of elements. A handle is trivially
+    /// copyable and independent of where the segment is mapped, so it can
+    /// be sent to another process (or stored in the segment itself) and
+    /// turned back into an array_view there. A value-initialized handle
+    /// refers to no region.
+    template<typename T>
+    struct shared_handle
+    {
+        /// The offset of the first element from the start of the segment.
+        std::uint64_t offset;
+
+        /// The number of elements.
+        std::uint64_t size;
+    };
+
+    /// Owner of a mapping of a named POSIX shared-memory segment (POSIX
+    /// only).
+    ///
+    /// One process creates the segment, allocates typed regions in it and
+    /// fills them. Other processes open the segment by name and view the
+    /// regions through handles, so the data is held in memory once per host.
+    /// Regions are allocated by bumping a counter in the segment header and
+    /// are never freed individually.
+    ///
+    /// @code
+    /// // Loader process.
+    /// auto segment = ext::shared_memory::create("/tables", 1 << 20);
+    /// auto handle = segment.allocate<float>(table.size());
+    /// ext::copy(segment.writable_view(handle), table);
+    /// send_to_workers(handle);
+    ///
+    /// // Worker process.
+    /// auto segment = ext::shared_memory::open("/tables");
+    /// ext::array_view<float const> table = segment.view(handle);
+    /// @endcode
+    class shared_memory
+    {
+      public:
+        /// The number of bytes at the start of a segment reserved for the
+        /// header.
+        static constexpr std::size_t header_size =
+            sizeof(array_view_detail::shm_header);
+
+        /// Creates an empty object mapping nothing.
+        shared_memory() = default;
+
+        /// Creates a new segment with room for capacity bytes of regions and
+        /// maps it read-write. The name should start with a slash.
+        ///
+        /// @exception std::system_error if the segment exists already or
+        /// cannot be created or mapped.
+        static shared_memory create(
+            std::string const& name, std::size_t capacity)
+        {
+            array_view_detail::fd_guard fd{
+                ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600)};
+            if (fd.get() == -1) {
+                array_view_detail::throw_errno("cannot create segment");
+            }
+
+            auto const size = header_size + capacity;
+            shared_memory segment;
+            try {
+                if (::ftruncate(fd.get(), static_cast<off_t>(size)) == -1) {
+                    array_view_detail::throw_errno("cannot size segment");
+                }
+                segment.map(fd.get(), size, map_mode::read_write);
+            } catch (...) {
+                ::shm_unlink(name.c_str());
+                throw;
+            }
+
+            auto const header = ::new (segment.data_)
+                array_view_detail::shm_header;
+            header->size = size;
+            header->used.store(header_size, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            header->magic = array_view_detail::shm_header::signature;
+
+            return segment;
+        }
+
+        /// Maps an existing segment created by create().
+        ///
+        /// @exception std::system_error if the segment cannot be opened or
+        /// mapped.
+        /// @exception std::invalid_argument if the segment was not created
+        /// by create().
+        static shared_memory open(
+            std::string const& name, map_mode mode = map_mode::read_only)
+        {
+            auto const writable = mode == map_mode::read_write;
+            array_view_detail::fd_guard fd{
+                ::shm_open(name.c_str(), writable ? O_RDWR : O_RDONLY, 0)};
+            if (fd.get() == -1) {
+                array_view_detail::throw_errno("cannot open segment");
+            }
+
+            struct stat status;
+            if (::fstat(fd.get(), &status) == -1) {
+                array_view_detail::throw_errno("cannot stat segment");
+            }
+            auto const size = static_cast<std::size_t>(status.st_size);
+            if (size < header_size) {
+                throw std::invalid_argument("segment has no header");
+            }
+
+            shared_memory segment;
+            segment.map(fd.get(), size, mode);
+            auto const header = segment.header();
+            if (header->magic != array_view_detail::shm_header::signature
+                || header->size != size) {
+                throw std::invalid_argument("segment has an invalid header");
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return segment;
+        }
+
+        /// Removes the name of a segment. Processes that have it mapped
+        /// keep their mappings. Returns false if there is no such segment.
+        ///
+        /// @exception std::system_error if the name cannot be removed.
+        static bool remove(std::string const& name)
+        {
+            if (::shm_unlink(name.c_str()) == -1) {
+                if (errno == ENOENT) {
+                    return false;
+                }
+                array_view_detail::throw_errno("cannot remove segment");
+            }
+            return true;
+        }
+
+        ~shared_memory()
+        {
+            close();
+        }
+
+        shared_memory(shared_memory const&) = delete;
+        shared_memory& operator=(shared_memory const&) = delete;
+
+        shared_memory(shared_memory&& other) noexcept
+        {
+            swap(other);
+        }
+
+        shared_memory& operator=(shared_memory&& other) noexcept
+        {
+            shared_memory{std::move(other)}.swap(*this);
+            return *this;
+        }
+
+        /// Unmaps the segment. Does nothing if nothing is mapped.
+        void close() noexcept
+        {
+            if (data_) {
+                ::munmap(data_, size_);
+            }
+            data_ = nullptr;
+            size_ = 0;
+        }
+
+        /// Returns the access mode.
+        map_mode mode() const noexcept
+        {
+            return mode_;
+        }
+
+        /// Returns the size of the segment in bytes, including the header.
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        /// Tests if nothing is mapped.
+        bool empty() const noexcept
+        {
+            return size_ == 0;
+        }
+
+        /// Returns the number of bytes allocated so far, including the
+        /// header and alignment padding.
+        std::size_t used() const noexcept
+        {
+            return data_ ? static_cast<std::size_t>(
+                       header()->used.load(std::memory_order_acquire))
+                         : 0;
+        }
+
+        /// Returns a view of the bytes of the segment.
+        array_view<unsigned char const> bytes() const noexcept
+        {
+            return {data_, size_};
+        }
+
+        /// Allocates count elements of T aligned to alignment bytes and
+        /// returns their handle. The elements are zero-filled. Processes
+        /// sharing a writable mapping may allocate concurrently.
+        ///
+        /// @exception std::invalid_argument if the segment is mapped
+        /// read-only or the alignment is not a power of two between
+        /// alignof(T) and the page size.
+        /// @exception std::bad_alloc if the segment has no room left.
+        template<typename T>
+        shared_handle<T> allocate(
+            std::size_t count, std::size_t alignment = alignof(T))
+        {
+            static_assert(std::is_trivially_copyable<T>::value,
+                "shared type must be trivially copyable");
+            check_writable();
+            if (alignment < alignof(T) || (alignment & (alignment - 1)) != 0
+                || alignment > array_view_detail::page_size()) {
+                throw std::invalid_argument("invalid alignment");
+            }
+            if (count > (size_ - header_size) / sizeof(T)) {
+                throw std::bad_alloc{};
+            }
+            auto const bytes = count * sizeof(T);
+
+            auto& used = header()->used;
+            auto offset = used.load(std::memory_order_relaxed);
+            std::uint64_t begin;
+            do {
+                begin = (offset + alignment - 1) / alignment * alignment;
+                if (begin > size_ || size_ - begin < bytes) {
+                    throw std::bad_alloc{};
+                }
+            } while (!used.compare_exchange_weak(
+                offset, begin + bytes, std::memory_order_acq_rel));
+
+            return {begin, count};
+        }
+
+        /// Returns a view of the region of a handle.
+        ///
+        /// @exception std::out_of_range if the region exceeds the segment.
+        /// @exception std::invalid_argument if the region is misaligned.
+        template<typename T>
+        array_view<T const> view(shared_handle<T> handle) const
+        {
+            static_assert(std::is_trivially_copyable<T>::value,
+                "shared type must be trivially copyable");
+            return {region<T const>(handle),
+                static_cast<std::size_t>(handle.size)};
+        }
+
+        /// Returns a writable view of the region of a handle.
+        ///
+        /// @exception std::invalid_argument if the segment is mapped
+        /// read-only or the region is misaligned.
+        /// @exception std::out_of_range if the region exceeds the segment.
+        template<typename T>
+        array_view<T> writable_view(shared_handle<T> handle)
+        {
+            static_assert(std::is_trivially_copyable<T>::value,
+                "shared type must be trivially copyable");
+            check_writable();
+            return {region<T>(handle), static_cast<std::size_t>(handle.size)};
+        }
+
+        /// Returns the handle of a view into this segment. Empty views, which
+        /// need not point into the segment, have the empty handle {0, 0}.
+        ///
+        /// @exception std::out_of_range if the view is not in the segment.
+        template<typename T>
+        shared_handle<typename std::remove_const<T>::type> handle_of(
+            array_view<T> view) const
+        {
+            if (view.empty()) {
+                return {0, 0};
+            }
+            auto const begin = reinterpret_cast<unsigned char const*>(
+                view.data());
+            auto const end = begin + view.size() * sizeof(T);
+            if (begin < data_ + header_size || end > data_ + size_) {
+                throw std::out_of_range("view is not in the segment");
+            }
+            return {static_cast<std::uint64_t>(begin - data_), view.size()};
+        }
+
+        /// Swaps the mapping with other.
+        void swap(shared_memory& other) noexcept
+        {
+            using std::swap;
+            swap(mode_, other.mode_);
+            swap(data_, other.data_);
+            swap(size_, other.size_);
+        }
+
+      private:
+        void map(int fd, std::size_t size, map_mode mode)
+        {
+            auto const writable = mode == map_mode::read_write;
+            auto const prot = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+            auto const addr =
+                ::mmap(nullptr, size, prot, MAP_SHARED, fd, 0);
+            if (addr == MAP_FAILED) {
+                array_view_detail::throw_errno("cannot map segment");
+            }
+            mode_ = mode;
+            data_ = static_cast<unsigned char*>(addr);
+            size_ = size;
+        }
+
+        array_view_detail::shm_header* header() const noexcept
+        {
+            return reinterpret_cast<array_view_detail::shm_header*>(data_);
+        }
+
+        void check_writable() const
+        {
+            if (mode_ != map_mode::read_write) {
+                throw std::invalid_argument("segment is mapped read-only");
+            }
+        }
+
+        template<typename T>
+        T* region(shared_handle<typename std::remove_const<T>::type> handle)
+            const
+        {
+            if (handle.size == 0) {
+                return nullptr;
+            }
+            auto const element = sizeof(T);
+            if (handle.offset < header_size || handle.offset > size_
+                || handle.size > (size_ - handle.offset) / element) {
+                throw std::out_of_range("handle exceeds the segment");
+            }
+            auto const ptr = data_ + handle.offset;
+            if (!array_view_detail::is_aligned(ptr, alignof(T))) {
+                throw std::invalid_argument("handle is misaligned");
+            }
+            return reinterpret_cast<T*>(ptr);
+        }
+
+        map_mode mode_ = map_mode::read_only;
+        unsigned char* data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+
+    /// Swaps two mappings.
+    inline void swap(shared_memory& a, shared_memory& b) noexcept
+    {
+        a.swap(b);
+    }
+} // namespace ext
+
+#endif // INCLUDED_SHARED_MEMORY_HPP
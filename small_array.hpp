@@ -0,0 +1,498 @@
+// small_array - Owning array with inline storage for a few elements
+//
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_SMALL_ARRAY_HPP
+#define INCLUDED_SMALL_ARRAY_HPP
+
+#include <algorithm> // max
+#include <cstddef> // max_align_t, size_t
+#include <initializer_list> // initializer_list
+#include <iterator> // reverse_iterator
+#include <memory> // addressof
+#include <new> // bad_alloc, operator new, operator delete
+#include <stdexcept> // out_of_range
+#include <type_traits> // aligned_storage, is_nothrow_move_constructible
+#include <utility> // forward, move, move_if_noexcept
+
+#include "array_view.hpp"
+
+namespace ext
+{
+    /// Contiguous owning array that keeps up to N elements in inline storage
+    /// and moves them to the heap only when it grows beyond N. Temporary
+    /// arrays of a few elements then cost no allocation.
+    ///
+    /// Moving a small_array steals the heap buffer if there is one, and
+    /// otherwise moves only the live inline elements.
+    ///
+    /// @code
+    /// ext::small_array<int, 16> indices;
+    /// for (int i = 0; i < n; i++) {
+    ///     if (selected(i)) {
+    ///         indices.push_back(i);
+    ///     }
+    /// }
+    /// process(indices.view());
+    /// @endcode
+    template<typename T, std::size_t N>
+    class small_array
+    {
+        static_assert(N > 0, "inline capacity must be positive");
+        static_assert(alignof(T) <= alignof(std::max_align_t),
+            "over-aligned types are not supported");
+
+      public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T&;
+        using const_reference = T const&;
+        using pointer = T*;
+        using const_pointer = T const*;
+        using iterator = T*;
+        using const_iterator = T const*;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        /// The number of elements held without allocation.
+        static constexpr size_type inline_capacity = N;
+
+        /// Creates an empty array.
+        small_array() noexcept
+            : data_{inline_data()}
+        {
+        }
+
+        /// Creates an array of count value-initialized elements.
+        explicit small_array(size_type count)
+            : small_array()
+        {
+            resize(count);
+        }
+
+        /// Creates an array of count copies of value.
+        small_array(size_type count, T const& value)
+            : small_array()
+        {
+            resize(count, value);
+        }
+
+        /// Creates an array holding copies of the given values.
+        small_array(std::initializer_list<T> values)
+            : small_array()
+        {
+            append(values.begin(), values.size());
+        }
+
+        /// Creates an array holding copies of the elements of a view.
+        explicit small_array(array_view<T const> values)
+            : small_array()
+        {
+            append(values.data(), values.size());
+        }
+
+        small_array(small_array const& other)
+            : small_array()
+        {
+            append(other.data(), other.size());
+        }
+
+        small_array(small_array&& other) noexcept(
+            std::is_nothrow_move_constructible<T>::value)
+            : small_array()
+        {
+            take(other);
+        }
+
+        ~small_array()
+        {
+            clear();
+            deallocate();
+        }
+
+        small_array& operator=(small_array const& other)
+        {
+            if (this != &other) {
+                clear();
+                append(other.data(), other.size());
+            }
+            return *this;
+        }
+
+        small_array& operator=(small_array&& other) noexcept(
+            std::is_nothrow_move_constructible<T>::value)
+        {
+            if (this != &other) {
+                clear();
+                deallocate();
+                take(other);
+            }
+            return *this;
+        }
+
+        /// Returns the number of elements.
+        size_type size() const noexcept
+        {
+            return size_;
+        }
+
+        /// Tests if the array is empty.
+        bool empty() const noexcept
+        {
+            return size_ == 0;
+        }
+
+        /// Returns the number of elements the array can hold without
+        /// allocating.
+        size_type capacity() const noexcept
+        {
+            return capacity_;
+        }
+
+        /// Tests if the elements are in the inline storage.
+        bool is_inline() const noexcept
+        {
+            return data_ == inline_data();
+        }
+
+        T* data() noexcept
+        {
+            return data_;
+        }
+
+        T const* data() const noexcept
+        {
+            return data_;
+        }
+
+        /// Returns a view of the elements. The view is invalidated by any
+        /// operation that changes the capacity or moves the array.
+        array_view<T> view() noexcept
+        {
+            return {data_, size_};
+        }
+
+        array_view<T const> view() const noexcept
+        {
+            return {data_, size_};
+        }
+
+        /// Returns a reference to the idx-th element. The behavior is
+        /// undefined if idx is out of range.
+        T& operator[](size_type idx) noexcept
+        {
+            return data_[idx];
+        }
+
+        T const& operator[](size_type idx) const noexcept
+        {
+            return data_[idx];
+        }
+
+        /// Returns a reference to the idx-th element.
+        ///
+        /// @exception std::out_of_range if idx is out of range.
+        T& at(size_type idx)
+        {
+            check_index(idx);
+            return data_[idx];
+        }
+
+        T const& at(size_type idx) const
+        {
+            check_index(idx);
+            return data_[idx];
+        }
+
+        T& front() noexcept
+        {
+            return data_[0];
+        }
+
+        T const& front() const noexcept
+        {
+            return data_[0];
+        }
+
+        T& back() noexcept
+        {
+            return data_[size_ - 1];
+        }
+
+        T const& back() const noexcept
+        {
+            return data_[size_ - 1];
+        }
+
+        iterator begin() noexcept
+        {
+            return data_;
+        }
+
+        iterator end() noexcept
+        {
+            return data_ + size_;
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return data_;
+        }
+
+        const_iterator end() const noexcept
+        {
+            return data_ + size_;
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return end();
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator{end()};
+        }
+
+        reverse_iterator rend() noexcept
+        {
+            return reverse_iterator{begin()};
+        }
+
+        const_reverse_iterator rbegin() const noexcept
+        {
+            return const_reverse_iterator{end()};
+        }
+
+        const_reverse_iterator rend() const noexcept
+        {
+            return const_reverse_iterator{begin()};
+        }
+
+        /// Ensures the capacity is at least count.
+        ///
+        /// @exception std::bad_alloc if memory cannot be allocated.
+        void reserve(size_type count)
+        {
+            if (count > capacity_) {
+                relocate(allocate(count), count);
+            }
+        }
+
+        /// Appends an element constructed from args.
+        ///
+        /// @exception std::bad_alloc if memory cannot be allocated.
+        template<typename... Args>
+        T& emplace_back(Args&&... args)
+        {
+            if (size_ < capacity_) {
+                ::new (static_cast<void*>(data_ + size_))
+                    T(std::forward<Args>(args)...);
+            } else {
+                // Construct the new element first since args may refer to
+                // an existing element.
+                auto const new_capacity = grown_capacity(size_ + 1);
+                auto const buffer = allocate(new_capacity);
+                try {
+                    ::new (static_cast<void*>(buffer + size_))
+                        T(std::forward<Args>(args)...);
+                } catch (...) {
+                    ::operator delete(buffer);
+                    throw;
+                }
+                relocate(buffer, new_capacity, 1);
+            }
+            return data_[size_++];
+        }
+
+        void push_back(T const& value)
+        {
+            emplace_back(value);
+        }
+
+        void push_back(T&& value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        /// Removes the last element. The behavior is undefined if the array
+        /// is empty.
+        void pop_back() noexcept
+        {
+            data_[--size_].~T();
+        }
+
+        /// Destroys all elements. The capacity is kept.
+        void clear() noexcept
+        {
+            while (size_ > 0) {
+                pop_back();
+            }
+        }
+
+        /// Changes the number of elements, value-initializing new ones.
+        void resize(size_type count)
+        {
+            resize_with(
+                count, [](T* ptr) { ::new (static_cast<void*>(ptr)) T(); });
+        }
+
+        /// Changes the number of elements, copying value into new ones.
+        void resize(size_type count, T const& value)
+        {
+            resize_with(count,
+                [&](T* ptr) { ::new (static_cast<void*>(ptr)) T(value); });
+        }
+
+      private:
+        T* inline_data() noexcept
+        {
+            return reinterpret_cast<T*>(std::addressof(storage_));
+        }
+
+        T const* inline_data() const noexcept
+        {
+            return reinterpret_cast<T const*>(std::addressof(storage_));
+        }
+
+        void check_index(size_type idx) const
+        {
+            if (idx >= size_) {
+                throw std::out_of_range("small_array index out of range");
+            }
+        }
+
+        size_type grown_capacity(size_type count) const noexcept
+        {
+            return std::max(count, 2 * capacity_);
+        }
+
+        static T* allocate(size_type count)
+        {
+            if (count > static_cast<size_type>(-1) / sizeof(T)) {
+                throw std::bad_alloc{};
+            }
+            return static_cast<T*>(::operator new(count * sizeof(T)));
+        }
+
+        void deallocate() noexcept
+        {
+            if (!is_inline()) {
+                ::operator delete(data_);
+                data_ = inline_data();
+                capacity_ = N;
+            }
+        }
+
+        // Moves the elements to a new heap buffer of the given capacity and
+        // releases the old one. Slots of buffer beyond size_ are untouched,
+        // except that the first extra of them hold constructed elements to
+        // be destroyed along with buffer if moving fails.
+        void relocate(T* buffer, size_type capacity, size_type extra = 0)
+        {
+            size_type moved = 0;
+            try {
+                for (; moved < size_; moved++) {
+                    ::new (static_cast<void*>(buffer + moved))
+                        T(std::move_if_noexcept(data_[moved]));
+                }
+            } catch (...) {
+                for (size_type i = 0; i < moved; i++) {
+                    buffer[i].~T();
+                }
+                for (size_type i = 0; i < extra; i++) {
+                    buffer[size_ + i].~T();
+                }
+                ::operator delete(buffer);
+                throw;
+            }
+
+            auto const size = size_;
+            clear();
+            deallocate();
+            data_ = buffer;
+            size_ = size;
+            capacity_ = capacity;
+        }
+
+        // Takes the contents of other, leaving it empty.
+        void take(small_array& other)
+        {
+            if (other.is_inline()) {
+                for (; size_ < other.size_; size_++) {
+                    ::new (static_cast<void*>(data_ + size_))
+                        T(std::move(other.data_[size_]));
+                }
+                other.clear();
+            } else {
+                data_ = other.data_;
+                size_ = other.size_;
+                capacity_ = other.capacity_;
+                other.data_ = other.inline_data();
+                other.size_ = 0;
+                other.capacity_ = N;
+            }
+        }
+
+        void append(T const* values, size_type count)
+        {
+            reserve(size_ + count);
+            for (size_type i = 0; i < count; i++) {
+                ::new (static_cast<void*>(data_ + size_)) T(values[i]);
+                size_++;
+            }
+        }
+
+        template<typename F>
+        void resize_with(size_type count, F construct)
+        {
+            while (size_ > count) {
+                pop_back();
+            }
+            reserve(count);
+            for (; size_ < count; size_++) {
+                construct(data_ + size_);
+            }
+        }
+
+        typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type
+            storage_;
+        T* data_;
+        size_type size_ = 0;
+        size_type capacity_ = N;
+    };
+
+    template<typename T, std::size_t N>
+    constexpr std::size_t small_array<T, N>::inline_capacity;
+} // namespace ext
+
+#endif // INCLUDED_SMALL_ARRAY_HPP
@@ -0,0 +1,261 @@
+// spsc_ring_buffer - Lock-free single-producer single-consumer ring buffer
+//
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_SPSC_RING_BUFFER_HPP
+#define INCLUDED_SPSC_RING_BUFFER_HPP
+
+#include <algorithm> // copy, min, move
+#include <atomic> // atomic, memory_order
+#include <cstddef> // size_t
+#include <memory> // unique_ptr
+#include <stdexcept> // invalid_argument
+
+#include "array_view.hpp"
+
+namespace array_view_detail
+{
+    // Returns the smallest power of two not less than value.
+    inline std::size_t ceil_power_of_two(std::size_t value) noexcept
+    {
+        std::size_t result = 1;
+        while (result < value) {
+            result *= 2;
+        }
+        return result;
+    }
+
+    // Size of the cache line used to keep producer and consumer state apart.
+    constexpr std::size_t ring_cache_line = 64;
+} // namespace array_view_detail
+
+namespace ext
+{
+    /// Up to two contiguous segments of a ring buffer. The second segment is
+    /// non-empty only if the region wraps around the end of the storage.
+    template<typename T>
+    struct ring_regions
+    {
+        array_view<T> first;
+        array_view<T> second;
+
+        /// Returns the total number of elements in both segments.
+        std::size_t size() const noexcept
+        {
+            return first.size() + second.size();
+        }
+
+        /// Tests if both segments are empty.
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+    };
+
+    /// Bounded ring buffer for passing elements from one producer thread to
+    /// one consumer thread without locks.
+    ///
+    /// The producer fills the segments returned by write_regions() in place
+    /// and publishes them with commit_write(). The consumer processes the
+    /// segments returned by read_regions() in place and releases them with
+    /// commit_read(). Each commit is a single atomic store, so elements are
+    /// transferred in bulk without copies.
+    ///
+    /// @code
+    /// // Producer thread
+    /// auto const space = ring.write_regions();
+    /// auto const n = fill(space.first);
+    /// ring.commit_write(n);
+    ///
+    /// // Consumer thread
+    /// auto const data = ring.read_regions();
+    /// process(data.first);
+    /// process(data.second);
+    /// ring.commit_read(data.size());
+    /// @endcode
+    template<typename T>
+    class spsc_ring_buffer
+    {
+      public:
+        /// The type of the elements.
+        using value_type = T;
+
+        /// The type of size values.
+        using size_type = std::size_t;
+
+        /// Creates a ring buffer holding at least min_capacity elements. The
+        /// capacity is rounded up to a power of two.
+        ///
+        /// @exception std::invalid_argument if min_capacity is zero or
+        /// greater than the largest power of two of size_type.
+        explicit spsc_ring_buffer(size_type min_capacity)
+            : capacity_{array_view_detail::ceil_power_of_two(
+                  check_capacity(min_capacity))}
+            , storage_{new T[capacity_]}
+        {
+        }
+
+        spsc_ring_buffer(spsc_ring_buffer const&) = delete;
+        spsc_ring_buffer& operator=(spsc_ring_buffer const&) = delete;
+
+        /// Returns the number of elements the buffer can hold.
+        size_type capacity() const noexcept
+        {
+            return capacity_;
+        }
+
+        /// Returns the number of elements committed but not yet read. The
+        /// value may be stale if the other thread is active.
+        size_type size() const noexcept
+        {
+            return write_.index.load(std::memory_order_acquire)
+                - read_.index.load(std::memory_order_acquire);
+        }
+
+        /// Tests if there is no element to read. The value may be stale if
+        /// the other thread is active.
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        /// Returns the free space available to the producer. Must be called
+        /// only from the producer thread.
+        ring_regions<T> write_regions() noexcept
+        {
+            auto const head = write_.index.load(std::memory_order_relaxed);
+            auto const tail = read_.index.load(std::memory_order_acquire);
+            return regions(head, capacity_ - (head - tail));
+        }
+
+        /// Publishes count elements written to the beginning of the write
+        /// regions. Must be called only from the producer thread. The
+        /// behavior is undefined if count exceeds the free space.
+        void commit_write(size_type count) noexcept
+        {
+            auto const head = write_.index.load(std::memory_order_relaxed);
+            write_.index.store(head + count, std::memory_order_release);
+        }
+
+        /// Returns the elements available to the consumer. Must be called
+        /// only from the consumer thread.
+        ring_regions<T> read_regions() noexcept
+        {
+            auto const tail = read_.index.load(std::memory_order_relaxed);
+            auto const head = write_.index.load(std::memory_order_acquire);
+            return regions(tail, head - tail);
+        }
+
+        /// Releases count elements from the beginning of the read regions.
+        /// Must be called only from the consumer thread. The behavior is
+        /// undefined if count exceeds the available elements.
+        void commit_read(size_type count) noexcept
+        {
+            auto const tail = read_.index.load(std::memory_order_relaxed);
+            read_.index.store(tail + count, std::memory_order_release);
+        }
+
+        /// Copies as many elements from input as fit and publishes them.
+        /// Returns the number of elements written. Producer only.
+        size_type write(array_view<T const> input)
+        {
+            auto const space = write_regions();
+            auto const count = std::min(input.size(), space.size());
+            auto const head = std::min(count, space.first.size());
+            std::copy(
+                input.begin(), input.begin() + head, space.first.begin());
+            std::copy(input.begin() + head, input.begin() + count,
+                space.second.begin());
+            commit_write(count);
+            return count;
+        }
+
+        /// Moves as many available elements as fit into output and releases
+        /// them. Returns the number of elements read. Consumer only.
+        size_type read(array_view<T> output)
+        {
+            auto const data = read_regions();
+            auto const count = std::min(output.size(), data.size());
+            auto const head = std::min(count, data.first.size());
+            std::move(data.first.begin(), data.first.begin() + head,
+                output.begin());
+            std::move(data.second.begin(),
+                data.second.begin() + (count - head), output.begin() + head);
+            commit_read(count);
+            return count;
+        }
+
+        /// Writes a single element if there is space. Producer only.
+        bool try_push(T const& value)
+        {
+            return write({&value, 1}) == 1;
+        }
+
+        /// Reads a single element if there is one. Consumer only.
+        bool try_pop(T& value)
+        {
+            return read({&value, 1}) == 1;
+        }
+
+      private:
+        static size_type check_capacity(size_type capacity)
+        {
+            if (capacity == 0) {
+                throw std::invalid_argument("capacity must be positive");
+            }
+            // Larger capacities have no power of two to round up to.
+            if (capacity > static_cast<size_type>(-1) / 2 + 1) {
+                throw std::invalid_argument("capacity is too large");
+            }
+            return capacity;
+        }
+
+        // Splits count elements starting at the monotonic index into the
+        // part before the end of the storage and the wrapped part.
+        ring_regions<T> regions(size_type index, size_type count) const
+            noexcept
+        {
+            auto const offset = index & (capacity_ - 1);
+            auto const head = std::min(count, capacity_ - offset);
+            return {{storage_.get() + offset, head},
+                {storage_.get(), count - head}};
+        }
+
+        // Monotonic index owned by one side. Kept on its own cache line to
+        // avoid false sharing between the producer and the consumer.
+        struct alignas(array_view_detail::ring_cache_line) side
+        {
+            std::atomic<size_type> index{0};
+        };
+
+        size_type capacity_;
+        std::unique_ptr<T[]> storage_;
+        side write_;
+        side read_;
+    };
+} // namespace ext
+
+#endif // INCLUDED_SPSC_RING_BUFFER_HPP
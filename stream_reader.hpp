@@ -0,0 +1,380 @@
+// stream_reader - Double-buffered file reader yielding array_view batches
+//
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_STREAM_READER_HPP
+#define INCLUDED_STREAM_READER_HPP
+
+#include <cerrno> // errno, EINTR
+#include <chrono> // duration, steady_clock
+#include <condition_variable> // condition_variable
+#include <cstddef> // size_t
+#include <cstdint> // uintptr_t
+#include <cstring> // memcpy
+#include <exception> // exception_ptr, current_exception, rethrow_exception
+#include <memory> // unique_ptr
+#include <mutex> // mutex, lock_guard, unique_lock
+#include <stdexcept> // invalid_argument
+#include <string> // string
+#include <thread> // thread
+#include <type_traits> // is_trivially_copyable
+#include <vector> // vector
+
+#include <fcntl.h> // open, posix_fadvise, O_RDONLY
+#include <sys/stat.h> // fstat
+#include <unistd.h> // pread
+
+#include "array_view.hpp"
+#include "mapped_file.hpp"
+
+namespace ext
+{
+    /// Options of a stream_reader.
+    struct stream_options
+    {
+        /// The number of bytes read per chunk. Rounded up to a multiple of
+        /// the alignment.
+        std::size_t chunk_bytes = std::size_t(1) << 20;
+
+        /// The number of buffers, at least two. One is processed by the
+        /// caller while the others are filled ahead.
+        std::size_t buffer_count = 2;
+
+        /// The alignment of the buffers in bytes, a power of two.
+        std::size_t alignment = 4096;
+    };
+
+    /// Counters of a stream_reader.
+    struct stream_stats
+    {
+        /// The number of bytes read from the file so far.
+        std::size_t bytes_read = 0;
+
+        /// The number of batches returned so far.
+        std::size_t batches = 0;
+
+        /// Seconds the I/O thread spent in pread.
+        double read_seconds = 0;
+
+        /// Seconds the caller spent waiting for data in next().
+        double stall_seconds = 0;
+
+        /// Seconds since the reader was created.
+        double elapsed_seconds = 0;
+
+        /// Returns the average read throughput over the elapsed time.
+        double bytes_per_second() const noexcept
+        {
+            return elapsed_seconds > 0 ? double(bytes_read) / elapsed_seconds
+                                       : 0;
+        }
+    };
+} // namespace ext
+
+namespace array_view_detail
+{
+    inline int open_for_reading(std::string const& path)
+    {
+        int const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1) {
+            throw_errno("cannot open file");
+        }
+        return fd;
+    }
+
+    // Reads up to size bytes at offset, retrying short reads. Returns the
+    // number of bytes read, which is less than size only at end of file.
+    inline std::size_t pread_full(
+        int fd, unsigned char* data, std::size_t size, std::size_t offset)
+    {
+        std::size_t total = 0;
+        while (total < size) {
+            auto const n = ::pread(fd, data + total, size - total,
+                static_cast<off_t>(offset + total));
+            if (n == -1) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw_errno("cannot read file");
+            }
+            if (n == 0) {
+                break;
+            }
+            total += static_cast<std::size_t>(n);
+        }
+        return total;
+    }
+} // namespace array_view_detail
+
+namespace ext
+{
+    /// Reader streaming a file of fixed-size records in batches, reading
+    /// ahead on a background thread (POSIX only).
+    ///
+    /// The reader owns buffer_count aligned buffers. While the caller
+    /// processes the batch returned by next(), a background thread fills
+    /// the other buffers with pread(2), so reading and processing overlap.
+    /// Chunks are read at offsets that are multiples of chunk_bytes, so a
+    /// record may straddle two chunks; its head is copied in front of the
+    /// next buffer so that every batch is a contiguous array of whole
+    /// records.
+    ///
+    /// @code
+    /// ext::stream_reader<sample> reader{"samples.bin"};
+    /// for (;;) {
+    ///     ext::array_view<sample const> batch = reader.next();
+    ///     if (batch.empty()) {
+    ///         break;
+    ///     }
+    ///     process(batch);
+    /// }
+    /// @endcode
+    template<typename T>
+    class stream_reader
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+            "records must be trivially copyable");
+
+        using clock = std::chrono::steady_clock;
+
+      public:
+        /// Opens a file and starts reading ahead.
+        ///
+        /// @exception std::system_error if the file cannot be opened.
+        /// @exception std::invalid_argument if the options are invalid or
+        /// the file size is not a multiple of sizeof(T).
+        explicit stream_reader(
+            std::string const& path, stream_options const& options = {})
+            : fd_{array_view_detail::open_for_reading(path)}
+            , start_{clock::now()}
+        {
+            if (options.buffer_count < 2) {
+                throw std::invalid_argument("stream needs two buffers");
+            }
+            auto const align = options.alignment;
+            if (align == 0 || (align & (align - 1)) != 0
+                || align < alignof(T)) {
+                throw std::invalid_argument("invalid stream alignment");
+            }
+
+            struct stat status;
+            if (::fstat(fd_.get(), &status) == -1) {
+                array_view_detail::throw_errno("cannot stat file");
+            }
+            file_size_ = static_cast<std::size_t>(status.st_size);
+            if (file_size_ % sizeof(T) != 0) {
+                throw std::invalid_argument(
+                    "file size is not a multiple of the record size");
+            }
+
+            auto const chunk = options.chunk_bytes < sizeof(T)
+                ? sizeof(T)
+                : options.chunk_bytes;
+            chunk_bytes_ = (chunk + align - 1) / align * align;
+            headroom_ = (sizeof(T) + align - 1) / align * align;
+
+            for (std::size_t i = 0; i < options.buffer_count; i++) {
+                buffers_.emplace_back(
+                    new unsigned char[headroom_ + chunk_bytes_ + align]);
+                auto const raw = buffers_.back().get();
+                auto const address = reinterpret_cast<std::uintptr_t>(raw);
+                auto const padding = (align - address % align) % align;
+                chunks_.push_back(raw + padding + headroom_);
+            }
+            sizes_.resize(options.buffer_count);
+
+#if defined(POSIX_FADV_SEQUENTIAL)
+            ::posix_fadvise(fd_.get(), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+            thread_ = std::thread{[this] { read_ahead(); }};
+        }
+
+        /// Stops reading ahead and closes the file.
+        ~stream_reader()
+        {
+            {
+                std::lock_guard<std::mutex> lock{mutex_};
+                stopping_ = true;
+            }
+            space_.notify_all();
+            thread_.join();
+        }
+
+        stream_reader(stream_reader const&) = delete;
+        stream_reader& operator=(stream_reader const&) = delete;
+
+        /// Returns the size of the file in bytes.
+        std::size_t file_size() const noexcept
+        {
+            return file_size_;
+        }
+
+        /// Returns the next batch of records, or an empty view at the end of
+        /// the file. The previous batch becomes invalid. Waits if the chunk
+        /// has not been read yet.
+        ///
+        /// @exception std::system_error if reading fails. The batches read
+        /// before the failure are returned first.
+        array_view<T const> next()
+        {
+            std::unique_lock<std::mutex> lock{mutex_};
+
+            if (holding_) {
+                carry_over();
+                consumed_++;
+                holding_ = false;
+                lock.unlock();
+                space_.notify_one();
+                lock.lock();
+            }
+
+            auto const wait_start = clock::now();
+            data_.wait(lock, [this] {
+                return produced_ > consumed_ || finished_ || error_;
+            });
+            stats_.stall_seconds += seconds_since(wait_start);
+
+            // Chunks read before a failure are still handed out.
+            if (produced_ == consumed_) {
+                if (error_) {
+                    std::rethrow_exception(error_);
+                }
+                return {};
+            }
+
+            auto const slot = consumed_ % chunks_.size();
+            auto const begin = chunks_[slot] - carry_;
+            auto const bytes = carry_ + sizes_[slot];
+            auto const count = bytes / sizeof(T);
+            carry_ = bytes % sizeof(T);
+            holding_ = true;
+            stats_.batches++;
+
+            return {reinterpret_cast<T const*>(begin), count};
+        }
+
+        /// Returns the counters so far.
+        stream_stats stats() const
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            auto stats = stats_;
+            stats.elapsed_seconds = seconds_since(start_);
+            return stats;
+        }
+
+      private:
+        static double seconds_since(clock::time_point start)
+        {
+            return std::chrono::duration<double>(clock::now() - start)
+                .count();
+        }
+
+        // Copies the partial record at the end of the held chunk in front
+        // of the next one. The I/O thread writes only behind that point.
+        void carry_over() noexcept
+        {
+            if (carry_ == 0) {
+                return;
+            }
+            auto const slot = consumed_ % chunks_.size();
+            auto const next = (consumed_ + 1) % chunks_.size();
+            std::memcpy(chunks_[next] - carry_,
+                chunks_[slot] + sizes_[slot] - carry_, carry_);
+        }
+
+        void read_ahead()
+        {
+            std::size_t offset = 0;
+            for (std::size_t chunk = 0; offset < file_size_; chunk++) {
+                {
+                    std::unique_lock<std::mutex> lock{mutex_};
+                    space_.wait(lock, [&] {
+                        return stopping_
+                            || chunk - consumed_ < chunks_.size();
+                    });
+                    if (stopping_) {
+                        return;
+                    }
+                }
+
+                auto const slot = chunk % chunks_.size();
+                auto const read_start = clock::now();
+                std::size_t size = 0;
+                try {
+                    size = array_view_detail::pread_full(
+                        fd_.get(), chunks_[slot], chunk_bytes_, offset);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock{mutex_};
+                    error_ = std::current_exception();
+                    data_.notify_one();
+                    return;
+                }
+                auto const read_time = seconds_since(read_start);
+
+                {
+                    std::lock_guard<std::mutex> lock{mutex_};
+                    sizes_[slot] = size;
+                    stats_.bytes_read += size;
+                    stats_.read_seconds += read_time;
+                    if (size == 0) {
+                        break;
+                    }
+                    produced_ = chunk + 1;
+                }
+                data_.notify_one();
+                offset += size;
+            }
+
+            std::lock_guard<std::mutex> lock{mutex_};
+            finished_ = true;
+            data_.notify_one();
+        }
+
+        array_view_detail::fd_guard fd_;
+        clock::time_point start_;
+        std::size_t file_size_ = 0;
+        std::size_t chunk_bytes_ = 0;
+        std::size_t headroom_ = 0;
+        std::vector<std::unique_ptr<unsigned char[]>> buffers_;
+        std::vector<unsigned char*> chunks_;
+        std::vector<std::size_t> sizes_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable data_;
+        std::condition_variable space_;
+        std::size_t produced_ = 0;
+        std::size_t consumed_ = 0;
+        std::size_t carry_ = 0;
+        bool holding_ = false;
+        bool finished_ = false;
+        bool stopping_ = false;
+        std::exception_ptr error_;
+        stream_stats stats_;
+        std::thread thread_;
+    };
+} // namespace ext
+
+#endif // INCLUDED_STREAM_READER_HPP
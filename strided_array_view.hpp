@@ -0,0 +1,481 @@
+// strided_array_view - Range view of equally spaced objects
+//
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_STRIDED_ARRAY_VIEW_HPP
+#define INCLUDED_STRIDED_ARRAY_VIEW_HPP
+
+#include <cstddef> // ptrdiff_t, size_t
+#include <iterator> // random_access_iterator_tag, reverse_iterator
+#include <stdexcept> // out_of_range
+#include <type_traits> // conditional, is_const, is_same, remove_cv
+
+#include "array_view.hpp"
+
+namespace array_view_detail
+{
+    // Returns the pointer advanced by given number of bytes.
+    template<typename T>
+    T* byte_advance(T* ptr, std::ptrdiff_t bytes) noexcept
+    {
+        using byte_pointer = typename std::conditional<
+            std::is_const<T>::value, char const*, char*>::type;
+        return reinterpret_cast<T*>(
+            reinterpret_cast<byte_pointer>(ptr) + bytes);
+    }
+
+    // Returns the distance between two pointers in bytes.
+    template<typename T>
+    std::ptrdiff_t byte_distance(T* from, T* to) noexcept
+    {
+        return reinterpret_cast<char const*>(to)
+            - reinterpret_cast<char const*>(from);
+    }
+} // namespace array_view_detail
+
+namespace ext
+{
+    /// Random access iterator over equally spaced objects.
+    template<typename T>
+    class strided_iterator
+    {
+      public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename std::remove_cv<T>::type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        /// The default constructor creates a singular iterator.
+        strided_iterator() noexcept = default;
+
+        /// This constructor creates an iterator pointing to ptr and moving
+        /// stride bytes per increment.
+        strided_iterator(pointer ptr, difference_type stride) noexcept
+            : ptr_{ptr}
+            , stride_{stride}
+        {
+        }
+
+        /// A mutable iterator is implicitly convertible to a read-only one.
+        operator strided_iterator<T const>() const noexcept
+        {
+            return {ptr_, stride_};
+        }
+
+        reference operator*() const noexcept
+        {
+            return *ptr_;
+        }
+
+        pointer operator->() const noexcept
+        {
+            return ptr_;
+        }
+
+        reference operator[](difference_type n) const noexcept
+        {
+            return *array_view_detail::byte_advance(ptr_, n * stride_);
+        }
+
+        strided_iterator& operator++() noexcept
+        {
+            ptr_ = array_view_detail::byte_advance(ptr_, stride_);
+            return *this;
+        }
+
+        strided_iterator operator++(int) noexcept
+        {
+            auto const copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        strided_iterator& operator--() noexcept
+        {
+            ptr_ = array_view_detail::byte_advance(ptr_, -stride_);
+            return *this;
+        }
+
+        strided_iterator operator--(int) noexcept
+        {
+            auto const copy = *this;
+            --*this;
+            return copy;
+        }
+
+        strided_iterator& operator+=(difference_type n) noexcept
+        {
+            ptr_ = array_view_detail::byte_advance(ptr_, n * stride_);
+            return *this;
+        }
+
+        strided_iterator& operator-=(difference_type n) noexcept
+        {
+            return *this += -n;
+        }
+
+        friend strided_iterator operator+(
+            strided_iterator it, difference_type n) noexcept
+        {
+            return it += n;
+        }
+
+        friend strided_iterator operator+(
+            difference_type n, strided_iterator it) noexcept
+        {
+            return it += n;
+        }
+
+        friend strided_iterator operator-(
+            strided_iterator it, difference_type n) noexcept
+        {
+            return it -= n;
+        }
+
+        /// Returns the distance between iterators. The behavior is undefined
+        /// if the iterators do not belong to the same strided sequence.
+        friend difference_type operator-(
+            strided_iterator const& lhs, strided_iterator const& rhs) noexcept
+        {
+            return array_view_detail::byte_distance(rhs.ptr_, lhs.ptr_)
+                / lhs.stride_;
+        }
+
+        friend bool operator==(
+            strided_iterator const& lhs, strided_iterator const& rhs) noexcept
+        {
+            return lhs.ptr_ == rhs.ptr_;
+        }
+
+        friend bool operator!=(
+            strided_iterator const& lhs, strided_iterator const& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(
+            strided_iterator const& lhs, strided_iterator const& rhs) noexcept
+        {
+            return rhs - lhs > 0;
+        }
+
+        friend bool operator>(
+            strided_iterator const& lhs, strided_iterator const& rhs) noexcept
+        {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(
+            strided_iterator const& lhs, strided_iterator const& rhs) noexcept
+        {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(
+            strided_iterator const& lhs, strided_iterator const& rhs) noexcept
+        {
+            return !(lhs < rhs);
+        }
+
+      private:
+        pointer ptr_ = nullptr;
+        difference_type stride_ = 0;
+    };
+
+    /// Lightweight range view of equally spaced objects in memory.
+    ///
+    /// The view does not own the objects. Consecutive elements are placed
+    /// stride() bytes apart, which allows viewing a column of a matrix or a
+    /// single member of an array of structs without copying.
+    template<typename T>
+    class strided_array_view
+    {
+      public:
+        /// The non-qualified type of the elements.
+        using value_type = typename std::remove_cv<T>::type;
+
+        /// The type of a pointer to an element.
+        using pointer = T*;
+
+        /// The type of a reference to an element.
+        using reference = T&;
+
+        /// The type of size and index values.
+        using size_type = std::size_t;
+
+        /// The type of iterators. Guaranteed to be a random access iterator.
+        using iterator = strided_iterator<T>;
+
+        /// The type of reverse iterators. Guaranteed to be a random access
+        /// iterator.
+        using reverse_iterator = std::reverse_iterator<iterator>;
+
+        /// The type of read-only strided_array_view with the same value_type.
+        using const_array_view = strided_array_view<T const>;
+
+        /// The default constructor creates an empty view.
+        strided_array_view() noexcept = default;
+
+        /// This constructor creates a view of size elements starting at data
+        /// and placed stride bytes apart. The stride must be positive.
+        strided_array_view(pointer data, size_type size, size_type stride)
+            : data_{data}
+            , size_{size}
+            , stride_{stride}
+        {
+        }
+
+        /// A contiguous view is implicitly convertible to a strided view with
+        /// the stride of sizeof(T).
+        strided_array_view(array_view<T> view) noexcept
+            : data_{view.data()}
+            , size_{view.size()}
+            , stride_{sizeof(T)}
+        {
+        }
+
+        /// Tests if the view is empty.
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        /// Returns the number of elements.
+        size_type size() const noexcept
+        {
+            return size_;
+        }
+
+        /// Returns the distance between consecutive elements in bytes.
+        size_type stride() const noexcept
+        {
+            return stride_;
+        }
+
+        /// Tests if the elements are contiguous in memory.
+        bool is_contiguous() const noexcept
+        {
+            return stride() == sizeof(T);
+        }
+
+        /// Returns a pointer to the first element. The pointer may or may not
+        /// be null if the view is empty.
+        pointer data() const noexcept
+        {
+            return data_;
+        }
+
+        /// Returns a reference to the first element. The behavior is
+        /// undefined if the view is empty.
+        reference front() const
+        {
+            return operator[](0);
+        }
+
+        /// Returns a reference to the last element. The behavior is undefined
+        /// if the view is empty.
+        reference back() const
+        {
+            return operator[](size() - 1);
+        }
+
+        /// Returns a reference to the idx-th element. The behavior is
+        /// undefined if the index is out of bounds.
+        reference operator[](size_type idx) const
+        {
+            return *element_ptr(idx);
+        }
+
+        /// Returns a reference to the idx-th element.
+        ///
+        /// @exception std::out_of_range if the index is out of bounds.
+        reference at(size_type idx) const
+        {
+            if (idx >= size()) {
+                throw std::out_of_range(
+                    "strided_array_view access out-of-bounds");
+            }
+            return operator[](idx);
+        }
+
+        /// Returns an iterator to the beginning.
+        iterator begin() const noexcept
+        {
+            return {data(), signed_stride()};
+        }
+
+        /// Returns an iterator to the end.
+        iterator end() const noexcept
+        {
+            return {element_ptr(size()), signed_stride()};
+        }
+
+        /// Returns a reverse iterator to the reverse beginning.
+        reverse_iterator rbegin() const noexcept
+        {
+            return reverse_iterator{end()};
+        }
+
+        /// Returns a reverse iterator to the reverse end.
+        reverse_iterator rend() const noexcept
+        {
+            return reverse_iterator{begin()};
+        }
+
+        /// Returns a read-only view of the same elements.
+        const_array_view as_const() const noexcept
+        {
+            return {data(), size(), stride()};
+        }
+
+        /// A view is always implicitly convertible to a read-only view.
+        operator const_array_view() const noexcept
+        {
+            return as_const();
+        }
+
+        /// Returns a contiguous view of the same elements. The behavior is
+        /// undefined if the view is not contiguous.
+        array_view<T> as_contiguous() const noexcept
+        {
+            return {data(), size()};
+        }
+
+        /// Swaps the viewed elements.
+        void swap(strided_array_view& other) noexcept
+        {
+            auto const this_copy = *this;
+            *this = other;
+            other = this_copy;
+        }
+
+        /// Returns a view of the subsequence with given region.
+        strided_array_view subview(size_type offset, size_type count) const
+        {
+            return {element_ptr(offset), count, stride()};
+        }
+
+        /// Returns a view of the first count elements.
+        strided_array_view first(size_type count) const
+        {
+            return subview(0, count);
+        }
+
+        /// Returns a view of the last count elements.
+        strided_array_view last(size_type count) const
+        {
+            return subview(size() - count, count);
+        }
+
+        /// Returns a view of the sequence except the first count elements.
+        strided_array_view drop_first(size_type count) const
+        {
+            return subview(count, size() - count);
+        }
+
+        /// Returns a view of the sequence except the last count elements.
+        strided_array_view drop_last(size_type count) const
+        {
+            return subview(0, size() - count);
+        }
+
+        /// Returns a view of every step-th element, starting from the first
+        /// one. The step must be positive.
+        strided_array_view stride_by(size_type step) const
+        {
+            return {data(), (size() + step - 1) / step, stride() * step};
+        }
+
+      private:
+        std::ptrdiff_t signed_stride() const noexcept
+        {
+            return static_cast<std::ptrdiff_t>(stride());
+        }
+
+        pointer element_ptr(size_type idx) const noexcept
+        {
+            return array_view_detail::byte_advance(
+                data(), static_cast<std::ptrdiff_t>(idx * stride()));
+        }
+
+        pointer data_ = nullptr;
+        size_type size_ = 0;
+        size_type stride_ = sizeof(T);
+    };
+
+    /// Compares strided views for shallow equality.
+    ///
+    /// Two views are equal if and only if they view exactly the same objects
+    /// in the same order.
+    template<typename T>
+    bool operator==(strided_array_view<T> const& lhs,
+        strided_array_view<T> const& rhs) noexcept
+    {
+        return lhs.data() == rhs.data() && lhs.size() == rhs.size()
+            && lhs.stride() == rhs.stride();
+    }
+
+    /// Compares strided views for shallow inequality.
+    template<typename T>
+    bool operator!=(strided_array_view<T> const& lhs,
+        strided_array_view<T> const& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    /// Creates a strided_array_view of every step-th element of a contiguous
+    /// view. The step must be positive.
+    template<typename T>
+    strided_array_view<T> make_strided_array_view(
+        array_view<T> view, std::size_t step)
+    {
+        return strided_array_view<T>{view}.stride_by(step);
+    }
+
+    /// Creates a strided_array_view of a data member of each struct in a
+    /// contiguous view. No element is copied.
+    ///
+    /// @code
+    /// std::vector<particle> particles = ...;
+    /// auto xs = ext::make_strided_array_view(
+    ///     ext::make_array_view(particles), &particle::x);
+    /// @endcode
+    template<typename S, typename C, typename M>
+    strided_array_view<array_view_detail::copy_const_t<S, M>>
+    make_strided_array_view(array_view<S> view, M C::*member)
+    {
+        static_assert(std::is_same<typename std::remove_cv<S>::type, C>::value,
+            "member must belong to the viewed struct");
+
+        if (view.empty()) {
+            return {nullptr, 0, sizeof(S)};
+        }
+        return {&(view.data()->*member), view.size(), sizeof(S)};
+    }
+} // namespace ext
+
+#endif // INCLUDED_STRIDED_ARRAY_VIEW_HPP
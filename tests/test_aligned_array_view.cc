@@ -0,0 +1,100 @@
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+
+#include <aligned_array_view.hpp>
+#include <catch.hpp>
+
+TEST_CASE("aligned_array_view is default constructible")
+{
+    ext::aligned_array_view<float, 64> view;
+    CHECK(view.data() == nullptr);
+    CHECK(view.empty());
+}
+
+TEST_CASE("aligned_array_view validates alignment on construction")
+{
+    alignas(64) float buffer[32] = {};
+    auto const view = ext::make_array_view(buffer);
+
+    SECTION("aligned")
+    {
+        auto const aligned = ext::make_aligned_array_view<64>(view);
+        CHECK(aligned.data() == buffer);
+        CHECK(aligned.size() == 32);
+        CHECK(aligned.alignment == 64);
+    }
+
+    SECTION("aligned container")
+    {
+        auto const aligned = ext::make_aligned_array_view<64>(buffer);
+        CHECK(aligned.as_array_view() == view);
+    }
+
+    SECTION("misaligned")
+    {
+        CHECK_THROWS_AS(ext::make_aligned_array_view<64>(view.drop_first(1)),
+            std::invalid_argument);
+        CHECK_NOTHROW(ext::make_aligned_array_view<16>(view.drop_first(4)));
+    }
+}
+
+TEST_CASE("aligned_array_view provides container-like access")
+{
+    alignas(32) int buffer[8];
+    std::iota(buffer, buffer + 8, 0);
+    auto const view = ext::make_aligned_array_view<32>(buffer);
+
+    CHECK(view.front() == 0);
+    CHECK(view.back() == 7);
+    CHECK(view[3] == 3);
+    CHECK_THROWS_AS(view.at(8), std::out_of_range);
+    CHECK(std::accumulate(view.begin(), view.end(), 0) == 28);
+    CHECK(*view.rbegin() == 7);
+
+    view[1] = 100;
+    CHECK(buffer[1] == 100);
+}
+
+TEST_CASE("aligned_array_view converts to unaligned and const views")
+{
+    alignas(32) int buffer[8] = {};
+    auto const view = ext::make_aligned_array_view<32>(buffer);
+
+    ext::array_view<int> const plain = view;
+    ext::array_view<int const> const const_plain = view;
+    ext::aligned_array_view<int const, 32> const const_view = view;
+
+    CHECK(plain == ext::make_array_view(buffer));
+    CHECK(const_plain == ext::make_array_view(buffer));
+    CHECK(const_view == view.as_const());
+}
+
+TEST_CASE("aligned_array_view keeps alignment only for aligned offsets")
+{
+    alignas(64) double buffer[32] = {};
+    auto const view = ext::make_aligned_array_view<64>(buffer);
+
+    auto const aligned = view.subview<8>(4);
+    auto const unaligned = view.subview<3>(4);
+    auto const tail = view.drop_first<16>();
+
+    CHECK(std::is_same<decltype(aligned),
+        ext::aligned_array_view<double, 64> const>::value);
+    CHECK(std::is_same<decltype(unaligned),
+        ext::array_view<double> const>::value);
+    CHECK(std::is_same<decltype(tail),
+        ext::aligned_array_view<double, 64> const>::value);
+    CHECK(aligned.data() == buffer + 8);
+    CHECK(unaligned.data() == buffer + 3);
+    CHECK(tail.size() == 16);
+
+    CHECK(std::is_same<decltype(view.first(4)),
+        ext::aligned_array_view<double, 64>>::value);
+    CHECK(std::is_same<decltype(view.drop_last(4)),
+        ext::aligned_array_view<double, 64>>::value);
+    CHECK(std::is_same<decltype(view.subview(8, 4)),
+        ext::array_view<double>>::value);
+    CHECK(view.last(4).data() == buffer + 28);
+    CHECK(view.drop_first(4).size() == 28);
+}
@@ -0,0 +1,132 @@
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+
+#include <arena.hpp>
+#include <catch.hpp>
+
+namespace
+{
+    bool is_aligned(void const* ptr, std::size_t align)
+    {
+        return reinterpret_cast<std::uintptr_t>(ptr) % align == 0;
+    }
+
+    struct alignas(64) cache_line
+    {
+        char bytes[64];
+    };
+}
+
+TEST_CASE("arena - allocation")
+{
+    ext::arena arena{1024};
+    CHECK(arena.block_count() == 0);
+    CHECK(arena.capacity() == 0);
+
+    SECTION("views are disjoint and aligned")
+    {
+        auto const chars = arena.allocate<char>(3);
+        auto const doubles = arena.allocate<double>(10, 1.5);
+        auto const lines = arena.allocate<cache_line>(2);
+
+        CHECK(chars.size() == 3);
+        CHECK(doubles.size() == 10);
+        CHECK(lines.size() == 2);
+        CHECK(is_aligned(doubles.data(), alignof(double)));
+        CHECK(is_aligned(lines.data(), 64));
+        CHECK(static_cast<void const*>(doubles.data())
+            >= static_cast<void const*>(chars.data() + 3));
+        CHECK(doubles[9] == 1.5);
+        CHECK(arena.bytes_used() == 3 + 80 + 128);
+        CHECK(arena.block_count() == 1);
+    }
+
+    SECTION("large allocation gets its own block")
+    {
+        arena.allocate<char>(10);
+        auto const big = arena.allocate<std::int32_t>(1000, 7);
+        CHECK(big.back() == 7);
+        CHECK(arena.block_count() == 2);
+        CHECK(arena.capacity() >= 1024 + 4000);
+    }
+
+    SECTION("zero-size allocation")
+    {
+        auto const empty = arena.allocate<int>(0);
+        CHECK(empty.empty());
+        CHECK(arena.block_count() == 0);
+        CHECK(arena.bytes_used() == 0);
+    }
+
+    SECTION("invalid alignment")
+    {
+        CHECK_THROWS_AS(arena.allocate_bytes(8, 0), std::invalid_argument);
+        CHECK_THROWS_AS(arena.allocate_bytes(8, 24), std::invalid_argument);
+        CHECK(arena.block_count() == 0);
+        CHECK(arena.allocate_bytes(8, 32) != nullptr);
+    }
+
+    SECTION("overflow")
+    {
+        CHECK_THROWS_AS(
+            arena.allocate<double>(static_cast<std::size_t>(-1) / 4),
+            std::bad_alloc);
+    }
+
+    CHECK_THROWS_AS(ext::arena{0}, std::invalid_argument);
+}
+
+TEST_CASE("arena - reset reuses blocks")
+{
+    ext::arena arena{256};
+
+    auto const first = arena.allocate<char>(200);
+    arena.allocate<char>(200);
+    arena.allocate<char>(1000);
+    auto const blocks = arena.block_count();
+    auto const capacity = arena.capacity();
+    CHECK(blocks == 3);
+
+    for (int round = 0; round < 3; round++) {
+        arena.reset();
+        CHECK(arena.bytes_used() == 0);
+
+        auto const again = arena.allocate<char>(200);
+        CHECK(again.data() == first.data());
+        arena.allocate<char>(1000);
+        arena.allocate<char>(200);
+        CHECK(arena.block_count() == blocks);
+        CHECK(arena.capacity() == capacity);
+    }
+
+    arena.release();
+    CHECK(arena.block_count() == 0);
+    CHECK(arena.allocate<int>(4).size() == 4);
+}
+
+TEST_CASE("arena - move")
+{
+    ext::arena arena;
+    auto const view = arena.allocate<int>(4, 1);
+
+    ext::arena moved{std::move(arena)};
+    CHECK(arena.block_count() == 0);
+    CHECK(moved.block_count() == 1);
+    CHECK(view[3] == 1);
+
+    arena = std::move(moved);
+    CHECK(arena.bytes_used() == 4 * sizeof(int));
+}
+
+TEST_CASE("thread_local_arena is per thread")
+{
+    ext::arena* main_arena = &ext::thread_local_arena();
+    ext::arena* other_arena = nullptr;
+    std::thread thread{[&] { other_arena = &ext::thread_local_arena(); }};
+    thread.join();
+
+    CHECK(main_arena == &ext::thread_local_arena());
+    CHECK(main_arena != other_arena);
+}
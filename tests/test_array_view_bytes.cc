@@ -0,0 +1,150 @@
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <array_view_bytes.hpp>
+#include <catch.hpp>
+
+namespace
+{
+    struct header
+    {
+        std::uint32_t tag;
+        std::uint32_t count;
+    };
+}
+
+TEST_CASE("as_bytes views object representation")
+{
+    std::vector<std::uint32_t> vector = {1, 2, 3};
+    auto const view = ext::make_array_view(vector);
+
+    auto const bytes = ext::as_bytes(view);
+    static_assert(std::is_same<decltype(bytes),
+                      ext::array_view<unsigned char const> const>::value,
+        "as_bytes yields read-only bytes");
+    CHECK(bytes.size() == 12);
+    CHECK(static_cast<void const*>(bytes.data()) == vector.data());
+
+    auto const writable = ext::as_writable_bytes(view);
+    std::memset(writable.data(), 0, writable.size());
+    CHECK(vector == (std::vector<std::uint32_t>{0, 0, 0}));
+}
+
+TEST_CASE("reinterpret_view checks size and alignment")
+{
+    alignas(8) unsigned char buffer[16] = {};
+    auto const bytes = ext::make_array_view(buffer);
+
+    SECTION("valid")
+    {
+        auto const words = ext::reinterpret_view<std::uint32_t>(bytes);
+        static_assert(std::is_same<decltype(words),
+                          ext::array_view<std::uint32_t> const>::value,
+            "constness follows the byte view");
+        CHECK(words.size() == 4);
+
+        words[1] = 42;
+        std::uint32_t value;
+        std::memcpy(&value, buffer + 4, sizeof value);
+        CHECK(value == 42);
+
+        auto const const_words =
+            ext::reinterpret_view<std::uint64_t>(bytes.as_const());
+        static_assert(std::is_same<decltype(const_words),
+                          ext::array_view<std::uint64_t const> const>::value,
+            "constness follows the byte view");
+        CHECK(const_words.size() == 2);
+    }
+
+    SECTION("size not divisible")
+    {
+        CHECK_THROWS_AS(ext::reinterpret_view<std::uint32_t>(bytes.first(6)),
+            std::invalid_argument);
+    }
+
+    SECTION("misaligned")
+    {
+        CHECK_THROWS_AS(
+            ext::reinterpret_view<std::uint32_t>(bytes.subview(1, 8)),
+            std::invalid_argument);
+    }
+
+    SECTION("empty")
+    {
+        CHECK(ext::reinterpret_view<header>(bytes.first(0)).empty());
+    }
+}
+
+TEST_CASE("byte_cursor carves typed subviews")
+{
+    alignas(8) unsigned char buffer[32] = {};
+    header const head = {0xabcd, 3};
+    std::uint32_t const payload[3] = {10, 20, 30};
+    std::memcpy(buffer, &head, sizeof head);
+    std::memcpy(buffer + sizeof head, payload, sizeof payload);
+    buffer[20] = 7;
+
+    ext::byte_cursor cursor{ext::make_array_view(buffer).as_const()};
+    CHECK(cursor.remaining() == 32);
+
+    header const& parsed = cursor.read<header>();
+    CHECK(static_cast<void const*>(&parsed) == static_cast<void*>(buffer));
+    CHECK(parsed.tag == 0xabcd);
+
+    auto const values = cursor.read_array<std::uint32_t>(parsed.count);
+    CHECK(values.size() == 3);
+    CHECK(values[2] == 30);
+    CHECK(cursor.position() == 20);
+
+    CHECK(cursor.read_value<unsigned char>() == 7);
+
+    SECTION("misaligned read leaves cursor unchanged")
+    {
+        CHECK_THROWS_AS(cursor.read<std::uint32_t>(), std::invalid_argument);
+        CHECK(cursor.position() == 21);
+        CHECK(cursor.read_value<std::uint32_t>() == 0);
+    }
+
+    SECTION("align skips padding")
+    {
+        cursor.align(4);
+        CHECK(cursor.position() == 24);
+        CHECK(cursor.read<std::uint64_t const>() == 0);
+        CHECK(cursor.empty());
+    }
+
+    SECTION("invalid alignment")
+    {
+        CHECK_THROWS_AS(cursor.align(0), std::invalid_argument);
+        CHECK_THROWS_AS(cursor.align(12), std::invalid_argument);
+        CHECK(cursor.position() == 21);
+    }
+
+    SECTION("underflow")
+    {
+        CHECK_THROWS_AS(cursor.bytes(12), std::out_of_range);
+        CHECK_THROWS_AS(
+            cursor.read_array<std::uint32_t>(3), std::out_of_range);
+        CHECK(cursor.rest().size() == 11);
+        CHECK(cursor.skip(11).empty());
+    }
+}
+
+TEST_CASE("writable_byte_cursor yields writable views")
+{
+    alignas(4) unsigned char buffer[8] = {};
+    ext::writable_byte_cursor cursor{ext::make_array_view(buffer)};
+
+    cursor.read<std::uint32_t>() = 5;
+    cursor.read_array<std::uint16_t>(2)[1] = 9;
+
+    std::uint32_t first;
+    std::uint16_t last;
+    std::memcpy(&first, buffer, sizeof first);
+    std::memcpy(&last, buffer + 6, sizeof last);
+    CHECK(first == 5);
+    CHECK(last == 9);
+}
@@ -0,0 +1,306 @@
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <array_view_chunks.hpp>
+#include <catch.hpp>
+
+TEST_CASE("chunks splits a view into batches")
+{
+    std::vector<int> vector(10);
+    std::iota(vector.begin(), vector.end(), 0);
+    auto const view = ext::make_array_view(vector);
+
+    SECTION("uneven size")
+    {
+        auto const range = ext::chunks(view, 4);
+        CHECK(range.size() == 3);
+        CHECK_FALSE(range.empty());
+        CHECK(range[0] == view.subview(0, 4));
+        CHECK(range[1] == view.subview(4, 4));
+        CHECK(range[2] == view.subview(8, 2));
+
+        std::size_t offset = 0;
+        for (ext::array_view<int> chunk : range) {
+            CHECK(chunk.data() == view.data() + offset);
+            offset += chunk.size();
+        }
+        CHECK(offset == view.size());
+    }
+
+    SECTION("even size")
+    {
+        auto const range = ext::chunks(view, 5);
+        CHECK(range.size() == 2);
+        CHECK(range[1] == view.subview(5, 5));
+    }
+
+    SECTION("empty view")
+    {
+        auto const range = ext::chunks(view.first(0), 3);
+        CHECK(range.size() == 0);
+        CHECK(range.empty());
+        CHECK(range.begin() == range.end());
+    }
+
+    SECTION("chunk size near the maximum")
+    {
+        auto const range = ext::chunks(view, static_cast<std::size_t>(-1));
+        CHECK(range.size() == 1);
+        CHECK(range[0] == view);
+    }
+
+    SECTION("zero chunk size")
+    {
+        CHECK_THROWS_AS(ext::chunks(view, 0), std::invalid_argument);
+    }
+}
+
+TEST_CASE("exact_chunks exposes remainder")
+{
+    std::vector<int> vector(10);
+    std::iota(vector.begin(), vector.end(), 0);
+    auto const view = ext::make_array_view(vector);
+
+    SECTION("dynamic chunk size")
+    {
+        auto const range = ext::exact_chunks(view, 3);
+        CHECK(range.size() == 3);
+        CHECK(range[2] == view.subview(6, 3));
+        CHECK(range.remainder() == view.subview(9, 1));
+
+        std::size_t count = 0;
+        for (auto const chunk : range) {
+            CHECK(chunk.size() == 3);
+            count++;
+        }
+        CHECK(count == 3);
+    }
+
+    SECTION("static chunk size")
+    {
+        auto const range = ext::exact_chunks<4>(view);
+        static_assert(std::is_same<decltype(range[0]),
+                          ext::array_view<int, 4>>::value,
+            "chunks are fixed-size views");
+        CHECK(range.size() == 2);
+        CHECK(range[1].data() == view.data() + 4);
+        CHECK(range.remainder() == view.subview(8, 2));
+    }
+
+    SECTION("view smaller than chunk")
+    {
+        auto const range = ext::exact_chunks(view.first(2), 3);
+        CHECK(range.empty());
+        CHECK(range.remainder() == view.first(2));
+    }
+}
+
+TEST_CASE("windows yields overlapping subviews")
+{
+    std::vector<int> vector = {1, 2, 3, 4, 5};
+    auto const view = ext::make_array_view(vector);
+
+    SECTION("dynamic window size")
+    {
+        auto const range = ext::windows(view, 3);
+        CHECK(range.size() == 3);
+
+        std::vector<int> sums;
+        for (auto const window : range) {
+            sums.push_back(std::accumulate(window.begin(), window.end(), 0));
+        }
+        CHECK(sums == (std::vector<int>{6, 9, 12}));
+    }
+
+    SECTION("static window size")
+    {
+        auto const range = ext::windows<2>(view);
+        CHECK(range.size() == 4);
+        CHECK(range.begin()[3].front() == 4);
+        CHECK(range.begin()[3].back() == 5);
+    }
+
+    SECTION("window larger than view")
+    {
+        CHECK(ext::windows(view, 6).empty());
+        CHECK(ext::windows(view, 5).size() == 1);
+    }
+}
+
+TEST_CASE("subview_iterator is a random access iterator")
+{
+    std::vector<int> vector(12);
+    auto const range = ext::chunks(ext::make_array_view(vector), 5);
+
+    auto it = range.begin();
+    CHECK(std::distance(range.begin(), range.end()) == 3);
+    CHECK((*(it + 2)).size() == 2);
+    CHECK(*(range.end() - 1) == range[2]);
+    CHECK(it < range.end());
+    CHECK(it[1] == range[1]);
+
+    it += 3;
+    CHECK(it == range.end());
+    --it;
+    CHECK(*it == range[2]);
+}
+
+namespace
+{
+    // Checks that parts cover the view in order and that every non-empty
+    // part after the first starts on an alignment boundary.
+    template<typename Parts, typename T>
+    void check_partition(
+        Parts const& parts, ext::array_view<T> view, std::size_t alignment)
+    {
+        auto next = view.data();
+        bool first = true;
+        for (ext::array_view<T> part : parts) {
+            CHECK(part.data() == next);
+            if (!first && !part.empty()) {
+                CHECK(reinterpret_cast<std::uintptr_t>(part.data())
+                        % alignment
+                    == 0);
+            }
+            next += part.size();
+            first = false;
+        }
+        CHECK(next == view.data() + view.size());
+    }
+
+    struct triple
+    {
+        char bytes[12];
+    };
+}
+
+TEST_CASE("partition splits a view at cache line boundaries")
+{
+    alignas(64) static int buffer[1000];
+    auto const view = ext::make_array_view(buffer);
+
+    SECTION("aligned view")
+    {
+        auto const parts = ext::partition(view, 4);
+        CHECK(parts.size() == 4);
+        check_partition(parts, view, 64);
+        CHECK(parts[0].size() == 240);
+        CHECK(parts[1].size() == 256);
+        CHECK(parts[3].size() == 248);
+    }
+
+    SECTION("misaligned view")
+    {
+        auto const sub = view.subview(3, 990);
+        for (std::size_t n = 1; n <= 9; n++) {
+            auto const parts = ext::partition(sub, n);
+            CHECK(parts.size() == n);
+            check_partition(parts, sub, 64);
+            for (ext::array_view<int> part : parts) {
+                CHECK(part.size() <= 990 / n + 32);
+            }
+        }
+    }
+
+    SECTION("more parts than cache lines")
+    {
+        auto const sub = view.first(40);
+        auto const parts = ext::partition(sub, 8);
+        check_partition(parts, sub, 64);
+        CHECK(parts[0].empty());
+        CHECK(parts[2].size() == 16);
+        CHECK(parts[5].size() == 16);
+        CHECK(parts[7].size() == 8);
+    }
+
+    SECTION("element size not dividing the alignment")
+    {
+        alignas(64) static triple triples[100];
+        auto const all = ext::make_array_view(triples);
+        auto const parts = ext::partition(all.drop_first(1), 3);
+        check_partition(parts, all.drop_first(1), 64);
+        CHECK(parts[1].size() % 16 == 0);
+    }
+
+    SECTION("page alignment")
+    {
+        auto const parts = ext::partition(view, 3, 256);
+        check_partition(parts, view, 256);
+    }
+
+    SECTION("empty view")
+    {
+        auto const parts = ext::partition(view.first(0), 3);
+        CHECK(parts.size() == 3);
+        for (ext::array_view<int> part : parts) {
+            CHECK(part.empty());
+        }
+    }
+
+    SECTION("invalid arguments")
+    {
+        CHECK_THROWS_AS(ext::partition(view, 0), std::invalid_argument);
+        CHECK_THROWS_AS(ext::partition(view, 2, 48), std::invalid_argument);
+    }
+}
+
+TEST_CASE("weighted_partition sizes parts by weight")
+{
+    alignas(64) static int buffer[1024];
+    auto const view = ext::make_array_view(buffer);
+
+    SECTION("proportional sizes")
+    {
+        std::vector<double> const weights = {1, 3};
+        auto const parts =
+            ext::weighted_partition(view, ext::make_array_view(weights));
+        CHECK(parts.size() == 2);
+        check_partition(parts, view, 64);
+        CHECK(parts[0].size() == 256);
+        CHECK(parts[1].size() == 768);
+    }
+
+    SECTION("zero weight")
+    {
+        std::vector<double> const weights = {2, 0, 2};
+        auto const sub = view.drop_first(5);
+        auto const parts =
+            ext::weighted_partition(sub, ext::make_array_view(weights));
+        check_partition(parts, sub, 64);
+        CHECK(parts[1].empty());
+    }
+
+    SECTION("invalid weights")
+    {
+        std::vector<double> const none;
+        std::vector<double> const zeros = {0, 0};
+        std::vector<double> const negative = {1, -1};
+        CHECK_THROWS_AS(
+            ext::weighted_partition(view, ext::make_array_view(none)),
+            std::invalid_argument);
+        CHECK_THROWS_AS(
+            ext::weighted_partition(view, ext::make_array_view(zeros)),
+            std::invalid_argument);
+        CHECK_THROWS_AS(
+            ext::weighted_partition(view, ext::make_array_view(negative)),
+            std::invalid_argument);
+    }
+}
+
+TEST_CASE("split_at splits a view in two")
+{
+    std::vector<int> vector = {1, 2, 3, 4, 5};
+    auto const view = ext::make_array_view(vector);
+
+    auto const parts = ext::split_at(view, 2);
+    CHECK(parts.first == view.first(2));
+    CHECK(parts.second == view.drop_first(2));
+
+    CHECK(ext::split_at(view, 0).first.empty());
+    CHECK(ext::split_at(view, 5).second.empty());
+}
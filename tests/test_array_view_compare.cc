@@ -0,0 +1,124 @@
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <array_view_compare.hpp>
+#include <catch.hpp>
+
+TEST_CASE("equal compares contents")
+{
+    std::vector<int> a = {1, 2, 3};
+    std::vector<int> b = {1, 2, 3};
+    std::vector<int> c = {1, 2, 4};
+    auto const va = ext::make_array_view(a);
+    auto const vb = ext::make_array_view(b);
+
+    CHECK(ext::equal(va, vb));
+    CHECK(ext::equal(va, vb.as_const()));
+    CHECK_FALSE(va == vb);
+    CHECK_FALSE(ext::equal(va, ext::make_array_view(c)));
+    CHECK_FALSE(ext::equal(va, vb.first(2)));
+    CHECK(ext::equal(va.first(0), ext::array_view<int>{}));
+
+    SECTION("non-bitwise elements")
+    {
+        std::vector<double> x = {0.0, 1.5};
+        std::vector<double> y = {-0.0, 1.5};
+        CHECK(ext::equal(ext::make_array_view(x), ext::make_array_view(y)));
+
+        std::vector<std::string> s = {"a", "bc"};
+        std::vector<std::string> t = {"a", "bc"};
+        CHECK(ext::equal(ext::make_array_view(s), ext::make_array_view(t)));
+    }
+}
+
+TEST_CASE("compare orders lexicographically")
+{
+    std::string const abc = "abc";
+    std::string const abd = "abd";
+    std::string const ab = "ab";
+    auto const view = [](std::string const& s) {
+        return ext::array_view<char const>{s.data(), s.size()};
+    };
+
+    CHECK(ext::compare(view(abc), view(abc)) == 0);
+    CHECK(ext::compare(view(abc), view(abd)) < 0);
+    CHECK(ext::compare(view(abd), view(abc)) > 0);
+    CHECK(ext::compare(view(ab), view(abc)) < 0);
+    CHECK(ext::compare(view(abc), view(ab)) > 0);
+
+    SECTION("bytes above 127")
+    {
+        unsigned char const low[] = {1, 0x7f};
+        unsigned char const high[] = {1, 0x80};
+        CHECK(ext::compare(ext::make_array_view(low),
+                  ext::make_array_view(high))
+            < 0);
+    }
+
+    SECTION("signed and floating-point elements")
+    {
+        std::vector<int> a = {1, -5};
+        std::vector<int> b = {1, 3};
+        CHECK(ext::compare(ext::make_array_view(a), ext::make_array_view(b))
+            < 0);
+
+        std::vector<double> x = {0.5, 2.0};
+        std::vector<double> y = {0.5};
+        CHECK(ext::compare(ext::make_array_view(x), ext::make_array_view(y))
+            > 0);
+    }
+}
+
+TEST_CASE("hash of bytes is XXH64")
+{
+    auto const hash = [](std::string const& s) {
+        return ext::hash(ext::array_view<char const>{s.data(), s.size()});
+    };
+
+    CHECK(hash("") == 0xEF46DB3751D8E999ULL);
+    CHECK(hash("a") == 0xD24EC4F1A98C6E5BULL);
+    CHECK(hash("abc") == 0x44BC2CF5AD770999ULL);
+
+    std::string const long_text(100, 'x');
+    CHECK(hash(long_text) != hash(long_text.substr(1)));
+    CHECK(hash(long_text)
+        == ext::hash(ext::array_view<char const>{
+            long_text.data(), long_text.size()}));
+}
+
+TEST_CASE("hash depends on contents only")
+{
+    std::vector<std::uint32_t> a = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    std::vector<std::uint32_t> b = a;
+    auto const va = ext::make_array_view(a);
+    auto const vb = ext::make_array_view(b);
+
+    CHECK(ext::hash(va) == ext::hash(vb.as_const()));
+    CHECK(ext::hash(va) != ext::hash(va, 1));
+    b[8] = 10;
+    CHECK(ext::hash(va) != ext::hash(vb));
+
+    std::vector<std::string> s = {"x", "y"};
+    std::vector<std::string> t = {"x", "y"};
+    std::vector<std::string> u = {"y", "x"};
+    CHECK(ext::hash(ext::make_array_view(s))
+        == ext::hash(ext::make_array_view(t)));
+    CHECK(ext::hash(ext::make_array_view(s))
+        != ext::hash(ext::make_array_view(u)));
+}
+
+TEST_CASE("deep_hash and deep_equal key unordered containers")
+{
+    std::vector<int> a = {1, 2};
+    std::vector<int> b = {1, 2};
+    std::vector<int> c = {2, 1};
+
+    std::unordered_set<ext::array_view<int const>, ext::deep_hash,
+        ext::deep_equal>
+        set;
+    set.insert(ext::make_array_view(a));
+    CHECK(set.count(ext::make_array_view(b)) == 1);
+    CHECK(set.count(ext::make_array_view(c)) == 0);
+}
@@ -0,0 +1,185 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <array_view_copy.hpp>
+#include <catch.hpp>
+
+namespace
+{
+    std::vector<std::uint32_t> iota_vector(std::size_t size)
+    {
+        std::vector<std::uint32_t> vec(size);
+        for (std::size_t i = 0; i < size; i++) {
+            vec[i] = static_cast<std::uint32_t>(i * 7 + 1);
+        }
+        return vec;
+    }
+}
+
+TEST_CASE("copy copies elements")
+{
+    auto const source = iota_vector(1000);
+    auto const src = ext::make_array_view(source);
+
+    SECTION("cached")
+    {
+        std::vector<std::uint32_t> dest(source.size());
+        ext::copy(ext::make_array_view(dest), src);
+        CHECK(dest == source);
+    }
+
+    SECTION("streaming")
+    {
+        std::vector<std::uint32_t> dest(source.size());
+        ext::copy(
+            ext::make_array_view(dest), src, ext::store_mode::streaming);
+        CHECK(dest == source);
+    }
+
+    SECTION("streaming at every byte offset and size")
+    {
+        std::vector<unsigned char> bytes(300);
+        for (std::size_t i = 0; i < bytes.size(); i++) {
+            bytes[i] = static_cast<unsigned char>(i);
+        }
+        for (std::size_t offset = 0; offset < 17; offset++) {
+            for (std::size_t size = 0; size < 150; size += 13) {
+                std::vector<unsigned char> dest(offset + size + 1, 0xff);
+                auto const out =
+                    ext::make_array_view(dest).subview(offset, size);
+                ext::copy(out,
+                    ext::make_array_view(bytes).as_const().first(size),
+                    ext::store_mode::streaming);
+
+                for (std::size_t i = 0; i < size; i++) {
+                    CHECK(dest[offset + i] == bytes[i]);
+                }
+                CHECK(dest[offset + size] == 0xff);
+            }
+        }
+    }
+
+    SECTION("non-trivial elements")
+    {
+        std::vector<std::string> strings = {"a", "bc", "def"};
+        std::vector<std::string> dest(3);
+        ext::copy(ext::make_array_view(dest),
+            ext::make_array_view(strings).as_const(),
+            ext::store_mode::streaming);
+        CHECK(dest == strings);
+    }
+
+    SECTION("empty views")
+    {
+        ext::copy(ext::array_view<int>{}, ext::array_view<int const>{});
+    }
+
+    SECTION("size mismatch")
+    {
+        std::vector<std::uint32_t> dest(source.size() - 1);
+        CHECK_THROWS_AS(ext::copy(ext::make_array_view(dest), src),
+            std::invalid_argument);
+    }
+}
+
+TEST_CASE("fill assigns value to all elements")
+{
+    SECTION("byte pattern")
+    {
+        std::vector<std::int32_t> vec(100, 1);
+        ext::fill(ext::make_array_view(vec), -1);
+        CHECK(vec == std::vector<std::int32_t>(100, -1));
+        ext::fill(ext::make_array_view(vec), 0);
+        CHECK(vec == std::vector<std::int32_t>(100, 0));
+    }
+
+    SECTION("general value")
+    {
+        std::vector<double> vec(100);
+        ext::fill(ext::make_array_view(vec), 1.5);
+        CHECK(vec == std::vector<double>(100, 1.5));
+    }
+
+    SECTION("streaming at every offset and size")
+    {
+        for (std::size_t offset = 0; offset < 9; offset++) {
+            for (std::size_t size = 0; size < 70; size += 5) {
+                std::vector<std::uint16_t> vec(offset + size + 1);
+                auto const out =
+                    ext::make_array_view(vec).subview(offset, size);
+                ext::fill(out, std::uint16_t{0x1234},
+                    ext::store_mode::streaming);
+
+                for (std::size_t i = 0; i < offset; i++) {
+                    CHECK(vec[i] == 0);
+                }
+                for (std::size_t i = 0; i < size; i++) {
+                    CHECK(vec[offset + i] == 0x1234);
+                }
+                CHECK(vec[offset + size] == 0);
+            }
+        }
+    }
+
+    SECTION("streaming odd-sized elements")
+    {
+        struct rgb
+        {
+            unsigned char r, g, b;
+        };
+        std::vector<rgb> pixels(50);
+        ext::fill(ext::make_array_view(pixels), rgb{1, 2, 3},
+            ext::store_mode::streaming);
+        for (auto const& pixel : pixels) {
+            CHECK(pixel.r == 1);
+            CHECK(pixel.g == 2);
+            CHECK(pixel.b == 3);
+        }
+    }
+
+    SECTION("non-trivial elements")
+    {
+        std::vector<std::string> strings(4);
+        ext::fill(ext::make_array_view(strings), std::string("x"));
+        CHECK(strings == std::vector<std::string>(4, "x"));
+    }
+}
+
+TEST_CASE("move moves elements")
+{
+    SECTION("trivial elements")
+    {
+        auto source = iota_vector(100);
+        std::vector<std::uint32_t> dest(100);
+        ext::move(ext::make_array_view(dest), ext::make_array_view(source),
+            ext::store_mode::streaming);
+        CHECK(dest == iota_vector(100));
+    }
+
+    SECTION("move-only elements")
+    {
+        std::vector<std::unique_ptr<int>> source;
+        source.emplace_back(new int(1));
+        source.emplace_back(new int(2));
+        std::vector<std::unique_ptr<int>> dest(2);
+
+        ext::move(ext::make_array_view(dest), ext::make_array_view(source));
+        CHECK(*dest[0] == 1);
+        CHECK(*dest[1] == 2);
+        CHECK(source[0] == nullptr);
+        CHECK(source[1] == nullptr);
+    }
+
+    SECTION("size mismatch")
+    {
+        std::vector<int> a(3);
+        std::vector<int> b(4);
+        CHECK_THROWS_AS(
+            ext::move(ext::make_array_view(a), ext::make_array_view(b)),
+            std::invalid_argument);
+    }
+}
@@ -0,0 +1,193 @@
+#include <array>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <array_view_nd.hpp>
+#include <catch.hpp>
+
+TEST_CASE("array_view_nd is default constructible")
+{
+    ext::array_view_nd<int, 2> view;
+    CHECK(view.data() == nullptr);
+    CHECK(view.empty());
+    CHECK(view.size() == 0);
+}
+
+TEST_CASE("array_view_nd views flat array in row-major order")
+{
+    std::vector<int> vector(12);
+    std::iota(vector.begin(), vector.end(), 0);
+
+    auto const mat = ext::make_array_view_nd(ext::make_array_view(vector), 3, 4);
+
+    CHECK(mat.rank == 2);
+    CHECK(mat.size() == 12);
+    CHECK(mat.extent(0) == 3);
+    CHECK(mat.extent(1) == 4);
+    CHECK(mat.stride(0) == 4);
+    CHECK(mat.stride(1) == 1);
+    CHECK(mat.leading_dimension() == 4);
+    CHECK(mat.is_contiguous());
+    CHECK(mat(0, 0) == 0);
+    CHECK(mat(1, 2) == 6);
+    CHECK(mat(2, 3) == 11);
+
+    mat(1, 1) = 100;
+    CHECK(vector[5] == 100);
+}
+
+TEST_CASE("array_view_nd views flat array in column-major order")
+{
+    std::vector<int> vector(12);
+    std::iota(vector.begin(), vector.end(), 0);
+
+    auto const mat = ext::make_array_view_nd<ext::column_major>(
+        ext::make_array_view(vector), 3, 4);
+
+    CHECK(mat.stride(0) == 1);
+    CHECK(mat.stride(1) == 3);
+    CHECK(mat(1, 2) == 7);
+    CHECK(mat(2, 3) == 11);
+}
+
+TEST_CASE("array_view_nd supports three dimensions")
+{
+    std::vector<int> vector(24);
+    std::iota(vector.begin(), vector.end(), 0);
+
+    auto const row = ext::make_array_view_nd(ext::make_array_view(vector), 2, 3, 4);
+    auto const col = ext::make_array_view_nd<ext::column_major>(
+        ext::make_array_view(vector), 2, 3, 4);
+
+    CHECK(row(1, 2, 3) == 23);
+    CHECK(row(1, 0, 2) == 14);
+    CHECK(col(1, 2, 3) == 23);
+    CHECK(col(1, 0, 2) == 13);
+
+    auto const plane = row.slice<0>(1);
+    CHECK(std::is_same<decltype(plane),
+        ext::array_view_nd<int, 2, ext::row_major> const>::value);
+    CHECK(plane(2, 3) == 23);
+
+    auto const lanes = row.slice<2>(1);
+    CHECK(std::is_same<decltype(lanes),
+        ext::array_view_nd<int, 2, ext::strided_layout> const>::value);
+    CHECK(lanes(1, 2) == 21);
+
+    auto const fiber = lanes.slice<1>(2);
+    CHECK(std::is_same<decltype(fiber),
+        ext::strided_array_view<int> const>::value);
+    CHECK(fiber.size() == 2);
+    CHECK(fiber[1] == 21);
+}
+
+TEST_CASE("array_view_nd supports padded rows")
+{
+    std::vector<float> vector(3 * 16);
+    auto const ld = ext::aligned_leading_dimension<float>(5, 64);
+    CHECK(ld == 16);
+
+    auto const mat = ext::make_array_view_nd(
+        ext::make_array_view(vector), std::array<std::size_t, 2>{{3, 5}}, ld);
+
+    CHECK(mat.leading_dimension() == 16);
+    CHECK_FALSE(mat.is_contiguous());
+    CHECK(&mat(1, 0) == vector.data() + 16);
+    CHECK(&mat(2, 4) == vector.data() + 36);
+    CHECK(mat.span().size() == 37);
+    CHECK(mat.row(2).data() == vector.data() + 32);
+    CHECK(mat.row(2).size() == 5);
+}
+
+TEST_CASE("array_view_nd rejects invalid shapes")
+{
+    std::vector<int> vector(12);
+    auto const view = ext::make_array_view(vector);
+
+    CHECK_THROWS_AS(ext::make_array_view_nd(view, 4, 4), std::invalid_argument);
+    CHECK_THROWS_AS(ext::make_array_view_nd(
+                        view, std::array<std::size_t, 2>{{2, 5}}, 4),
+        std::invalid_argument);
+    CHECK_THROWS_AS(ext::make_array_view_nd(
+                        view, std::array<std::size_t, 2>{{2, 5}}, 8),
+        std::invalid_argument);
+    CHECK_NOTHROW(ext::make_array_view_nd(
+        view, std::array<std::size_t, 2>{{2, 5}}, 7));
+    CHECK_THROWS_AS(ext::aligned_leading_dimension<double>(5, 12),
+        std::invalid_argument);
+}
+
+TEST_CASE("array_view_nd supports bounds-checked access")
+{
+    std::vector<int> vector(12);
+    auto const mat = ext::make_array_view_nd(ext::make_array_view(vector), 3, 4);
+
+    CHECK_NOTHROW(mat.at(2, 3));
+    CHECK_THROWS_AS(mat.at(3, 0), std::out_of_range);
+    CHECK_THROWS_AS(mat.at(0, 4), std::out_of_range);
+}
+
+TEST_CASE("array_view_nd rows and columns are array_view when contiguous")
+{
+    std::vector<int> vector(12);
+    std::iota(vector.begin(), vector.end(), 0);
+
+    SECTION("row-major")
+    {
+        auto const mat =
+            ext::make_array_view_nd(ext::make_array_view(vector), 3, 4);
+        auto const row = mat.row(1);
+        auto const col = mat.col(2);
+
+        CHECK(std::is_same<decltype(row), ext::array_view<int> const>::value);
+        CHECK(std::is_same<decltype(col),
+            ext::strided_array_view<int> const>::value);
+        CHECK(row == ext::make_array_view(vector).subview(4, 4));
+        CHECK(col.size() == 3);
+        CHECK(col[0] == 2);
+        CHECK(col[2] == 10);
+    }
+
+    SECTION("column-major")
+    {
+        auto const mat = ext::make_array_view_nd<ext::column_major>(
+            ext::make_array_view(vector), 3, 4);
+        auto const row = mat.row(1);
+        auto const col = mat.col(2);
+
+        CHECK(std::is_same<decltype(row),
+            ext::strided_array_view<int> const>::value);
+        CHECK(std::is_same<decltype(col), ext::array_view<int> const>::value);
+        CHECK(col == ext::make_array_view(vector).subview(6, 3));
+        CHECK(row.size() == 4);
+        CHECK(row[3] == 10);
+    }
+}
+
+TEST_CASE("array_view_nd can be sliced into box regions")
+{
+    std::vector<int> vector(12);
+    std::iota(vector.begin(), vector.end(), 0);
+
+    auto const mat = ext::make_array_view_nd(ext::make_array_view(vector), 3, 4);
+    auto const sub = mat.subview({{1, 1}}, {{2, 2}});
+
+    CHECK(sub.extent(0) == 2);
+    CHECK(sub.extent(1) == 2);
+    CHECK(sub.leading_dimension() == 4);
+    CHECK(sub(0, 0) == 5);
+    CHECK(sub(1, 1) == 10);
+}
+
+TEST_CASE("array_view_nd can be transformed to const view")
+{
+    std::vector<int> vector(12);
+    auto const mat = ext::make_array_view_nd(ext::make_array_view(vector), 3, 4);
+    ext::array_view_nd<int const, 2> const cmat = mat;
+
+    CHECK(cmat.data() == mat.data());
+    CHECK(cmat.extents() == mat.extents());
+    CHECK(cmat.strides() == mat.strides());
+}
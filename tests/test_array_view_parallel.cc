@@ -0,0 +1,165 @@
+#include <atomic>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <array_view_parallel.hpp>
+#include <catch.hpp>
+
+TEST_CASE("thread_pool runs every index exactly once")
+{
+    for (std::size_t const workers : {0u, 1u, 3u}) {
+        ext::thread_pool pool{workers};
+        CHECK(pool.size() == workers);
+        CHECK(pool.concurrency() == workers + 1);
+
+        std::vector<std::atomic<int>> hits(1000);
+        for (auto& hit : hits) {
+            hit = 0;
+        }
+        pool.parallel_for(hits.size(), [&](std::size_t i) { hits[i]++; });
+
+        bool all_once = true;
+        for (auto& hit : hits) {
+            all_once = all_once && hit == 1;
+        }
+        CHECK(all_once);
+    }
+}
+
+TEST_CASE("thread_pool propagates exceptions")
+{
+    ext::thread_pool pool{2};
+    CHECK_THROWS_AS(pool.parallel_for(100,
+                        [](std::size_t i) {
+                            if (i == 42) {
+                                throw std::runtime_error("failure");
+                            }
+                        }),
+        std::runtime_error);
+
+    std::atomic<std::size_t> count{0};
+    pool.parallel_for(10, [&](std::size_t) { count++; });
+    CHECK(count == 10);
+}
+
+TEST_CASE("thread_pool supports nested parallel_for")
+{
+    ext::thread_pool pool{2};
+    std::atomic<std::size_t> count{0};
+    pool.parallel_for(8, [&](std::size_t) {
+        pool.parallel_for(8, [&](std::size_t) { count++; });
+    });
+    CHECK(count == 64);
+}
+
+TEST_CASE("parallel_for_chunks partitions the view")
+{
+    std::vector<int> vector(1003);
+    auto const view = ext::make_array_view(vector);
+    ext::thread_pool pool{3};
+
+    ext::parallel_options options;
+    options.grain_size = 100;
+    options.pool = &pool;
+
+    std::atomic<std::size_t> chunks{0};
+    std::atomic<bool> oversized{false};
+    ext::parallel_for_chunks(view, [&](ext::array_view<int> chunk) {
+        if (chunk.size() > 100) {
+            oversized = true;
+        }
+        for (auto& elem : chunk) {
+            elem++;
+        }
+        chunks++;
+    }, options);
+
+    CHECK(chunks == 11);
+    CHECK_FALSE(oversized);
+    CHECK(std::accumulate(vector.begin(), vector.end(), 0) == 1003);
+}
+
+TEST_CASE("parallel_for_each visits all elements")
+{
+    std::vector<int> vector(10000);
+    std::iota(vector.begin(), vector.end(), 0);
+
+    ext::parallel_for_each(
+        ext::make_array_view(vector), [](int& elem) { elem *= 2; });
+
+    bool all_doubled = true;
+    for (std::size_t i = 0; i < vector.size(); i++) {
+        all_doubled = all_doubled && vector[i] == static_cast<int>(2 * i);
+    }
+    CHECK(all_doubled);
+}
+
+TEST_CASE("parallel_transform maps elements to output")
+{
+    std::vector<int> input(5000);
+    std::iota(input.begin(), input.end(), 0);
+    std::vector<long> output(5000);
+
+    ext::thread_pool pool{2};
+    ext::parallel_options options;
+    options.pool = &pool;
+    options.grain_size = 64;
+
+    ext::parallel_transform(ext::make_array_view(input).as_const(),
+        ext::make_array_view(output),
+        [](int x) { return static_cast<long>(x) * x; }, options);
+
+    bool all_squared = true;
+    for (std::size_t i = 0; i < input.size(); i++) {
+        all_squared = all_squared
+            && output[i] == static_cast<long>(input[i]) * input[i];
+    }
+    CHECK(all_squared);
+
+    CHECK_THROWS_AS(ext::parallel_transform(ext::make_array_view(input),
+                        ext::make_array_view(output).first(10),
+                        [](int x) { return long{x}; }),
+        std::invalid_argument);
+}
+
+TEST_CASE("parallel_reduce folds chunks in order")
+{
+    std::vector<int> vector(10000);
+    std::iota(vector.begin(), vector.end(), 1);
+    auto const view = ext::make_array_view(vector);
+
+    ext::thread_pool pool{3};
+    ext::parallel_options options;
+    options.pool = &pool;
+    options.grain_size = 7;
+
+    SECTION("sum")
+    {
+        auto const sum = ext::parallel_reduce(view, 0L,
+            [](long acc, long x) { return acc + x; }, options);
+        CHECK(sum == 50005000L);
+    }
+
+    SECTION("non-commutative operation")
+    {
+        std::vector<std::string> words = {"a", "b", "c", "d", "e", "f", "g"};
+        options.grain_size = 2;
+        auto const text = ext::parallel_reduce(ext::make_array_view(words),
+            std::string{">"},
+            [](std::string acc, std::string const& word) {
+                return acc + word;
+            },
+            options);
+        CHECK(text == ">abcdefg");
+    }
+
+    SECTION("empty view")
+    {
+        auto const sum = ext::parallel_reduce(view.first(0), 42L,
+            [](long acc, long x) { return acc + x; }, options);
+        CHECK(sum == 42);
+    }
+}
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <array_view_simd.hpp>
+#include <catch.hpp>
+
+namespace
+{
+    ext::simd::isa const all_isas[] = {ext::simd::isa::scalar,
+        ext::simd::isa::sse2, ext::simd::isa::avx2, ext::simd::isa::avx512};
+
+    std::size_t const test_sizes[] = {0, 1, 3, 8, 17, 64, 100, 1001};
+
+    // Generates a sequence with repeated values and a unique extremum in the
+    // middle to exercise tie breaking.
+    template<typename T>
+    std::vector<T> make_sequence(std::size_t size)
+    {
+        std::vector<T> seq(size);
+        for (std::size_t i = 0; i < size; i++) {
+            seq[i] = static_cast<T>((i * 7919) % 23);
+        }
+        return seq;
+    }
+
+    template<typename T>
+    void check_against_scalar()
+    {
+        for (auto const level : all_isas) {
+            for (auto const size : test_sizes) {
+                auto const seq = make_sequence<T>(size);
+                auto const view = ext::make_array_view(seq);
+
+                CHECK(ext::simd::sum(view, level)
+                    == std::accumulate(seq.begin(), seq.end(), T{}));
+                CHECK(ext::simd::dot(view, view, level)
+                    == std::inner_product(
+                        seq.begin(), seq.end(), seq.begin(), T{}));
+                CHECK(ext::simd::count(view, T{5}, level)
+                    == static_cast<std::size_t>(
+                        std::count(seq.begin(), seq.end(), T{5})));
+                CHECK(ext::simd::find(view, T{22}, level)
+                    == static_cast<std::size_t>(
+                        std::find(seq.begin(), seq.end(), T{22})
+                        - seq.begin()));
+                CHECK(ext::simd::find(view, T{99}, level) == size);
+
+                if (size == 0) {
+                    continue;
+                }
+                CHECK(ext::simd::argmin(view, level)
+                    == static_cast<std::size_t>(
+                        std::min_element(seq.begin(), seq.end())
+                        - seq.begin()));
+                CHECK(ext::simd::argmax(view, level)
+                    == static_cast<std::size_t>(
+                        std::max_element(seq.begin(), seq.end())
+                        - seq.begin()));
+                CHECK(ext::simd::min(view, level)
+                    == *std::min_element(seq.begin(), seq.end()));
+                CHECK(ext::simd::max(view, level)
+                    == *std::max_element(seq.begin(), seq.end()));
+            }
+        }
+    }
+}
+
+TEST_CASE("simd algorithms agree with scalar algorithms")
+{
+    SECTION("int32_t")
+    {
+        check_against_scalar<std::int32_t>();
+    }
+
+    SECTION("uint64_t")
+    {
+        check_against_scalar<std::uint64_t>();
+    }
+
+    SECTION("float")
+    {
+        check_against_scalar<float>();
+    }
+
+    SECTION("double")
+    {
+        check_against_scalar<double>();
+    }
+
+    SECTION("non-vectorizable type")
+    {
+        check_against_scalar<std::int16_t>();
+    }
+}
+
+TEST_CASE("simd sum of floats is accurate up to rounding")
+{
+    std::vector<float> vector(10007);
+    for (std::size_t i = 0; i < vector.size(); i++) {
+        vector[i] = 1.0f / static_cast<float>(i + 1);
+    }
+    double const expected =
+        std::accumulate(vector.begin(), vector.end(), 0.0);
+
+    for (auto const level : all_isas) {
+        auto const view = ext::make_array_view(vector);
+        CHECK(ext::simd::sum(view, level) == Approx(expected).epsilon(1e-4));
+        CHECK(ext::simd::dot(view, view, level)
+            == Approx(std::inner_product(
+                          vector.begin(), vector.end(), vector.begin(), 0.0))
+                   .epsilon(1e-4));
+    }
+}
+
+TEST_CASE("simd integer sum wraps around")
+{
+    std::vector<std::int32_t> const vector(64, INT32_MAX);
+    auto const view = ext::make_array_view(vector);
+
+    for (auto const level : all_isas) {
+        CHECK(ext::simd::sum(view, level) == std::int32_t{-64});
+    }
+}
+
+TEST_CASE("simd argmin and argmax return the first occurrence")
+{
+    std::vector<float> vector(100, 1.0f);
+    vector[40] = -1.0f;
+    vector[77] = -1.0f;
+    vector[13] = 5.0f;
+    vector[90] = 5.0f;
+    auto const view = ext::make_array_view(vector);
+
+    for (auto const level : all_isas) {
+        CHECK(ext::simd::argmin(view, level) == 40);
+        CHECK(ext::simd::argmax(view, level) == 13);
+    }
+}
+
+TEST_CASE("simd algorithms validate arguments")
+{
+    std::vector<int> const empty;
+    std::vector<int> const vector = {1, 2, 3};
+
+    CHECK_THROWS_AS(ext::simd::min(ext::make_array_view(empty)),
+        std::out_of_range);
+    CHECK_THROWS_AS(ext::simd::max(ext::make_array_view(empty)),
+        std::out_of_range);
+    CHECK_THROWS_AS(ext::simd::dot(ext::make_array_view(vector),
+                        ext::make_array_view(vector).first(2)),
+        std::invalid_argument);
+    CHECK(ext::simd::argmin(ext::make_array_view(empty)) == 0);
+}
+
+TEST_CASE("simd algorithms accept mutable views")
+{
+    std::vector<double> vector = {3, 1, 2};
+    ext::array_view<double> const view = ext::make_array_view(vector);
+
+    CHECK(ext::simd::sum(view) == 6);
+    CHECK(ext::simd::min(view) == 1);
+    CHECK(ext::simd::find(view, 2) == 2);
+}
@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <array_view_sort.hpp>
+#include <catch.hpp>
+
+namespace
+{
+    template<typename T>
+    std::vector<T> random_vector(std::size_t size, T low, T high)
+    {
+        std::mt19937_64 random{size};
+        std::uniform_int_distribution<T> dist{low, high};
+        std::vector<T> vec(size);
+        for (auto& value : vec) {
+            value = dist(random);
+        }
+        return vec;
+    }
+
+    struct record
+    {
+        std::int32_t key;
+        std::size_t order;
+    };
+}
+
+TEST_CASE("radix_sort sorts integers")
+{
+    SECTION("unsigned")
+    {
+        auto vec = random_vector<std::uint64_t>(
+            5000, 0, std::numeric_limits<std::uint64_t>::max());
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+
+        ext::radix_sort(ext::make_array_view(vec));
+        CHECK(vec == expected);
+    }
+
+    SECTION("signed")
+    {
+        auto vec = random_vector<std::int32_t>(5000, -1000000, 1000000);
+        vec.push_back(std::numeric_limits<std::int32_t>::min());
+        vec.push_back(std::numeric_limits<std::int32_t>::max());
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+
+        ext::radix_sort(ext::make_array_view(vec));
+        CHECK(vec == expected);
+    }
+
+    SECTION("bytes")
+    {
+        std::vector<std::int8_t> vec = {3, -1, 127, -128, 0, 3};
+        ext::radix_sort(ext::make_array_view(vec));
+        CHECK(vec == std::vector<std::int8_t>{-128, -1, 0, 3, 3, 127});
+    }
+
+    SECTION("keys sharing high bytes")
+    {
+        auto vec = random_vector<std::uint32_t>(1000, 0, 255);
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+
+        ext::radix_sort(ext::make_array_view(vec));
+        CHECK(vec == expected);
+    }
+
+    SECTION("empty and single")
+    {
+        std::vector<int> empty;
+        ext::radix_sort(ext::make_array_view(empty));
+
+        std::vector<int> single = {42};
+        ext::radix_sort(ext::make_array_view(single));
+        CHECK(single == std::vector<int>{42});
+    }
+}
+
+TEST_CASE("radix_sort sorts floating-point numbers")
+{
+    auto const inf = std::numeric_limits<double>::infinity();
+    std::vector<double> vec = {
+        1.5, -0.0, -inf, 2.0, -3.25, 0.0, inf, 1e-300, -1e-300, -2.0};
+    ext::radix_sort(ext::make_array_view(vec));
+
+    CHECK(std::is_sorted(vec.begin(), vec.end()));
+    CHECK(vec.front() == -inf);
+    CHECK(vec.back() == inf);
+    CHECK(std::signbit(vec[4]));
+    CHECK_FALSE(std::signbit(vec[5]));
+
+    std::vector<float> floats = {0.5f, -0.25f, 3.0f, -8.0f};
+    ext::radix_sort(ext::make_array_view(floats));
+    CHECK(floats == std::vector<float>{-8.0f, -0.25f, 0.5f, 3.0f});
+}
+
+TEST_CASE("radix_sort uses caller-provided scratch")
+{
+    auto vec = random_vector<std::uint16_t>(100, 0, 65535);
+    auto expected = vec;
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<std::uint16_t> scratch(200);
+    ext::radix_sort(ext::make_array_view(vec), ext::make_array_view(scratch));
+    CHECK(vec == expected);
+
+    std::vector<std::uint16_t> small(99);
+    CHECK_THROWS_AS(ext::radix_sort(ext::make_array_view(vec),
+                        ext::make_array_view(small)),
+        std::invalid_argument);
+}
+
+TEST_CASE("radix_sort_by sorts records stably")
+{
+    auto const keys = random_vector<std::int32_t>(3000, -50, 50);
+    std::vector<record> records(keys.size());
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        records[i] = {keys[i], i};
+    }
+    auto expected = records;
+    std::stable_sort(expected.begin(), expected.end(),
+        [](record const& lhs, record const& rhs) {
+            return lhs.key < rhs.key;
+        });
+
+    ext::radix_sort_by(ext::make_array_view(records),
+        [](record const& r) { return r.key; });
+
+    REQUIRE(records.size() == expected.size());
+    for (std::size_t i = 0; i < records.size(); i++) {
+        CHECK(records[i].key == expected[i].key);
+        CHECK(records[i].order == expected[i].order);
+    }
+}
+
+TEST_CASE("parallel_radix_sort matches radix_sort")
+{
+    ext::thread_pool pool{3};
+    ext::parallel_options options;
+    options.pool = &pool;
+    options.grain_size = 1000;
+
+    SECTION("integers")
+    {
+        auto vec = random_vector<std::int64_t>(
+            10007, std::numeric_limits<std::int64_t>::min(),
+            std::numeric_limits<std::int64_t>::max());
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+
+        ext::parallel_radix_sort(ext::make_array_view(vec), options);
+        CHECK(vec == expected);
+    }
+
+    SECTION("records")
+    {
+        auto const keys = random_vector<std::int32_t>(10007, -100, 100);
+        std::vector<record> records(keys.size());
+        for (std::size_t i = 0; i < keys.size(); i++) {
+            records[i] = {keys[i], i};
+        }
+        auto expected = records;
+        std::stable_sort(expected.begin(), expected.end(),
+            [](record const& lhs, record const& rhs) {
+                return lhs.key < rhs.key;
+            });
+
+        std::vector<record> scratch(records.size());
+        ext::parallel_radix_sort_by(ext::make_array_view(records),
+            ext::make_array_view(scratch),
+            [](record const& r) { return r.key; }, options);
+
+        for (std::size_t i = 0; i < records.size(); i++) {
+            CHECK(records[i].order == expected[i].order);
+        }
+    }
+
+    SECTION("default grain")
+    {
+        auto vec = random_vector<std::uint32_t>(
+            100000, 0, std::numeric_limits<std::uint32_t>::max());
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+
+        options.grain_size = 0;
+        ext::parallel_radix_sort(ext::make_array_view(vec), options);
+        CHECK(vec == expected);
+    }
+}
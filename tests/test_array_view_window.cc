@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <array_view_window.hpp>
+#include <catch.hpp>
+
+namespace
+{
+    // Reference aggregates rescanning every window.
+    template<typename T>
+    std::vector<T> rescan(std::vector<T> const& src, std::size_t length,
+        ext::window_aggregate which)
+    {
+        std::vector<T> result;
+        for (std::size_t i = 0; i + length <= src.size(); i++) {
+            auto const begin = src.begin() + static_cast<long>(i);
+            auto const end = begin + static_cast<long>(length);
+            switch (which) {
+              case ext::window_aggregate::min:
+                result.push_back(*std::min_element(begin, end));
+                break;
+              case ext::window_aggregate::max:
+                result.push_back(*std::max_element(begin, end));
+                break;
+              case ext::window_aggregate::sum:
+                result.push_back(std::accumulate(begin, end, T()));
+                break;
+              case ext::window_aggregate::mean:
+                result.push_back(std::accumulate(begin, end, T())
+                    / static_cast<T>(length));
+                break;
+            }
+        }
+        return result;
+    }
+
+    std::vector<int> random_ints(std::size_t n)
+    {
+        std::mt19937 engine{42};
+        std::uniform_int_distribution<int> dist{-1000, 1000};
+        std::vector<int> values(n);
+        for (auto& value : values) {
+            value = dist(engine);
+        }
+        return values;
+    }
+}
+
+TEST_CASE("sliding_min and sliding_max match rescanning")
+{
+    auto const values = random_ints(500);
+    auto const src = ext::make_array_view(values);
+
+    std::size_t const lengths[] = {1, 2, 3, 7, 64, 499, 500};
+    for (auto const length : lengths) {
+        std::vector<int> result(ext::window_count(values.size(), length));
+        auto const dest = ext::make_array_view(result);
+
+        ext::sliding_min(src, length, dest);
+        CHECK(result == rescan(values, length, ext::window_aggregate::min));
+
+        ext::sliding_max(src.as_const(), length, dest);
+        CHECK(result == rescan(values, length, ext::window_aggregate::max));
+    }
+}
+
+TEST_CASE("sliding_min handles monotonic and constant input")
+{
+    std::vector<int> const rising = {1, 2, 3, 4, 5, 6};
+    std::vector<int> const falling = {6, 5, 4, 3, 2, 1};
+    std::vector<int> const flat = {3, 3, 3, 3};
+    std::vector<int> result(4);
+    auto const dest = ext::make_array_view(result);
+
+    ext::sliding_min(ext::make_array_view(rising), 3, dest);
+    CHECK(result == (std::vector<int>{1, 2, 3, 4}));
+    ext::sliding_min(ext::make_array_view(falling), 3, dest);
+    CHECK(result == (std::vector<int>{4, 3, 2, 1}));
+    ext::sliding_max(ext::make_array_view(falling), 3, dest);
+    CHECK(result == (std::vector<int>{6, 5, 4, 3}));
+    ext::sliding_max(ext::make_array_view(flat), 1, dest);
+    CHECK(result == flat);
+}
+
+TEST_CASE("sliding_sum and sliding_mean match rescanning")
+{
+    auto const values = random_ints(300);
+    auto const src = ext::make_array_view(values);
+
+    std::size_t const lengths[] = {1, 5, 32, 300};
+    for (auto const length : lengths) {
+        std::vector<int> result(ext::window_count(values.size(), length));
+        auto const dest = ext::make_array_view(result);
+
+        ext::sliding_sum(src, length, dest);
+        CHECK(result == rescan(values, length, ext::window_aggregate::sum));
+
+        ext::sliding_mean(src, length, dest);
+        CHECK(
+            result == rescan(values, length, ext::window_aggregate::mean));
+    }
+}
+
+TEST_CASE("sliding_sum with compensated summation")
+{
+    // Large values passing through the window leave rounding errors in a
+    // naive running sum of the small values that follow.
+    std::vector<double> values;
+    for (int i = 0; i < 1000; i++) {
+        values.push_back(i % 2 == 0 ? 1e16 : 0.1);
+    }
+    for (int i = 0; i < 100; i++) {
+        values.push_back(0.1);
+    }
+    std::size_t const length = 10;
+    std::vector<double> result(ext::window_count(values.size(), length));
+    auto const src = ext::make_array_view(values);
+    auto const dest = ext::make_array_view(result);
+
+    ext::sliding_sum(src, length, dest, ext::summation::compensated);
+    CHECK(result.back() == Approx(1.0).epsilon(1e-12));
+
+    ext::sliding_sum(src, length, dest, ext::summation::naive);
+    CHECK(std::abs(result.back() - 1.0) > 1e-3);
+
+    ext::sliding_mean(src, length, dest, ext::summation::compensated);
+    CHECK(result.back() == Approx(0.1).epsilon(1e-12));
+}
+
+TEST_CASE("sliding window functions validate arguments")
+{
+    std::vector<int> const values = {1, 2, 3};
+    std::vector<int> result(2);
+    auto const src = ext::make_array_view(values);
+    auto const dest = ext::make_array_view(result);
+
+    CHECK(ext::window_count(3, 2) == 2);
+    CHECK(ext::window_count(3, 4) == 0);
+
+    CHECK_THROWS_AS(ext::sliding_min(src, 0, dest), std::invalid_argument);
+    CHECK_THROWS_AS(ext::sliding_max(src, 1, dest), std::invalid_argument);
+    CHECK_THROWS_AS(ext::sliding_sum(src, 3, dest), std::invalid_argument);
+    CHECK_NOTHROW(ext::sliding_mean(src, 4, dest.first(0)));
+}
+
+TEST_CASE("sliding_window aggregates a stream")
+{
+    ext::sliding_window<int> window{3};
+    CHECK(window.length() == 3);
+    CHECK(window.empty());
+
+    window.push(5);
+    CHECK(window.size() == 1);
+    CHECK_FALSE(window.full());
+    CHECK(window.min() == 5);
+    CHECK(window.max() == 5);
+    CHECK(window.sum() == 5);
+
+    std::vector<int> const more = {1, 9, 4};
+    window.push(ext::make_array_view(more));
+    CHECK(window.full());
+    CHECK(window.size() == 3);
+    CHECK(window.count() == 4);
+    CHECK(window.min() == 1);
+    CHECK(window.max() == 9);
+    CHECK(window.sum() == 14);
+    CHECK(window.mean() == 4);
+    CHECK(window.get(ext::window_aggregate::max) == 9);
+
+    window.clear();
+    CHECK(window.empty());
+    window.push(7);
+    CHECK(window.min() == 7);
+    CHECK(window.sum() == 7);
+
+    CHECK_THROWS_AS(ext::sliding_window<int>(0), std::invalid_argument);
+}
+
+TEST_CASE("sliding_window batches match the batch functions")
+{
+    auto const values = random_ints(1000);
+    std::size_t const length = 37;
+    auto const aggregates = {ext::window_aggregate::min,
+        ext::window_aggregate::max, ext::window_aggregate::sum,
+        ext::window_aggregate::mean};
+
+    for (auto const which : aggregates) {
+        ext::sliding_window<int> window{length};
+        std::vector<int> streamed;
+        std::vector<int> buffer(values.size());
+
+        // Uneven batches, including empty ones and ones shorter than the
+        // window.
+        std::size_t offset = 0;
+        for (std::size_t batch = 0; offset < values.size(); batch++) {
+            auto const size =
+                std::min((batch * 7) % 50, values.size() - offset);
+            auto const n = window.push(
+                ext::make_array_view(values).subview(offset, size),
+                which, ext::make_array_view(buffer));
+            streamed.insert(streamed.end(), buffer.begin(),
+                buffer.begin() + static_cast<long>(n));
+            offset += size;
+        }
+
+        CHECK(streamed == rescan(values, length, which));
+    }
+
+    ext::sliding_window<int> window{length};
+    std::vector<int> small(1);
+    CHECK_THROWS_AS(window.push(ext::make_array_view(values).first(2),
+                        ext::window_aggregate::sum,
+                        ext::make_array_view(small)),
+        std::invalid_argument);
+}
+
+TEST_CASE("sliding_window with compensated summation")
+{
+    ext::sliding_window<double> naive{4};
+    ext::sliding_window<double> compensated{4, ext::summation::compensated};
+    for (int i = 0; i < 1000; i++) {
+        auto const value = i % 2 == 0 ? 1e16 : 0.1;
+        naive.push(value);
+        compensated.push(value);
+    }
+    for (int i = 0; i < 4; i++) {
+        naive.push(0.25);
+        compensated.push(0.25);
+    }
+    CHECK(compensated.sum() == Approx(1.0).epsilon(1e-12));
+    CHECK(std::abs(naive.sum() - 1.0) > 1e-3);
+}
@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <eytzinger_index.hpp>
+#include <catch.hpp>
+
+namespace
+{
+    std::size_t std_lower_bound(
+        std::vector<std::uint32_t> const& sorted, std::uint32_t value)
+    {
+        return static_cast<std::size_t>(
+            std::lower_bound(sorted.begin(), sorted.end(), value)
+            - sorted.begin());
+    }
+}
+
+TEST_CASE("eytzinger_index finds lower bounds")
+{
+    for (std::size_t size = 0; size < 70; size++) {
+        // Even keys with duplicates.
+        std::vector<std::uint32_t> sorted(size);
+        for (std::size_t i = 0; i < size; i++) {
+            sorted[i] = static_cast<std::uint32_t>(i / 3 * 2);
+        }
+        ext::eytzinger_index<std::uint32_t> const index{
+            ext::make_array_view(sorted)};
+        CHECK(index.size() == size);
+
+        for (std::uint32_t value = 0; value < 2 * size + 2; value++) {
+            CHECK(index.lower_bound(value) == std_lower_bound(sorted, value));
+        }
+    }
+}
+
+TEST_CASE("eytzinger_index positions around full levels")
+{
+    // The last level of the tree is empty, partly filled or full.
+    std::size_t const sizes[] = {
+        127, 128, 129, 191, 254, 255, 256, 511, 512, 700, 1023, 1024, 1025};
+
+    for (auto const size : sizes) {
+        std::vector<std::uint32_t> sorted(size);
+        for (std::size_t i = 0; i < size; i++) {
+            sorted[i] = static_cast<std::uint32_t>(2 * i + 1);
+        }
+        auto const index =
+            ext::make_eytzinger_index(ext::make_array_view(sorted));
+
+        bool match = true;
+        for (std::uint32_t value = 0; value < 2 * size + 2; value++) {
+            match = match
+                && index.lower_bound(value) == std_lower_bound(sorted, value);
+        }
+        CHECK(match);
+    }
+}
+
+TEST_CASE("eytzinger_index batched lookup matches single lookups")
+{
+    std::mt19937 random;
+    std::uniform_int_distribution<std::uint32_t> dist{0, 100000};
+
+    std::vector<std::uint32_t> sorted(10000);
+    for (auto& key : sorted) {
+        key = dist(random);
+    }
+    std::sort(sorted.begin(), sorted.end());
+    auto const index =
+        ext::make_eytzinger_index(ext::make_array_view(sorted));
+
+    std::vector<std::uint32_t> queries(1003);
+    for (auto& query : queries) {
+        query = dist(random);
+    }
+    std::vector<std::size_t> results(queries.size());
+    index.lower_bound(ext::make_array_view(queries).as_const(),
+        ext::make_array_view(results));
+
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        CHECK(results[i] == std_lower_bound(sorted, queries[i]));
+    }
+
+    SECTION("size mismatch")
+    {
+        CHECK_THROWS_AS(
+            index.lower_bound(ext::make_array_view(queries).as_const(),
+                ext::make_array_view(results).first(10)),
+            std::invalid_argument);
+    }
+}
+
+TEST_CASE("eytzinger_index works with other key types")
+{
+    std::vector<double> sorted = {-1.5, 0.0, 0.5, 2.0, 8.0};
+    auto const index =
+        ext::make_eytzinger_index(ext::make_array_view(sorted));
+
+    CHECK(index.lower_bound(-2.0) == 0);
+    CHECK(index.lower_bound(0.25) == 2);
+    CHECK(index.lower_bound(2.0) == 3);
+    CHECK(index.lower_bound(9.0) == 5);
+}
+
+TEST_CASE("eytzinger_index edge cases")
+{
+    SECTION("empty")
+    {
+        ext::eytzinger_index<int> const index;
+        CHECK(index.empty());
+        CHECK(index.lower_bound(1) == 0);
+
+        std::vector<int> const queries = {1, 2};
+        std::vector<std::size_t> results(2, 9);
+        index.lower_bound(
+            ext::make_array_view(queries), ext::make_array_view(results));
+        CHECK(results == std::vector<std::size_t>{0, 0});
+    }
+
+    SECTION("unsorted keys")
+    {
+        std::vector<int> const keys = {1, 3, 2};
+        CHECK_THROWS_AS(ext::make_eytzinger_index(ext::make_array_view(keys)),
+            std::invalid_argument);
+    }
+
+    SECTION("copies are independent of the source")
+    {
+        std::vector<int> keys = {1, 2, 3};
+        auto index = ext::make_eytzinger_index(ext::make_array_view(keys));
+        keys.assign(3, 0);
+        auto const copy = index;
+        CHECK(copy.lower_bound(2) == 1);
+        CHECK(copy.lower_bound(4) == 3);
+    }
+
+    SECTION("assigned and moved indices")
+    {
+        std::vector<char> const keys = {'a', 'c', 'e', 'g', 'i'};
+        auto const source =
+            ext::make_eytzinger_index(ext::make_array_view(keys));
+
+        ext::eytzinger_index<char> assigned;
+        assigned = source;
+        CHECK(assigned.lower_bound('d') == 2);
+
+        auto moved = std::move(assigned);
+        CHECK(moved.lower_bound('h') == 4);
+        CHECK(assigned.empty());
+        CHECK(assigned.lower_bound('a') == 0);
+
+        assigned = std::move(moved);
+        CHECK(assigned.lower_bound('j') == 5);
+    }
+
+    SECTION("copies of empty indices")
+    {
+        ext::eytzinger_index<int> const empty;
+        auto const copy = empty;
+        CHECK(copy.empty());
+        CHECK(copy.lower_bound(1) == 0);
+
+        std::vector<int> const keys = {1, 2, 3};
+        auto source = ext::make_eytzinger_index(ext::make_array_view(keys));
+        auto const moved = std::move(source);
+        auto const copy_of_moved = source;
+        CHECK(copy_of_moved.empty());
+        CHECK(moved.lower_bound(3) == 2);
+
+        source = moved;
+        source = empty;
+        CHECK(source.empty());
+        CHECK(source.lower_bound(2) == 0);
+    }
+}
@@ -54,12 +54,23 @@ TEST_CASE("array_view can access std::array")
     }
 }
 
-TEST_CASE("array_view can access std::vector with custom allocator")
+namespace
 {
-    class custom_int_allocator : public std::allocator<int>
-    {
+    template<typename T>
+    class custom_allocator : public std::allocator<T>
+    {
+      public:
+        template<typename U>
+        struct rebind
+        {
+            using other = custom_allocator<U>;
+        };
     };
-    std::vector<int, custom_int_allocator> vector = {0, 1, 2, 3};
+}
+
+TEST_CASE("array_view can access std::vector with custom allocator")
+{
+    std::vector<int, custom_allocator<int>> vector = {0, 1, 2, 3};
 
     SECTION("smoke test")
     {
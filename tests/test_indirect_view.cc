@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <indirect_view.hpp>
+#include <catch.hpp>
+
+namespace
+{
+    ext::simd::isa const all_isas[] = {ext::simd::isa::scalar,
+        ext::simd::isa::sse2, ext::simd::isa::avx2, ext::simd::isa::avx512};
+}
+
+TEST_CASE("indirect_view selects elements by index")
+{
+    std::vector<int> data = {10, 11, 12, 13, 14};
+    std::vector<std::uint32_t> const indices = {4, 0, 2, 2};
+    auto const view = ext::make_indirect_view(
+        ext::make_array_view(data), ext::make_array_view(indices));
+
+    CHECK(view.size() == 4);
+    CHECK_FALSE(view.empty());
+    CHECK(view[0] == 14);
+    CHECK(view[1] == 10);
+    CHECK(view.front() == 14);
+    CHECK(view.back() == 12);
+    CHECK(view.at(2) == 12);
+    CHECK_THROWS_AS(view.at(4), std::out_of_range);
+
+    std::vector<int> const visited(view.begin(), view.end());
+    CHECK(visited == std::vector<int>{14, 10, 12, 12});
+
+    std::vector<int> const reversed(view.rbegin(), view.rend());
+    CHECK(reversed == std::vector<int>{12, 12, 10, 14});
+
+    SECTION("writes through to the data")
+    {
+        view[1] = -1;
+        CHECK(data[0] == -1);
+        for (auto& value : view.last(2)) {
+            value++;
+        }
+        CHECK(data[2] == 14);
+    }
+
+    SECTION("subviews")
+    {
+        CHECK(view.first(2).size() == 2);
+        CHECK(view.last(1).front() == 12);
+        CHECK(view.drop_first(1).front() == 10);
+        CHECK(view.drop_last(3).back() == 14);
+        CHECK(view.subview(1, 2)[1] == 12);
+    }
+
+    SECTION("conversion to const")
+    {
+        ext::indirect_view<int const> const cview = view;
+        CHECK(cview[0] == 14);
+        CHECK(view.as_const().size() == 4);
+
+        ext::indirect_iterator<int const> it = view.begin();
+        CHECK(*(it + 3) == 12);
+        CHECK(view.end() - view.begin() == 4);
+    }
+
+    SECTION("out-of-bounds index")
+    {
+        std::vector<std::uint32_t> const bad = {0, 5};
+        CHECK_THROWS_AS(ext::make_indirect_view(ext::make_array_view(data),
+                            ext::make_array_view(bad)),
+            std::out_of_range);
+    }
+
+    SECTION("default is empty")
+    {
+        ext::indirect_view<int> const empty;
+        CHECK(empty.empty());
+        CHECK(empty.begin() == empty.end());
+    }
+}
+
+TEST_CASE("gather copies selected elements")
+{
+    std::vector<std::uint32_t> indices(101);
+    for (std::size_t i = 0; i < indices.size(); i++) {
+        indices[i] = static_cast<std::uint32_t>((i * 37) % 200);
+    }
+    auto const idx = ext::make_array_view(indices).as_const();
+
+    SECTION("4-byte elements")
+    {
+        std::vector<float> data(200);
+        for (std::size_t i = 0; i < data.size(); i++) {
+            data[i] = static_cast<float>(i) * 0.5f;
+        }
+        auto const src = ext::make_indirect_view(
+            ext::make_array_view(data).as_const(), idx);
+
+        for (auto const level : all_isas) {
+            std::vector<float> out(indices.size());
+            ext::gather(ext::make_array_view(out), src, level);
+            CHECK(std::equal(out.begin(), out.end(), src.begin()));
+        }
+    }
+
+    SECTION("8-byte elements")
+    {
+        std::vector<std::int64_t> data(200);
+        for (std::size_t i = 0; i < data.size(); i++) {
+            data[i] = static_cast<std::int64_t>(i) * -1000000007;
+        }
+        auto const src =
+            ext::make_indirect_view(ext::make_array_view(data), idx);
+
+        for (auto const level : all_isas) {
+            std::vector<std::int64_t> out(indices.size());
+            ext::gather(ext::make_array_view(out), src, level);
+            CHECK(std::equal(out.begin(), out.end(), src.begin()));
+        }
+    }
+
+    SECTION("other elements")
+    {
+        std::vector<std::string> data = {"a", "b", "c"};
+        std::vector<std::uint32_t> const picks = {2, 0};
+        std::vector<std::string> out(2);
+        ext::gather(ext::make_array_view(out),
+            ext::make_indirect_view(ext::make_array_view(data),
+                ext::make_array_view(picks)));
+        CHECK(out == std::vector<std::string>{"c", "a"});
+    }
+
+    SECTION("size mismatch")
+    {
+        std::vector<int> data(200);
+        std::vector<int> out(100);
+        CHECK_THROWS_AS(ext::gather(ext::make_array_view(out),
+                            ext::make_indirect_view(
+                                ext::make_array_view(data), idx)),
+            std::invalid_argument);
+    }
+}
+
+TEST_CASE("scatter assigns selected elements")
+{
+    SECTION("distinct indices")
+    {
+        std::vector<std::uint32_t> indices(50);
+        for (std::size_t i = 0; i < indices.size(); i++) {
+            indices[i] = static_cast<std::uint32_t>((i * 7) % 50);
+        }
+        std::vector<std::uint32_t> values(50);
+        for (std::size_t i = 0; i < values.size(); i++) {
+            values[i] = static_cast<std::uint32_t>(i + 100);
+        }
+
+        for (auto const level : all_isas) {
+            std::vector<std::uint32_t> data(60);
+            ext::scatter(ext::make_indirect_view(ext::make_array_view(data),
+                             ext::make_array_view(indices)),
+                ext::make_array_view(values).as_const(), level);
+            for (std::size_t i = 0; i < indices.size(); i++) {
+                CHECK(data[indices[i]] == values[i]);
+            }
+            CHECK(data[55] == 0);
+        }
+    }
+
+    SECTION("repeated indices keep the last value")
+    {
+        std::vector<std::uint32_t> const indices(20, 3);
+        std::vector<double> values(20);
+        for (std::size_t i = 0; i < values.size(); i++) {
+            values[i] = static_cast<double>(i);
+        }
+
+        for (auto const level : all_isas) {
+            std::vector<double> data(5);
+            ext::scatter(ext::make_indirect_view(ext::make_array_view(data),
+                             ext::make_array_view(indices)),
+                ext::make_array_view(values), level);
+            CHECK(data[3] == 19.0);
+        }
+    }
+}
@@ -0,0 +1,149 @@
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <mapped_file.hpp>
+#include <catch.hpp>
+
+namespace
+{
+    // Temporary file removed on scope exit.
+    class temporary_file
+    {
+      public:
+        explicit temporary_file(std::vector<std::uint32_t> const& content)
+        {
+            char path[] = "/tmp/array_view_test_XXXXXX";
+            int const fd = ::mkstemp(path);
+            REQUIRE(fd != -1);
+            auto const size = content.size() * sizeof(std::uint32_t);
+            REQUIRE(::write(fd, content.data(), size)
+                == static_cast<ssize_t>(size));
+            ::close(fd);
+            path_ = path;
+        }
+
+        ~temporary_file()
+        {
+            std::remove(path_.c_str());
+        }
+
+        std::string const& path() const
+        {
+            return path_;
+        }
+
+      private:
+        std::string path_;
+    };
+}
+
+TEST_CASE("mapped_file - default construction")
+{
+    ext::mapped_file file;
+    CHECK(file.empty());
+    CHECK(file.size() == 0);
+    CHECK(file.data() == nullptr);
+    CHECK(file.view<int>().empty());
+}
+
+TEST_CASE("mapped_file - read-only mapping")
+{
+    temporary_file const tmp{{1, 2, 3, 4, 5, 6}};
+
+    SECTION("whole file")
+    {
+        ext::mapped_file file{tmp.path()};
+        CHECK(file.mode() == ext::map_mode::read_only);
+        CHECK(file.size() == 24);
+        file.advise(ext::map_advice::sequential);
+
+        auto const view = file.view<std::uint32_t>();
+        CHECK(view.size() == 6);
+        CHECK(view[0] == 1);
+        CHECK(view[5] == 6);
+
+        CHECK_THROWS_AS(file.writable_view<std::uint32_t>(),
+            std::invalid_argument);
+    }
+
+    SECTION("offset and length")
+    {
+        ext::mapped_file file{tmp.path(), ext::map_mode::read_only, 8, 12};
+        CHECK(file.size() == 12);
+
+        auto const view = file.view<std::uint32_t>();
+        CHECK(view.size() == 3);
+        CHECK(view[0] == 3);
+        CHECK(view[2] == 5);
+
+        CHECK_THROWS_AS(file.view<std::uint64_t>(), std::invalid_argument);
+    }
+
+    SECTION("misaligned offset")
+    {
+        ext::mapped_file file{tmp.path(), ext::map_mode::read_only, 2, 8};
+        CHECK(file.bytes().size() == 8);
+        CHECK_THROWS_AS(file.view<std::uint32_t>(), std::invalid_argument);
+    }
+
+    SECTION("out of range")
+    {
+        CHECK_THROWS_AS(
+            ext::mapped_file(tmp.path(), ext::map_mode::read_only, 25),
+            std::out_of_range);
+        CHECK_THROWS_AS(
+            ext::mapped_file(tmp.path(), ext::map_mode::read_only, 20, 8),
+            std::out_of_range);
+        CHECK(ext::mapped_file(tmp.path(), ext::map_mode::read_only, 24)
+                  .empty());
+    }
+
+    SECTION("missing file")
+    {
+        CHECK_THROWS_AS(ext::mapped_file(tmp.path() + ".missing"),
+            std::system_error);
+    }
+}
+
+TEST_CASE("mapped_file - read-write mapping")
+{
+    temporary_file const tmp{{1, 2, 3, 4}};
+
+    {
+        ext::mapped_file file{tmp.path(), ext::map_mode::read_write};
+        auto const view = file.writable_view<std::uint32_t>();
+        view[1] = 20;
+        view[3] = 40;
+        file.flush();
+    }
+
+    ext::mapped_file file{tmp.path()};
+    auto const view = file.view<std::uint32_t>();
+    CHECK(view[0] == 1);
+    CHECK(view[1] == 20);
+    CHECK(view[3] == 40);
+}
+
+TEST_CASE("mapped_file - move")
+{
+    temporary_file const tmp{{7, 8}};
+
+    ext::mapped_file file{tmp.path()};
+    auto const data = file.data();
+
+    ext::mapped_file moved{std::move(file)};
+    CHECK(file.empty());
+    CHECK(moved.data() == data);
+    CHECK(moved.view<std::uint32_t>()[1] == 8);
+
+    file = std::move(moved);
+    CHECK(moved.empty());
+    CHECK(file.data() == data);
+}
@@ -0,0 +1,187 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <packed_array_view.hpp>
+#include <catch.hpp>
+
+namespace
+{
+    ext::simd::isa const all_isas[] = {ext::simd::isa::scalar,
+        ext::simd::isa::sse2, ext::simd::isa::avx2, ext::simd::isa::avx512};
+
+    std::vector<std::uint32_t> random_values(std::size_t size, unsigned bits)
+    {
+        std::mt19937 random{bits};
+        std::vector<std::uint32_t> values(size);
+        for (auto& value : values) {
+            value = static_cast<std::uint32_t>(
+                random() & ((std::uint64_t(1) << bits) - 1));
+        }
+        return values;
+    }
+}
+
+TEST_CASE("packed_array_view stores values of compile-time width")
+{
+    std::vector<std::uint64_t> words(ext::packed_word_count(10, 20));
+    CHECK(words.size() == 4);
+
+    ext::packed_array_view<20> const view{ext::make_array_view(words), 10};
+    CHECK(view.bits() == 20);
+    CHECK(view.size() == 10);
+    CHECK(view.max_value() == 0xfffff);
+
+    for (std::size_t i = 0; i < view.size(); i++) {
+        view[i] = static_cast<std::uint32_t>(i * 100003);
+    }
+    for (std::size_t i = 0; i < view.size(); i++) {
+        CHECK(view.get(i) == (i * 100003) % (1 << 20));
+        CHECK(view[i] == (i * 100003) % (1 << 20));
+    }
+
+    // Value 3 straddles the first and second words.
+    view.set(3, 0xabcde);
+    CHECK(view[3] == 0xabcde);
+    CHECK(view[2] == 200006);
+    CHECK(view[4] == 400012 % (1 << 20));
+
+    CHECK(view.at(9) == view[9]);
+    CHECK_THROWS_AS(view.at(10), std::out_of_range);
+}
+
+TEST_CASE("packed_array_view with run-time width")
+{
+    for (unsigned bits = 1; bits <= 32; bits++) {
+        auto const values = random_values(100, bits);
+        std::vector<std::uint64_t> words(ext::packed_word_count(100, bits));
+        auto const view = ext::make_packed_array_view(
+            ext::make_array_view(words), 100, bits);
+
+        for (std::size_t i = 0; i < values.size(); i++) {
+            view[i] = values[i];
+        }
+        for (std::size_t i = 0; i < values.size(); i++) {
+            CHECK(view[i] == values[i]);
+        }
+    }
+
+    std::vector<std::uint64_t> words(2);
+    auto const w = ext::make_array_view(words);
+    CHECK_THROWS_AS(ext::make_packed_array_view(w, 1, 0),
+        std::invalid_argument);
+    CHECK_THROWS_AS(ext::make_packed_array_view(w, 1, 33),
+        std::invalid_argument);
+    CHECK_THROWS_AS(ext::make_packed_array_view(w, 7, 20),
+        std::invalid_argument);
+    CHECK_THROWS_AS((ext::packed_array_view<20>{w, 1, 21}),
+        std::invalid_argument);
+}
+
+TEST_CASE("packed_array_view iterates through proxies")
+{
+    std::vector<std::uint64_t> words(ext::packed_word_count(8, 17));
+    ext::packed_array_view<17> const view{ext::make_array_view(words), 8};
+
+    std::uint32_t next = 1;
+    for (auto ref : view) {
+        ref = next++;
+    }
+    std::vector<std::uint32_t> const seen(view.begin(), view.end());
+    CHECK(seen == std::vector<std::uint32_t>{1, 2, 3, 4, 5, 6, 7, 8});
+
+    std::vector<std::uint32_t> const reversed(view.rbegin(), view.rend());
+    CHECK(reversed.front() == 8);
+
+    view[0] = view[7];
+    CHECK(view[0] == 8);
+    CHECK(view.end() - view.begin() == 8);
+
+    SECTION("read-only view")
+    {
+        ext::packed_array_view<17, std::uint64_t const> const cview = view;
+        CHECK(cview[1] == 2);
+        CHECK(*(cview.begin() + 2) == 3);
+        CHECK(view.as_const().size() == 8);
+    }
+
+    SECTION("subviews")
+    {
+        auto const sub = view.subview(3, 4);
+        CHECK(sub.size() == 4);
+        CHECK(sub[0] == 4);
+        CHECK(sub.bit_offset() == 51);
+        CHECK(sub.words().size() == 2);
+        CHECK(view.first(2)[1] == 2);
+        CHECK(view.last(1)[0] == 8);
+        CHECK(view.drop_first(5)[0] == 6);
+        CHECK(view.drop_last(5).size() == 3);
+    }
+}
+
+TEST_CASE("unpack and pack convert to plain integers")
+{
+    for (unsigned const bits : {1u, 7u, 17u, 20u, 23u, 31u, 32u}) {
+        auto const values = random_values(1001, bits);
+        std::vector<std::uint64_t> words(ext::packed_word_count(1001, bits));
+        auto const view = ext::make_packed_array_view(
+            ext::make_array_view(words), 1001, bits);
+
+        ext::pack(view, ext::make_array_view(values));
+        for (std::size_t i = 0; i < values.size(); i += 97) {
+            CHECK(view[i] == values[i]);
+        }
+
+        for (auto const level : all_isas) {
+            std::vector<std::uint32_t> out(values.size());
+            ext::unpack(ext::make_array_view(out), view.as_const(), level);
+            CHECK(out == values);
+
+            // Unaligned subview.
+            std::vector<std::uint32_t> part(500);
+            ext::unpack(ext::make_array_view(part), view.subview(13, 500),
+                level);
+            CHECK(std::vector<std::uint32_t>(values.begin() + 13,
+                      values.begin() + 513)
+                == part);
+        }
+    }
+
+    SECTION("pack into a subview keeps neighbors")
+    {
+        std::vector<std::uint64_t> words(ext::packed_word_count(200, 19));
+        ext::packed_array_view<19> const view{
+            ext::make_array_view(words), 200};
+        for (std::size_t i = 0; i < view.size(); i++) {
+            view[i] = 0x7ffff;
+        }
+
+        std::vector<std::uint32_t> const zeros(150);
+        ext::pack(view.subview(5, 150), ext::make_array_view(zeros));
+        for (std::size_t i = 0; i < view.size(); i++) {
+            CHECK(view[i] == (i >= 5 && i < 155 ? 0u : 0x7ffffu));
+        }
+    }
+
+    SECTION("values are truncated")
+    {
+        std::vector<std::uint64_t> words(1);
+        ext::packed_array_view<4> const view{ext::make_array_view(words), 3};
+        std::vector<std::uint32_t> const values = {0x12, 0x34, 0x56};
+        ext::pack(view, ext::make_array_view(values));
+        CHECK(words[0] == 0x642);
+    }
+
+    SECTION("size mismatch")
+    {
+        std::vector<std::uint64_t> words(1);
+        ext::packed_array_view<4> const view{ext::make_array_view(words), 3};
+        std::vector<std::uint32_t> out(2);
+        CHECK_THROWS_AS(ext::unpack(ext::make_array_view(out), view),
+            std::invalid_argument);
+        CHECK_THROWS_AS(ext::pack(view, ext::make_array_view(out).as_const()),
+            std::invalid_argument);
+    }
+}
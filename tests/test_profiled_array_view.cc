@@ -0,0 +1,152 @@
+// Profiling must be enabled consistently across translation units, and this
+// is the only one including the header.
+#define ARRAY_VIEW_PROFILE
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <profiled_array_view.hpp>
+#include <catch.hpp>
+
+namespace
+{
+    // Returns the profile recorded at given line of this file.
+    ext::access_profile profile_at(int line)
+    {
+        for (auto const& profile : ext::access_profiles()) {
+            if (profile.line == line
+                && std::string{profile.file}.find("test_profiled")
+                    != std::string::npos) {
+                return profile;
+            }
+        }
+        FAIL("no profile at line " << line);
+        return {};
+    }
+
+    int sum(ext::array_view<int const> view)
+    {
+        return std::accumulate(view.begin(), view.end(), 0);
+    }
+}
+
+TEST_CASE("profiled_array_view records sequential iteration")
+{
+    std::vector<int> vector(100, 1);
+
+    int const line = __LINE__ + 1;
+    auto const view = ARRAY_VIEW_PROFILED(ext::make_array_view(vector));
+
+    int total = 0;
+    for (auto const x : view) {
+        total += x;
+    }
+    CHECK(total == 100);
+
+    auto const profile = profile_at(line);
+    CHECK(profile.accesses == 100);
+    CHECK(profile.strides[1] == 99);
+    CHECK(profile.backward == 0);
+    CHECK(profile.element_size == sizeof(int));
+    CHECK(profile.touched_bytes() == 100 * sizeof(int));
+    CHECK(profile.max_view_bytes == 100 * sizeof(int));
+}
+
+TEST_CASE("profiled_array_view can be shared by reading threads")
+{
+    std::vector<int> vector(1000, 1);
+
+    int const line = __LINE__ + 1;
+    auto const view = ARRAY_VIEW_PROFILED(ext::make_array_view(vector));
+
+    std::vector<std::thread> threads;
+    std::vector<int> totals(4);
+    for (std::size_t t = 0; t < totals.size(); t++) {
+        threads.emplace_back([&, t] {
+            for (std::size_t i = 0; i < view.size(); i++) {
+                totals[t] += view[i];
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto const profile = profile_at(line);
+    CHECK(profile.accesses == 4000);
+    std::uint64_t transitions = 0;
+    for (auto const count : profile.strides) {
+        transitions += count;
+    }
+    CHECK(transitions == 3999);
+    CHECK(totals[3] == 1000);
+}
+
+TEST_CASE("profiled_array_view records strides and reversal")
+{
+    std::vector<double> vector(64);
+
+    int const line = __LINE__ + 1;
+    auto const view = ARRAY_VIEW_PROFILED(ext::make_array_view(vector));
+
+    for (std::size_t i = 0; i < 64; i += 8) {
+        view[i] = 1;
+    }
+    view[0] = 2;
+    view[0] = 3;
+    view.at(1);
+
+    auto const profile = profile_at(line);
+    CHECK(profile.accesses == 11);
+    CHECK(profile.strides[0] == 1);
+    CHECK(profile.strides[1] == 1);
+    CHECK(profile.strides[4] == 7);
+    CHECK(profile.strides[6] == 1);
+    CHECK(profile.backward == 1);
+    CHECK(profile.touched_bytes() == 57 * sizeof(double));
+}
+
+TEST_CASE("profiled_array_view keeps the array_view interface")
+{
+    std::vector<int> vector = {1, 2, 3, 4, 5};
+
+    int const line = __LINE__ + 1;
+    auto const view = ARRAY_VIEW_PROFILED(ext::make_array_view(vector));
+
+    CHECK(view.size() == 5);
+    CHECK_FALSE(view.empty());
+    CHECK(view.front() == 1);
+    CHECK(view.back() == 5);
+    CHECK(view.subview(1, 3).size() == 3);
+    CHECK(view.first(2)[1] == 2);
+    CHECK(view.last(2)[0] == 4);
+    CHECK(view.drop_first(4).front() == 5);
+    CHECK(view.drop_last(4).back() == 1);
+    CHECK(*view.rbegin() == 5);
+
+    ext::profiled_array_view<int const> const const_view = view;
+    CHECK(const_view[2] == 3);
+
+    // Conversion to array_view escapes profiling.
+    auto const before = profile_at(line).accesses;
+    CHECK(sum(view) == 15);
+    CHECK(profile_at(line).accesses == before);
+    CHECK(before == 8);
+}
+
+TEST_CASE("write_access_report lists call sites")
+{
+    std::vector<int> vector(3);
+    auto const view = ARRAY_VIEW_PROFILED(ext::make_array_view(vector));
+    view[2] = 1;
+
+    std::ostringstream report;
+    ext::write_access_report(report);
+    CHECK(report.str().find("test_profiled_array_view.cc") != std::string::npos);
+    CHECK(report.str().find("accesses=1 ") != std::string::npos);
+}
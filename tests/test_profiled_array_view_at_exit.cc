@@ -0,0 +1,22 @@
+// Built into a separate executable, since the report is written when the
+// program exits and the registry must not have been used before.
+#define ARRAY_VIEW_PROFILE
+
+#include <vector>
+
+#include <profiled_array_view.hpp>
+#include <catch.hpp>
+
+TEST_CASE("write_access_report_at_exit - registered before any access")
+{
+    // The report must outlive the registry created by the first access
+    // below. CTest checks that it appears in the output.
+    ext::write_access_report_at_exit();
+
+    std::vector<int> vector(3);
+    auto const view = ARRAY_VIEW_PROFILED(ext::make_array_view(vector));
+    view[0] = 1;
+    view[1] = 2;
+    view[2] = 3;
+    CHECK(ext::access_profiles().size() == 1);
+}
@@ -0,0 +1,31 @@
+// Built into a separate executable without ARRAY_VIEW_PROFILE, since the
+// macro must be defined consistently across translation units.
+
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+#include <profiled_array_view.hpp>
+#include <catch.hpp>
+
+TEST_CASE("profiled_array_view - compiled out when disabled")
+{
+    CHECK(std::is_same<ext::profiled_array_view<int>,
+        ext::array_view<int>>::value);
+    CHECK(std::is_same<ext::profiled_array_view<int const>,
+        ext::array_view<int const>>::value);
+
+    std::vector<int> values = {1, 2, 3};
+    auto const view = ext::make_array_view(values);
+    auto const profiled = ARRAY_VIEW_PROFILED(view);
+    CHECK(std::is_same<decltype(profiled),
+        ext::array_view<int> const>::value);
+    CHECK(profiled.data() == view.data());
+    CHECK(profiled.size() == view.size());
+    CHECK(profiled[2] == 3);
+
+    CHECK(ext::access_profiles().empty());
+    std::ostringstream report;
+    ext::write_access_report(report);
+    CHECK(report.str().empty());
+}
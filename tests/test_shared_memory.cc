@@ -0,0 +1,219 @@
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <shared_memory.hpp>
+#include <catch.hpp>
+
+namespace
+{
+    // Segment name removed on scope exit.
+    class temporary_name
+    {
+      public:
+        temporary_name()
+            : name_{"/array_view_test_" + std::to_string(::getpid())}
+        {
+            ext::shared_memory::remove(name_);
+        }
+
+        ~temporary_name()
+        {
+            ext::shared_memory::remove(name_);
+        }
+
+        std::string const& get() const
+        {
+            return name_;
+        }
+
+      private:
+        std::string name_;
+    };
+
+    bool is_aligned(void const* ptr, std::size_t align)
+    {
+        return reinterpret_cast<std::uintptr_t>(ptr) % align == 0;
+    }
+}
+
+TEST_CASE("shared_memory - handles are trivially copyable")
+{
+    CHECK(std::is_trivially_copyable<ext::shared_handle<double>>::value);
+    CHECK(sizeof(ext::shared_handle<double>) == 16);
+}
+
+TEST_CASE("shared_memory - create and attach")
+{
+    temporary_name const name;
+
+    auto segment = ext::shared_memory::create(name.get(), 4096);
+    CHECK(segment.mode() == ext::map_mode::read_write);
+    std::size_t const header_size = ext::shared_memory::header_size;
+    CHECK(segment.size() == header_size + 4096);
+    CHECK(segment.used() == header_size);
+
+    auto const handle = segment.allocate<std::uint32_t>(100);
+    CHECK(handle.size == 100);
+    auto const table = segment.writable_view(handle);
+    CHECK(table.size() == 100);
+    CHECK(table[99] == 0);
+    for (std::uint32_t i = 0; i < 100; i++) {
+        table[i] = i * i;
+    }
+    CHECK(segment.used() == handle.offset + 400);
+
+    SECTION("second mapping")
+    {
+        auto const attached = ext::shared_memory::open(name.get());
+        CHECK(attached.mode() == ext::map_mode::read_only);
+        CHECK(attached.size() == segment.size());
+        CHECK(attached.used() == segment.used());
+
+        auto const view = attached.view(handle);
+        CHECK(view.data() != table.data());
+        CHECK(view.size() == 100);
+        CHECK(view[7] == 49);
+
+        table[7] = 1;
+        CHECK(view[7] == 1);
+    }
+
+    SECTION("handle of a view")
+    {
+        auto const found = segment.handle_of(table.subview(10, 5));
+        CHECK(found.offset == handle.offset + 40);
+        CHECK(found.size == 5);
+        CHECK(segment.view(found)[0] == 100);
+
+        std::uint32_t outside[1] = {};
+        CHECK_THROWS_AS(segment.handle_of(ext::make_array_view(outside)),
+            std::out_of_range);
+    }
+
+    SECTION("handle of an empty view")
+    {
+        auto const empty = segment.handle_of(
+            segment.view(ext::shared_handle<std::uint32_t>{}));
+        CHECK(empty.offset == 0);
+        CHECK(empty.size == 0);
+        CHECK(segment.view(empty).empty());
+        CHECK(segment.handle_of(table.subview(3, 0)).size == 0);
+        CHECK(segment.handle_of(ext::array_view<int>{}).offset == 0);
+    }
+
+    SECTION("alignment")
+    {
+        auto const bytes = segment.allocate<char>(3);
+        auto const lines = segment.allocate<double>(4, 64);
+        CHECK(bytes.offset == handle.offset + 400);
+        CHECK(lines.offset % 64 == 0);
+        CHECK(is_aligned(segment.view(lines).data(), 64));
+
+        CHECK_THROWS_AS(segment.allocate<double>(1, 4),
+            std::invalid_argument);
+        CHECK_THROWS_AS(segment.allocate<double>(1, 24),
+            std::invalid_argument);
+    }
+
+    SECTION("exhaustion")
+    {
+        CHECK_THROWS_AS(segment.allocate<char>(4096), std::bad_alloc);
+        CHECK_THROWS_AS(segment.allocate<char>(std::size_t(-1)),
+            std::bad_alloc);
+        auto const rest = segment.allocate<char>(4096 - 400);
+        CHECK(rest.size == 4096 - 400);
+        CHECK_THROWS_AS(segment.allocate<char>(1), std::bad_alloc);
+    }
+
+    SECTION("invalid handles")
+    {
+        auto bad = handle;
+        bad.size = 2000;
+        CHECK_THROWS_AS(segment.view(bad), std::out_of_range);
+        bad.offset = 0;
+        bad.size = 1;
+        CHECK_THROWS_AS(segment.view(bad), std::out_of_range);
+        bad.offset = handle.offset + 2;
+        CHECK_THROWS_AS(segment.view(bad), std::invalid_argument);
+        bad.size = 0;
+        CHECK(segment.view(bad).empty());
+        CHECK(segment.view(ext::shared_handle<int>{}).empty());
+    }
+
+    SECTION("read-only mapping")
+    {
+        auto attached = ext::shared_memory::open(name.get());
+        CHECK_THROWS_AS(attached.allocate<int>(1), std::invalid_argument);
+        CHECK_THROWS_AS(attached.writable_view(handle),
+            std::invalid_argument);
+    }
+
+    SECTION("move")
+    {
+        auto const data = segment.bytes().data();
+        ext::shared_memory moved{std::move(segment)};
+        CHECK(segment.empty());
+        CHECK(moved.bytes().data() == data);
+        CHECK(moved.view(handle)[3] == 9);
+    }
+}
+
+TEST_CASE("shared_memory - another process")
+{
+    temporary_name const name;
+
+    auto segment = ext::shared_memory::create(name.get(), 4096);
+    auto const input = segment.allocate<std::uint64_t>(64);
+    auto const output = segment.allocate<std::uint64_t>(1);
+    auto const values = segment.writable_view(input);
+    for (std::size_t i = 0; i < values.size(); i++) {
+        values[i] = i;
+    }
+
+    // The child attaches by name and writes the sum through the handles.
+    auto const pid = ::fork();
+    REQUIRE(pid != -1);
+    if (pid == 0) {
+        try {
+            auto child = ext::shared_memory::open(
+                name.get(), ext::map_mode::read_write);
+            std::uint64_t sum = 0;
+            for (auto const value : child.view(input)) {
+                sum += value;
+            }
+            child.writable_view(output)[0] = sum;
+        } catch (...) {
+            ::_exit(1);
+        }
+        ::_exit(0);
+    }
+
+    int status = 0;
+    REQUIRE(::waitpid(pid, &status, 0) == pid);
+    CHECK(WIFEXITED(status));
+    CHECK(WEXITSTATUS(status) == 0);
+    CHECK(segment.view(output)[0] == 64 * 63 / 2);
+}
+
+TEST_CASE("shared_memory - errors")
+{
+    temporary_name const name;
+
+    CHECK_THROWS_AS(ext::shared_memory::open(name.get()), std::system_error);
+    CHECK_FALSE(ext::shared_memory::remove(name.get()));
+
+    auto const segment = ext::shared_memory::create(name.get(), 16);
+    CHECK_THROWS_AS(ext::shared_memory::create(name.get(), 16),
+        std::system_error);
+    CHECK(ext::shared_memory::remove(name.get()));
+    CHECK_FALSE(segment.empty());
+}
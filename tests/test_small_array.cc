@@ -0,0 +1,300 @@
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <small_array.hpp>
+#include <catch.hpp>
+
+namespace
+{
+    // Element counting live instances, copies and moves.
+    struct tracked
+    {
+        static int live;
+        static int copies;
+        static int moves;
+
+        int value = 0;
+
+        tracked(int v = 0)
+            : value{v}
+        {
+            live++;
+        }
+
+        tracked(tracked const& other)
+            : value{other.value}
+        {
+            live++;
+            copies++;
+        }
+
+        tracked(tracked&& other) noexcept
+            : value{other.value}
+        {
+            live++;
+            moves++;
+        }
+
+        tracked& operator=(tracked const&) = default;
+
+        ~tracked()
+        {
+            live--;
+        }
+
+        static void reset()
+        {
+            live = copies = moves = 0;
+        }
+    };
+
+    int tracked::live = 0;
+    int tracked::copies = 0;
+    int tracked::moves = 0;
+
+    // Element without a move constructor whose copies fail on demand.
+    struct fragile
+    {
+        static int live;
+        static int copies_left;
+
+        int value;
+
+        fragile(int v)
+            : value{v}
+        {
+            live++;
+        }
+
+        fragile(fragile const& other)
+            : value{other.value}
+        {
+            if (copies_left == 0) {
+                throw std::runtime_error("copy failed");
+            }
+            copies_left--;
+            live++;
+        }
+
+        ~fragile()
+        {
+            live--;
+        }
+    };
+
+    int fragile::live = 0;
+    int fragile::copies_left = 0;
+}
+
+TEST_CASE("small_array - inline storage")
+{
+    ext::small_array<int, 4> array;
+    CHECK(array.empty());
+    CHECK(array.capacity() == 4);
+    CHECK(array.is_inline());
+
+    for (int i = 0; i < 4; i++) {
+        array.push_back(i * 10);
+    }
+    CHECK(array.size() == 4);
+    CHECK(array.is_inline());
+    CHECK(array[2] == 20);
+    CHECK(array.front() == 0);
+    CHECK(array.back() == 30);
+    CHECK(array.at(3) == 30);
+    CHECK_THROWS_AS(array.at(4), std::out_of_range);
+
+    SECTION("spill to heap")
+    {
+        auto const inline_data = array.data();
+        array.push_back(40);
+        CHECK_FALSE(array.is_inline());
+        CHECK(array.data() != inline_data);
+        CHECK(array.capacity() >= 5);
+        CHECK(array.size() == 5);
+        CHECK(array[4] == 40);
+        CHECK(array[0] == 0);
+    }
+
+    SECTION("self-referencing push_back at capacity")
+    {
+        array.push_back(array[1]);
+        CHECK(array.back() == 10);
+    }
+
+    SECTION("pop_back and clear")
+    {
+        array.pop_back();
+        CHECK(array.size() == 3);
+        array.clear();
+        CHECK(array.empty());
+        CHECK(array.is_inline());
+    }
+}
+
+TEST_CASE("small_array - construction")
+{
+    ext::small_array<int, 3> const values = {1, 2, 3, 4};
+    CHECK(values.size() == 4);
+    CHECK_FALSE(values.is_inline());
+    CHECK(values[3] == 4);
+
+    ext::small_array<int, 3> const zeros(2);
+    CHECK(zeros.size() == 2);
+    CHECK(zeros[1] == 0);
+
+    ext::small_array<std::string, 3> const words(3, "abc");
+    CHECK(words.size() == 3);
+    CHECK(words[2] == "abc");
+
+    int const raw[] = {5, 6};
+    ext::small_array<int, 3> const from_view{ext::make_array_view(raw)
+        .as_const()};
+    CHECK(from_view.size() == 2);
+    CHECK(from_view[1] == 6);
+}
+
+TEST_CASE("small_array - views")
+{
+    ext::small_array<double, 8> array = {1.5, 2.5, 3.5};
+
+    ext::array_view<double> const view = array.view();
+    CHECK(view.data() == array.data());
+    CHECK(view.size() == 3);
+    view[0] = 9;
+    CHECK(array[0] == 9);
+
+    auto const& const_array = array;
+    ext::array_view<double const> const const_view = const_array.view();
+    CHECK(const_view.size() == 3);
+
+    auto const made = ext::make_array_view(array);
+    CHECK(made.data() == array.data());
+    CHECK(made.size() == 3);
+
+    double sum = 0;
+    for (auto const value : array) {
+        sum += value;
+    }
+    CHECK(sum == 15);
+    CHECK(*array.rbegin() == 3.5);
+}
+
+TEST_CASE("small_array - resize and reserve")
+{
+    ext::small_array<int, 4> array;
+    array.resize(3, 7);
+    CHECK(array.size() == 3);
+    CHECK(array[2] == 7);
+    CHECK(array.is_inline());
+
+    array.resize(6);
+    CHECK(array.size() == 6);
+    CHECK(array[2] == 7);
+    CHECK(array[5] == 0);
+    CHECK_FALSE(array.is_inline());
+
+    array.resize(1);
+    CHECK(array.size() == 1);
+    CHECK(array[0] == 7);
+
+    array.reserve(100);
+    CHECK(array.capacity() >= 100);
+    CHECK(array[0] == 7);
+}
+
+TEST_CASE("small_array - copy and move")
+{
+    tracked::reset();
+    {
+        ext::small_array<tracked, 4> inline_array = {1, 2};
+        ext::small_array<tracked, 4> heap_array = {1, 2, 3, 4, 5};
+        tracked::copies = tracked::moves = 0;
+
+        SECTION("copy")
+        {
+            auto const copy = heap_array;
+            CHECK(copy.size() == 5);
+            CHECK(copy[4].value == 5);
+            CHECK(tracked::copies == 5);
+
+            ext::small_array<tracked, 4> assigned;
+            assigned = inline_array;
+            CHECK(assigned.size() == 2);
+            CHECK(assigned.is_inline());
+        }
+
+        SECTION("move from inline storage moves live elements only")
+        {
+            auto const moved = std::move(inline_array);
+            CHECK(moved.size() == 2);
+            CHECK(moved[1].value == 2);
+            CHECK(tracked::moves == 2);
+            CHECK(tracked::copies == 0);
+            CHECK(inline_array.empty());
+        }
+
+        SECTION("move from heap storage steals the buffer")
+        {
+            auto const data = heap_array.data();
+            auto const moved = std::move(heap_array);
+            CHECK(moved.data() == data);
+            CHECK(moved.size() == 5);
+            CHECK(tracked::moves == 0);
+            CHECK(heap_array.empty());
+            CHECK(heap_array.is_inline());
+        }
+
+        SECTION("move assignment")
+        {
+            inline_array = std::move(heap_array);
+            CHECK(inline_array.size() == 5);
+            CHECK(tracked::moves == 0);
+
+            heap_array.push_back(9);
+            inline_array = std::move(heap_array);
+            CHECK(inline_array.size() == 1);
+            CHECK(inline_array.is_inline());
+        }
+
+        SECTION("growth moves elements")
+        {
+            inline_array.reserve(10);
+            CHECK(tracked::moves == 2);
+            CHECK(tracked::copies == 0);
+        }
+    }
+    CHECK(tracked::live == 0);
+}
+
+TEST_CASE("small_array - non-copyable elements")
+{
+    ext::small_array<std::unique_ptr<int>, 2> array;
+    for (int i = 0; i < 5; i++) {
+        array.emplace_back(new int{i});
+    }
+    CHECK(*array[4] == 4);
+
+    auto const moved = std::move(array);
+    CHECK(*moved[0] == 0);
+}
+
+TEST_CASE("small_array - failed growth keeps the elements")
+{
+    {
+        ext::small_array<fragile, 2> array;
+        array.emplace_back(1);
+        array.emplace_back(2);
+
+        fragile::copies_left = 1;
+        CHECK_THROWS_AS(array.emplace_back(3), std::runtime_error);
+        CHECK(fragile::live == 2);
+        CHECK(array.size() == 2);
+        CHECK(array.is_inline());
+        CHECK(array[1].value == 2);
+    }
+    CHECK(fragile::live == 0);
+}
@@ -0,0 +1,147 @@
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <spsc_ring_buffer.hpp>
+#include <catch.hpp>
+
+TEST_CASE("spsc_ring_buffer - capacity")
+{
+    CHECK(ext::spsc_ring_buffer<int>{1}.capacity() == 1);
+    CHECK(ext::spsc_ring_buffer<int>{5}.capacity() == 8);
+    CHECK(ext::spsc_ring_buffer<int>{16}.capacity() == 16);
+    CHECK_THROWS_AS(ext::spsc_ring_buffer<int>{0}, std::invalid_argument);
+
+    auto const too_large = static_cast<std::size_t>(-1) / 2 + 2;
+    CHECK_THROWS_AS(
+        ext::spsc_ring_buffer<int>{too_large}, std::invalid_argument);
+}
+
+TEST_CASE("spsc_ring_buffer - read moves elements")
+{
+    ext::spsc_ring_buffer<std::unique_ptr<int>> ring{4};
+    auto space = ring.write_regions();
+    space.first[0].reset(new int{1});
+    space.first[1].reset(new int{2});
+    ring.commit_write(2);
+
+    std::unique_ptr<int> output[2];
+    CHECK(ring.read(ext::make_array_view(output)) == 2);
+    CHECK(*output[0] == 1);
+    CHECK(*output[1] == 2);
+    CHECK(space.first[0] == nullptr);
+}
+
+TEST_CASE("spsc_ring_buffer - regions")
+{
+    ext::spsc_ring_buffer<int> ring{8};
+    CHECK(ring.empty());
+    CHECK(ring.read_regions().empty());
+
+    auto space = ring.write_regions();
+    CHECK(space.first.size() == 8);
+    CHECK(space.second.empty());
+
+    std::iota(space.first.begin(), space.first.begin() + 6, 0);
+    ring.commit_write(6);
+    CHECK(ring.size() == 6);
+
+    auto data = ring.read_regions();
+    CHECK(data.size() == 6);
+    CHECK(data.first.front() == 0);
+    CHECK(data.first.back() == 5);
+    ring.commit_read(4);
+    CHECK(ring.size() == 2);
+
+    SECTION("free space wraps around")
+    {
+        space = ring.write_regions();
+        CHECK(space.first.size() == 2);
+        CHECK(space.second.size() == 4);
+        CHECK(space.second.data() + 6 == space.first.data());
+
+        space.first[0] = 6;
+        space.first[1] = 7;
+        space.second[0] = 8;
+        ring.commit_write(3);
+
+        data = ring.read_regions();
+        CHECK(data.first.size() == 4);
+        CHECK(data.second.size() == 1);
+        CHECK(data.first.front() == 4);
+        CHECK(data.second.front() == 8);
+        ring.commit_read(data.size());
+        CHECK(ring.empty());
+    }
+
+    SECTION("full buffer has no free space")
+    {
+        ring.commit_write(ring.write_regions().size());
+        CHECK(ring.size() == 8);
+        CHECK(ring.write_regions().empty());
+        CHECK_FALSE(ring.try_push(1));
+    }
+}
+
+TEST_CASE("spsc_ring_buffer - bulk copy")
+{
+    ext::spsc_ring_buffer<int> ring{4};
+    std::vector<int> input = {1, 2, 3, 4, 5, 6};
+    std::vector<int> output(6);
+
+    CHECK(ring.write(ext::make_array_view(input)) == 4);
+    CHECK(ring.read(ext::make_array_view(output).first(3)) == 3);
+    CHECK(ring.write(ext::make_array_view(input).drop_first(4)) == 2);
+    CHECK(ring.read(ext::make_array_view(output).drop_first(3)) == 3);
+    CHECK(output == input);
+
+    int value = 0;
+    CHECK(ring.try_push(42));
+    CHECK(ring.try_pop(value));
+    CHECK(value == 42);
+    CHECK_FALSE(ring.try_pop(value));
+}
+
+TEST_CASE("spsc_ring_buffer - transfers between threads in order")
+{
+    ext::spsc_ring_buffer<std::size_t> ring{64};
+    std::size_t const total = 100000;
+
+    std::thread producer{[&] {
+        std::size_t next = 0;
+        while (next < total) {
+            auto const space = ring.write_regions();
+            std::size_t count = 0;
+            for (auto& slot : space.first) {
+                if (next + count == total) {
+                    break;
+                }
+                slot = next + count;
+                count++;
+            }
+            ring.commit_write(count);
+            next += count;
+        }
+    }};
+
+    std::size_t expected = 0;
+    bool in_order = true;
+    while (expected < total) {
+        auto const data = ring.read_regions();
+        for (auto const value : data.first) {
+            in_order = in_order && value == expected++;
+        }
+        for (auto const value : data.second) {
+            in_order = in_order && value == expected++;
+        }
+        ring.commit_read(data.size());
+    }
+    producer.join();
+
+    CHECK(in_order);
+    CHECK(expected == total);
+    CHECK(ring.empty());
+}
@@ -0,0 +1,150 @@
+#include <array>
+#include <type_traits>
+#include <vector>
+
+#include <array_view.hpp>
+#include <catch.hpp>
+
+TEST_CASE("fixed-size array_view stores only a pointer")
+{
+    CHECK(sizeof(ext::array_view<double, 3>) == sizeof(double*));
+    CHECK(sizeof(ext::array_view<double>) > sizeof(double*));
+}
+
+TEST_CASE("fixed-size array_view has compile-time size")
+{
+    int array[] = {0, 1, 2, 3};
+    ext::array_view<int, 4> const view = array;
+
+    constexpr std::size_t size = decltype(view)::size();
+    static_assert(size == 4, "size must be a constant expression");
+    static_assert(decltype(view)::extent == 4, "extent must be 4");
+    static_assert(ext::array_view<int>::extent == ext::dynamic_extent,
+        "dynamic view must have dynamic extent");
+
+    CHECK(view.size() == 4);
+    CHECK_FALSE(view.empty());
+    CHECK(view.data() == array);
+    CHECK(view.front() == 0);
+    CHECK(view.back() == 3);
+    CHECK(view[2] == 2);
+    CHECK_THROWS_AS(view.at(4), std::out_of_range);
+    CHECK(view.end() - view.begin() == 4);
+    CHECK(*view.rbegin() == 3);
+}
+
+TEST_CASE("zero-sized array_view is default constructible")
+{
+    ext::array_view<int, 0> const view;
+    CHECK(view.empty());
+    CHECK(view.data() == nullptr);
+    CHECK(std::is_default_constructible<ext::array_view<int, 0>>::value);
+    CHECK_FALSE(std::is_default_constructible<ext::array_view<int, 1>>::value);
+}
+
+TEST_CASE("fixed-size array_view can be created from pointer")
+{
+    std::vector<int> vector = {0, 1, 2, 3};
+    auto const view = ext::make_array_view<3>(vector.data() + 1);
+
+    CHECK(std::is_same<decltype(view), ext::array_view<int, 3> const>::value);
+    CHECK(view[0] == 1);
+    CHECK(view.back() == 3);
+    CHECK(noexcept(ext::make_array_view<3>(vector.data())));
+}
+
+TEST_CASE("fixed-size array_view converts to dynamic view")
+{
+    int array[] = {0, 1, 2, 3};
+    ext::array_view<int, 4> const view = array;
+
+    ext::array_view<int> const dynamic = view;
+    ext::array_view<int const> const const_dynamic = view;
+    ext::array_view<int const, 4> const const_view = view;
+
+    CHECK(dynamic == ext::make_array_view(array));
+    CHECK(const_dynamic == ext::make_array_view(array));
+    CHECK(const_view == view);
+    CHECK(view.as_dynamic() == dynamic);
+    CHECK(view.as_const() == const_view);
+    CHECK_FALSE((std::is_convertible<ext::array_view<int, 4>,
+        ext::array_view<int, 3>>::value));
+    CHECK_FALSE((std::is_convertible<ext::array_view<int const, 4>,
+        ext::array_view<int>>::value));
+}
+
+TEST_CASE("fixed-size array_view supports compile-time slicing")
+{
+    int array[] = {0, 1, 2, 3, 4, 5};
+    ext::array_view<int, 6> const view = array;
+
+    auto const sub = view.subview<1, 3>();
+    auto const first = view.first<2>();
+    auto const last = view.last<2>();
+    auto const tail = view.drop_first<2>();
+    auto const init = view.drop_last<2>();
+
+    CHECK(std::is_same<decltype(sub), ext::array_view<int, 3> const>::value);
+    CHECK(std::is_same<decltype(tail), ext::array_view<int, 4> const>::value);
+    CHECK(sub.data() == array + 1);
+    CHECK(first.data() == array);
+    CHECK(last.data() == array + 4);
+    CHECK(tail.data() == array + 2);
+    CHECK(init.data() == array);
+    CHECK(init.size() == 4);
+}
+
+TEST_CASE("fixed-size array_view supports run-time slicing")
+{
+    int array[] = {0, 1, 2, 3, 4, 5};
+    ext::array_view<int, 6> const view = array;
+    ext::array_view<int> const dynamic = view;
+
+    CHECK(view.subview(1, 3) == dynamic.subview(1, 3));
+    CHECK(view.first(2) == dynamic.first(2));
+    CHECK(view.last(2) == dynamic.last(2));
+    CHECK(view.drop_first(2) == dynamic.drop_first(2));
+    CHECK(view.drop_last(2) == dynamic.drop_last(2));
+}
+
+TEST_CASE("dynamic array_view can be sliced into fixed-size views")
+{
+    std::vector<int> vector = {0, 1, 2, 3, 4, 5};
+    auto const view = ext::make_array_view(vector);
+
+    auto const first = view.first<3>();
+    auto const last = view.last<2>();
+    auto const sub = view.subview<2, 2>();
+
+    CHECK(std::is_same<decltype(first), ext::array_view<int, 3> const>::value);
+    CHECK(first.data() == vector.data());
+    CHECK(last.data() == vector.data() + 4);
+    CHECK(sub.data() == vector.data() + 2);
+    CHECK(sub.size() == 2);
+}
+
+TEST_CASE("fixed-size array_view supports constexpr")
+{
+    static constexpr int array[] = {1, 2, 3};
+    constexpr ext::array_view<int const, 3> view = array;
+    constexpr int front = view.front();
+    constexpr int back = view.last<1>()[0];
+    constexpr ext::array_view<int const> dynamic = view;
+
+    CHECK(front == 1);
+    CHECK(back == 3);
+    CHECK(dynamic.size() == 3);
+}
+
+TEST_CASE("two fixed-size array_views can be swapped")
+{
+    int array1[] = {0, 1};
+    int array2[] = {2, 3};
+    ext::array_view<int, 2> view1 = array1;
+    ext::array_view<int, 2> view2 = array2;
+
+    view1.swap(view2);
+    CHECK(view1.data() == array2);
+    CHECK(view2.data() == array1);
+    CHECK(view1 != view2);
+}
@@ -0,0 +1,187 @@
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <stream_reader.hpp>
+#include <catch.hpp>
+
+namespace
+{
+    struct record
+    {
+        std::uint32_t key;
+        std::uint32_t value;
+        std::uint32_t check;
+    };
+
+    // Temporary file removed on scope exit.
+    class temporary_file
+    {
+      public:
+        explicit temporary_file(std::vector<unsigned char> const& content)
+        {
+            char path[] = "/tmp/array_view_test_XXXXXX";
+            int const fd = ::mkstemp(path);
+            REQUIRE(fd != -1);
+            REQUIRE(::write(fd, content.data(), content.size())
+                == static_cast<ssize_t>(content.size()));
+            ::close(fd);
+            path_ = path;
+        }
+
+        ~temporary_file()
+        {
+            std::remove(path_.c_str());
+        }
+
+        std::string const& path() const
+        {
+            return path_;
+        }
+
+      private:
+        std::string path_;
+    };
+
+    std::vector<unsigned char> make_records(std::uint32_t count)
+    {
+        std::vector<record> records;
+        for (std::uint32_t i = 0; i < count; i++) {
+            records.push_back({i, i * 7, ~i});
+        }
+        auto const bytes = reinterpret_cast<unsigned char const*>(
+            records.data());
+        return {bytes, bytes + records.size() * sizeof(record)};
+    }
+
+    // Reads all records and checks that they are in order.
+    std::uint32_t read_all(ext::stream_reader<record>& reader)
+    {
+        std::uint32_t expected = 0;
+        for (;;) {
+            auto const batch = reader.next();
+            if (batch.empty()) {
+                break;
+            }
+            CHECK(reinterpret_cast<std::uintptr_t>(batch.data())
+                    % alignof(record)
+                == 0);
+            for (auto const& r : batch) {
+                if (r.key != expected || r.value != expected * 7
+                    || r.check != ~expected) {
+                    FAIL("record " << expected << " is corrupt");
+                }
+                expected++;
+            }
+        }
+        CHECK(reader.next().empty());
+        return expected;
+    }
+}
+
+TEST_CASE("stream_reader - records straddling chunks")
+{
+    temporary_file const tmp{make_records(1000)};
+
+    ext::stream_options options;
+    options.chunk_bytes = 64;
+    options.alignment = 16;
+
+    SECTION("two buffers")
+    {
+        ext::stream_reader<record> reader{tmp.path(), options};
+        CHECK(reader.file_size() == 12000);
+        CHECK(read_all(reader) == 1000);
+
+        auto const stats = reader.stats();
+        CHECK(stats.bytes_read == 12000);
+        CHECK(stats.batches == (12000 + 63) / 64);
+        CHECK(stats.read_seconds >= 0);
+        CHECK(stats.stall_seconds >= 0);
+        CHECK(stats.elapsed_seconds > 0);
+    }
+
+    SECTION("more buffers")
+    {
+        options.buffer_count = 5;
+        ext::stream_reader<record> reader{tmp.path(), options};
+        CHECK(read_all(reader) == 1000);
+    }
+
+    SECTION("chunk smaller than a record")
+    {
+        options.chunk_bytes = 4;
+        options.alignment = 4;
+        ext::stream_reader<record> reader{tmp.path(), options};
+        CHECK(read_all(reader) == 1000);
+    }
+
+    SECTION("single chunk")
+    {
+        options.chunk_bytes = 1 << 16;
+        ext::stream_reader<record> reader{tmp.path(), options};
+        CHECK(reader.next().size() == 1000);
+        CHECK(reader.next().empty());
+    }
+}
+
+TEST_CASE("stream_reader - stopping early")
+{
+    temporary_file const tmp{make_records(1000)};
+
+    ext::stream_options options;
+    options.chunk_bytes = 64;
+    options.alignment = 16;
+
+    ext::stream_reader<record> reader{tmp.path(), options};
+    CHECK(reader.next()[0].key == 0);
+}
+
+TEST_CASE("stream_reader - empty file")
+{
+    temporary_file const tmp{{}};
+
+    ext::stream_reader<record> reader{tmp.path()};
+    CHECK(reader.file_size() == 0);
+    CHECK(reader.next().empty());
+    CHECK(reader.stats().batches == 0);
+}
+
+TEST_CASE("stream_reader - errors")
+{
+    temporary_file const tmp{make_records(10)};
+
+    SECTION("missing file")
+    {
+        CHECK_THROWS_AS(ext::stream_reader<record>(tmp.path() + ".missing"),
+            std::system_error);
+    }
+
+    SECTION("truncated record")
+    {
+        auto content = make_records(10);
+        content.pop_back();
+        temporary_file const truncated{content};
+        CHECK_THROWS_AS(ext::stream_reader<record>(truncated.path()),
+            std::invalid_argument);
+    }
+
+    SECTION("invalid options")
+    {
+        ext::stream_options options;
+        options.buffer_count = 1;
+        CHECK_THROWS_AS(ext::stream_reader<record>(tmp.path(), options),
+            std::invalid_argument);
+
+        options.buffer_count = 2;
+        options.alignment = 24;
+        CHECK_THROWS_AS(ext::stream_reader<record>(tmp.path(), options),
+            std::invalid_argument);
+    }
+}
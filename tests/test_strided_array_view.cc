@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#include <strided_array_view.hpp>
+#include <catch.hpp>
+
+namespace
+{
+    struct particle
+    {
+        double x;
+        double y;
+        int id;
+    };
+}
+
+TEST_CASE("strided_array_view is default constructible")
+{
+    ext::strided_array_view<int> view;
+    CHECK(view.data() == nullptr);
+    CHECK(view.size() == 0);
+    CHECK(view.empty());
+}
+
+TEST_CASE("strided_array_view can be created from contiguous view")
+{
+    std::vector<int> vector = {0, 1, 2, 3};
+    ext::strided_array_view<int> const view = ext::make_array_view(vector);
+
+    CHECK(view.data() == vector.data());
+    CHECK(view.size() == vector.size());
+    CHECK(view.stride() == sizeof(int));
+    CHECK(view.is_contiguous());
+    CHECK(view.as_contiguous() == ext::make_array_view(vector));
+}
+
+TEST_CASE("strided_array_view can skip elements")
+{
+    std::vector<int> vector = {0, 1, 2, 3, 4, 5, 6};
+    auto const view =
+        ext::make_strided_array_view(ext::make_array_view(vector), 3);
+
+    SECTION("fact check")
+    {
+        CHECK(view.size() == 3);
+        CHECK(view.stride() == 3 * sizeof(int));
+        CHECK_FALSE(view.is_contiguous());
+        CHECK(view[0] == 0);
+        CHECK(view[1] == 3);
+        CHECK(view[2] == 6);
+        CHECK(view.front() == 0);
+        CHECK(view.back() == 6);
+    }
+
+    SECTION("bounds check")
+    {
+        CHECK_NOTHROW(view.at(2));
+        CHECK_THROWS_AS(view.at(3), std::out_of_range);
+    }
+
+    SECTION("write")
+    {
+        view[1] = 100;
+        CHECK(vector[3] == 100);
+    }
+}
+
+TEST_CASE("strided_array_view projects a member of structs")
+{
+    std::vector<particle> particles = {
+        {1.0, 2.0, 10}, {3.0, 4.0, 20}, {5.0, 6.0, 30}};
+
+    SECTION("mutable view")
+    {
+        ext::strided_array_view<double> const ys = ext::make_strided_array_view(
+            ext::make_array_view(particles), &particle::y);
+        CHECK(ys.size() == 3);
+        CHECK(ys.stride() == sizeof(particle));
+        CHECK(ys[0] == 2.0);
+        CHECK(ys[2] == 6.0);
+
+        ys[1] = 0.5;
+        CHECK(particles[1].y == 0.5);
+    }
+
+    SECTION("read-only view")
+    {
+        ext::array_view<particle const> const view =
+            ext::make_array_view(particles);
+        auto const ids = ext::make_strided_array_view(view, &particle::id);
+        CHECK(std::is_same<decltype(ids)::reference, int const&>::value);
+        CHECK(std::accumulate(ids.begin(), ids.end(), 0) == 60);
+    }
+
+    SECTION("empty view")
+    {
+        ext::array_view<particle> const empty;
+        auto const xs = ext::make_strided_array_view(empty, &particle::x);
+        CHECK(xs.empty());
+        CHECK(xs.begin() == xs.end());
+    }
+}
+
+TEST_CASE("strided_array_view provides random access iterators")
+{
+    std::vector<int> vector = {0, 1, 2, 3, 4, 5, 6, 7};
+    auto const view =
+        ext::make_strided_array_view(ext::make_array_view(vector), 2);
+
+    using iterator = decltype(view)::iterator;
+    CHECK(std::is_same<std::iterator_traits<iterator>::iterator_category,
+        std::random_access_iterator_tag>::value);
+
+    SECTION("traversal")
+    {
+        std::vector<int> const copy(view.begin(), view.end());
+        CHECK(copy == (std::vector<int>{0, 2, 4, 6}));
+    }
+
+    SECTION("reverse traversal")
+    {
+        std::vector<int> const copy(view.rbegin(), view.rend());
+        CHECK(copy == (std::vector<int>{6, 4, 2, 0}));
+    }
+
+    SECTION("arithmetic")
+    {
+        auto it = view.begin();
+        CHECK(view.end() - view.begin() == 4);
+        CHECK(*(it + 3) == 6);
+        CHECK(it[2] == 4);
+        it += 2;
+        CHECK(*it == 4);
+        CHECK(*--it == 2);
+        CHECK(*it++ == 2);
+        CHECK(*it == 4);
+        CHECK(view.begin() < it);
+        CHECK(it <= view.end());
+        CHECK(view.end() > it);
+        CHECK(it >= view.begin());
+    }
+
+    SECTION("algorithms")
+    {
+        view[0] = 9;
+        std::sort(view.begin(), view.end());
+        CHECK(vector == (std::vector<int>{2, 1, 4, 3, 6, 5, 9, 7}));
+    }
+}
+
+TEST_CASE("strided_array_view can be sliced")
+{
+    std::vector<int> vector = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    auto const view =
+        ext::make_strided_array_view(ext::make_array_view(vector), 2);
+
+    CHECK(view.subview(1, 3).front() == 2);
+    CHECK(view.subview(1, 3).size() == 3);
+    CHECK(view.first(2) == view.subview(0, 2));
+    CHECK(view.last(2) == view.subview(3, 2));
+    CHECK(view.drop_first(2) == view.subview(2, 3));
+    CHECK(view.drop_last(2) == view.subview(0, 3));
+
+    auto const every_fourth = view.stride_by(2);
+    CHECK(every_fourth.size() == 3);
+    CHECK(every_fourth[2] == 8);
+}
+
+TEST_CASE("strided_array_view can be transformed to const view")
+{
+    std::vector<int> vector = {0, 1, 2, 3};
+    ext::strided_array_view<int> const view = ext::make_array_view(vector);
+    ext::strided_array_view<int const> const cview = view;
+
+    CHECK(cview == view.as_const());
+    CHECK(cview.data() == view.data());
+}
+
+TEST_CASE("two strided_array_views can be swapped")
+{
+    std::vector<int> vector1 = {0, 1, 2, 3};
+    std::vector<int> vector2 = {4, 5};
+
+    ext::strided_array_view<int> view1 = ext::make_array_view(vector1);
+    ext::strided_array_view<int> view2 = ext::make_array_view(vector2);
+    view1.swap(view2);
+
+    CHECK(view1.data() == vector2.data());
+    CHECK(view2.data() == vector1.data());
+}
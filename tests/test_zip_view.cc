@@ -0,0 +1,98 @@
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <zip_view.hpp>
+#include <catch.hpp>
+
+TEST_CASE("zip_view - default construction")
+{
+    ext::zip_view<int, double> view;
+    CHECK(view.empty());
+    CHECK(view.size() == 0);
+    CHECK(view.begin() == view.end());
+    CHECK(std::get<0>(view.data()) == nullptr);
+}
+
+TEST_CASE("zip_view - construction checks sizes")
+{
+    std::vector<int> a(3);
+    std::vector<double> b(3);
+    std::vector<double> c(4);
+
+    auto const view =
+        ext::zip(ext::make_array_view(a), ext::make_array_view(b).as_const());
+    static_assert(std::is_same<decltype(view),
+                      ext::zip_view<int, double const> const>::value,
+        "element types are preserved");
+    CHECK(view.size() == 3);
+    CHECK(view.view<0>().data() == a.data());
+    CHECK(view.view<1>().data() == b.data());
+
+    CHECK_THROWS_AS(
+        ext::zip(ext::make_array_view(a), ext::make_array_view(c)),
+        std::invalid_argument);
+}
+
+TEST_CASE("zip_view - element access")
+{
+    std::vector<int> ids = {1, 2, 3, 4};
+    std::vector<double> xs = {0.5, 1.5, 2.5, 3.5};
+    std::vector<double> ys = {0, 0, 0, 0};
+
+    auto const view = ext::zip(ext::make_array_view(ids).as_const(),
+        ext::make_array_view(xs).as_const(), ext::make_array_view(ys));
+
+    SECTION("subscript yields references")
+    {
+        auto const elems = view[2];
+        CHECK(std::get<0>(elems) == 3);
+        CHECK(&std::get<1>(elems) == &xs[2]);
+        std::get<2>(elems) = 9;
+        CHECK(ys[2] == 9);
+
+        CHECK(std::get<0>(view.front()) == 1);
+        CHECK(std::get<0>(view.back()) == 4);
+        CHECK(std::get<0>(view.at(1)) == 2);
+        CHECK_THROWS_AS(view.at(4), std::out_of_range);
+    }
+
+    SECTION("iteration")
+    {
+        for (auto const elems : view) {
+            std::get<2>(elems) = std::get<0>(elems) * std::get<1>(elems);
+        }
+        CHECK(ys == (std::vector<double>{0.5, 3, 7.5, 14}));
+
+        CHECK(std::distance(view.begin(), view.end()) == 4);
+        CHECK(std::get<0>(*(view.end() - 1)) == 4);
+        CHECK(std::get<0>(view.begin()[1]) == 2);
+    }
+}
+
+TEST_CASE("zip_view - subviews slice all arrays")
+{
+    std::vector<int> a = {1, 2, 3, 4, 5};
+    std::vector<int> b = {10, 20, 30, 40, 50};
+    auto const view =
+        ext::zip(ext::make_array_view(a), ext::make_array_view(b));
+
+    auto const sub = view.subview(1, 3);
+    CHECK(sub.size() == 3);
+    CHECK(sub.view<0>() == ext::make_array_view(a).subview(1, 3));
+    CHECK(sub.view<1>() == ext::make_array_view(b).subview(1, 3));
+
+    CHECK(std::get<1>(view.first(2).back()) == 20);
+    CHECK(std::get<1>(view.last(2).front()) == 40);
+    CHECK(std::get<0>(view.drop_first(4).front()) == 5);
+    CHECK(view.drop_last(5).empty());
+
+    auto one = view.first(1);
+    auto three = sub;
+    one.swap(three);
+    CHECK(one.size() == 3);
+    CHECK(three.size() == 1);
+}
@@ -0,0 +1,414 @@
+// zip_view - Lockstep view of multiple array_views of equal size
+//
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ZIP_VIEW_HPP
+#define INCLUDED_ZIP_VIEW_HPP
+
+#include <cstddef> // ptrdiff_t, size_t
+#include <iterator> // random_access_iterator_tag
+#include <stdexcept> // invalid_argument, out_of_range
+#include <tuple> // tuple, tuple_element, get
+#include <type_traits> // remove_cv
+
+#include "array_view.hpp"
+
+namespace array_view_detail
+{
+    // Compile-time sequence of indices (std::index_sequence is C++14).
+    template<std::size_t... Is>
+    struct index_sequence
+    {
+    };
+
+    template<std::size_t N, std::size_t... Is>
+    struct make_index_sequence_impl
+        : make_index_sequence_impl<N - 1, N - 1, Is...>
+    {
+    };
+
+    template<std::size_t... Is>
+    struct make_index_sequence_impl<0, Is...>
+    {
+        using type = index_sequence<Is...>;
+    };
+
+    template<std::size_t N>
+    using make_index_sequence = typename make_index_sequence_impl<N>::type;
+
+    // Returns a tuple of references to the idx-th elements.
+    template<typename... Ts, std::size_t... Is>
+    std::tuple<Ts&...> zip_at(std::tuple<Ts*...> const& ptrs, std::size_t idx,
+        index_sequence<Is...>) noexcept
+    {
+        return std::tuple<Ts&...>{std::get<Is>(ptrs)[idx]...};
+    }
+
+    // Returns a tuple of pointers advanced by offset.
+    template<typename... Ts, std::size_t... Is>
+    std::tuple<Ts*...> zip_advance(std::tuple<Ts*...> const& ptrs,
+        std::size_t offset, index_sequence<Is...>) noexcept
+    {
+        return std::tuple<Ts*...>{std::get<Is>(ptrs) + offset...};
+    }
+
+    // Tests if all sizes are equal to the first one.
+    inline bool all_equal(
+        std::size_t const* sizes, std::size_t count) noexcept
+    {
+        for (std::size_t i = 1; i < count; i++) {
+            if (sizes[i] != sizes[0]) {
+                return false;
+            }
+        }
+        return true;
+    }
+} // namespace array_view_detail
+
+namespace ext
+{
+    /// Random access iterator over a zip_view yielding tuples of references.
+    template<typename... Ts>
+    class zip_iterator
+    {
+        using indices = array_view_detail::make_index_sequence<sizeof...(Ts)>;
+
+      public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::tuple<typename std::remove_cv<Ts>::type...>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::tuple<Ts&...>;
+
+        zip_iterator() = default;
+
+        zip_iterator(
+            std::tuple<Ts*...> const& ptrs, std::size_t index) noexcept
+            : ptrs_(ptrs)
+            , index_{index}
+        {
+        }
+
+        reference operator*() const noexcept
+        {
+            return array_view_detail::zip_at(ptrs_, index_, indices{});
+        }
+
+        reference operator[](difference_type n) const noexcept
+        {
+            return *(*this + n);
+        }
+
+        zip_iterator& operator++() noexcept
+        {
+            ++index_;
+            return *this;
+        }
+
+        zip_iterator operator++(int) noexcept
+        {
+            auto const copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        zip_iterator& operator--() noexcept
+        {
+            --index_;
+            return *this;
+        }
+
+        zip_iterator operator--(int) noexcept
+        {
+            auto const copy = *this;
+            --*this;
+            return copy;
+        }
+
+        zip_iterator& operator+=(difference_type n) noexcept
+        {
+            index_ = static_cast<std::size_t>(
+                static_cast<difference_type>(index_) + n);
+            return *this;
+        }
+
+        zip_iterator& operator-=(difference_type n) noexcept
+        {
+            return *this += -n;
+        }
+
+        friend zip_iterator operator+(
+            zip_iterator it, difference_type n) noexcept
+        {
+            return it += n;
+        }
+
+        friend zip_iterator operator+(
+            difference_type n, zip_iterator it) noexcept
+        {
+            return it += n;
+        }
+
+        friend zip_iterator operator-(
+            zip_iterator it, difference_type n) noexcept
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(
+            zip_iterator const& lhs, zip_iterator const& rhs) noexcept
+        {
+            return static_cast<difference_type>(lhs.index_)
+                - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(
+            zip_iterator const& lhs, zip_iterator const& rhs) noexcept
+        {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(
+            zip_iterator const& lhs, zip_iterator const& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(
+            zip_iterator const& lhs, zip_iterator const& rhs) noexcept
+        {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(
+            zip_iterator const& lhs, zip_iterator const& rhs) noexcept
+        {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(
+            zip_iterator const& lhs, zip_iterator const& rhs) noexcept
+        {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(
+            zip_iterator const& lhs, zip_iterator const& rhs) noexcept
+        {
+            return !(lhs < rhs);
+        }
+
+      private:
+        std::tuple<Ts*...> ptrs_;
+        std::size_t index_ = 0;
+    };
+
+    /// Lightweight view of multiple arrays of the same size traversed in
+    /// lockstep, such as the columns of structure-of-arrays data.
+    ///
+    /// The sizes are checked once on construction, so a loop over the zip
+    /// view has a single bound covering all the arrays.
+    ///
+    /// @code
+    /// auto const particles = ext::zip(xs, ys, masses);
+    /// for (std::size_t i = 0; i < particles.size(); i++) {
+    ///     auto const p = particles[i];
+    ///     std::get<0>(p) += std::get<2>(p) * std::get<1>(p);
+    /// }
+    /// @endcode
+    template<typename... Ts>
+    class zip_view
+    {
+        static_assert(sizeof...(Ts) > 0, "zip_view needs at least one array");
+
+        using indices = array_view_detail::make_index_sequence<sizeof...(Ts)>;
+
+      public:
+        /// The type of a tuple of references to elements.
+        using reference = std::tuple<Ts&...>;
+
+        /// The type of a tuple of pointers to the first elements.
+        using pointer = std::tuple<Ts*...>;
+
+        /// The type of size and index values.
+        using size_type = std::size_t;
+
+        /// The type of iterators. Guaranteed to be a random access iterator
+        /// yielding tuples of references by value.
+        using iterator = zip_iterator<Ts...>;
+
+        /// The type of the I-th viewed array.
+        template<std::size_t I>
+        using element_view = array_view<
+            typename std::tuple_element<I, std::tuple<Ts...>>::type>;
+
+        /// The default constructor creates an empty view.
+        zip_view() = default;
+
+        /// Creates a view of given arrays.
+        ///
+        /// @exception std::invalid_argument if the sizes differ.
+        explicit zip_view(array_view<Ts>... views)
+            : data_{views.data()...}
+        {
+            size_type const sizes[] = {views.size()...};
+            if (!array_view_detail::all_equal(sizes, sizeof...(Ts))) {
+                throw std::invalid_argument("zipped views differ in size");
+            }
+            size_ = sizes[0];
+        }
+
+        /// Tests if the view is empty.
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        /// Returns the number of elements in each array.
+        size_type size() const noexcept
+        {
+            return size_;
+        }
+
+        /// Returns the pointers to the first elements.
+        pointer data() const noexcept
+        {
+            return data_;
+        }
+
+        /// Returns a view of the I-th array.
+        template<std::size_t I>
+        element_view<I> view() const noexcept
+        {
+            return {std::get<I>(data_), size_};
+        }
+
+        /// Returns references to the idx-th elements. The behavior is
+        /// undefined if the index is out of bounds.
+        reference operator[](size_type idx) const noexcept
+        {
+            return array_view_detail::zip_at(data_, idx, indices{});
+        }
+
+        /// Returns references to the idx-th elements.
+        ///
+        /// @exception std::out_of_range if the index is out of bounds.
+        reference at(size_type idx) const
+        {
+            if (idx >= size()) {
+                throw std::out_of_range("zip_view access out-of-bounds");
+            }
+            return operator[](idx);
+        }
+
+        /// Returns references to the first elements. The behavior is
+        /// undefined if the view is empty.
+        reference front() const noexcept
+        {
+            return operator[](0);
+        }
+
+        /// Returns references to the last elements. The behavior is
+        /// undefined if the view is empty.
+        reference back() const noexcept
+        {
+            return operator[](size() - 1);
+        }
+
+        /// Returns an iterator to the beginning.
+        iterator begin() const noexcept
+        {
+            return {data_, 0};
+        }
+
+        /// Returns an iterator to the end.
+        iterator end() const noexcept
+        {
+            return {data_, size_};
+        }
+
+        /// Swaps the viewed arrays.
+        void swap(zip_view& other) noexcept
+        {
+            auto const this_copy = *this;
+            *this = other;
+            other = this_copy;
+        }
+
+        /// Returns a view of the subarrays with given region.
+        zip_view subview(size_type offset, size_type count) const noexcept
+        {
+            auto const data =
+                array_view_detail::zip_advance(data_, offset, indices{});
+            return zip_view{data, count};
+        }
+
+        /// Returns a view of the first count elements.
+        zip_view first(size_type count) const noexcept
+        {
+            return subview(0, count);
+        }
+
+        /// Returns a view of the last count elements.
+        zip_view last(size_type count) const noexcept
+        {
+            return subview(size() - count, count);
+        }
+
+        /// Returns a view of the arrays except the first count elements.
+        zip_view drop_first(size_type count) const noexcept
+        {
+            return subview(count, size() - count);
+        }
+
+        /// Returns a view of the arrays except the last count elements.
+        zip_view drop_last(size_type count) const noexcept
+        {
+            return subview(0, size() - count);
+        }
+
+      private:
+        zip_view(pointer data, size_type size) noexcept
+            : data_(data)
+            , size_{size}
+        {
+        }
+
+        pointer data_{};
+        size_type size_ = 0;
+    };
+
+    /// Creates a zip_view of given arrays.
+    ///
+    /// @exception std::invalid_argument if the sizes differ.
+    template<typename... Ts>
+    zip_view<Ts...> zip(array_view<Ts>... views)
+    {
+        return zip_view<Ts...>{views...};
+    }
+} // namespace ext
+
+#endif // INCLUDED_ZIP_VIEW_HPP